@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSAsyncIO.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <linux/io_uring.h>
+
+CPSAsyncIO::CPSAsyncIO(unsigned int capacity) :
+	operations_m(capacity)
+{
+	this->ringFd_m = -1;
+	this->sqRing_m = MAP_FAILED;
+	this->cqRing_m = MAP_FAILED;
+	this->sqes_m = MAP_FAILED;
+
+	this->firstFree_m = 0;
+	this->numberOfUnsubmitted_m = 0;
+	this->numberOfInFlight_m = 0;
+	this->numberOfSyscalls_m = 0;
+
+	for (uint32_t i = 0; i < capacity; i++) {
+		this->operations_m[i].asyncIO = this;
+		this->operations_m[i].nextFree = i + 1;
+	}
+
+#ifdef __NR_io_uring_setup
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+
+	int ringFd = (int) ::syscall(__NR_io_uring_setup, capacity, &params);
+
+	if (ringFd < 0) {
+		return;
+	}
+
+	this->sqRingSize_m = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	this->cqRingSize_m = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	this->sqesSize_m = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+		this->sqRingSize_m = std::max(this->sqRingSize_m, this->cqRingSize_m);
+		this->cqRingSize_m = this->sqRingSize_m;
+	}
+
+	this->sqRing_m = ::mmap(nullptr, this->sqRingSize_m, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+		this->cqRing_m = this->sqRing_m;
+	}
+	else if (this->sqRing_m != MAP_FAILED) {
+		this->cqRing_m = ::mmap(nullptr, this->cqRingSize_m, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+	}
+
+	if (this->cqRing_m != MAP_FAILED) {
+		this->sqes_m = ::mmap(nullptr, this->sqesSize_m, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+	}
+
+	if (this->sqes_m == MAP_FAILED) {
+		if ((this->cqRing_m != MAP_FAILED) && (this->cqRing_m != this->sqRing_m)) {
+			::munmap(this->cqRing_m, this->cqRingSize_m);
+		}
+
+		if (this->sqRing_m != MAP_FAILED) {
+			::munmap(this->sqRing_m, this->sqRingSize_m);
+		}
+
+		this->sqRing_m = MAP_FAILED;
+		this->cqRing_m = MAP_FAILED;
+
+		::close(ringFd);
+		return;
+	}
+
+	char *sqRing = static_cast<char *>(this->sqRing_m);
+	char *cqRing = static_cast<char *>(this->cqRing_m);
+
+	this->sqHead_m = reinterpret_cast<unsigned int *>(sqRing + params.sq_off.head);
+	this->sqTail_m = reinterpret_cast<unsigned int *>(sqRing + params.sq_off.tail);
+	this->sqMask_m = *reinterpret_cast<unsigned int *>(sqRing + params.sq_off.ring_mask);
+	this->sqArray_m = reinterpret_cast<unsigned int *>(sqRing + params.sq_off.array);
+
+	this->cqHead_m = reinterpret_cast<unsigned int *>(cqRing + params.cq_off.head);
+	this->cqTail_m = reinterpret_cast<unsigned int *>(cqRing + params.cq_off.tail);
+	this->cqMask_m = *reinterpret_cast<unsigned int *>(cqRing + params.cq_off.ring_mask);
+	this->cqes_m = cqRing + params.cq_off.cqes;
+
+	this->ringFd_m = ringFd;
+#endif
+}
+
+CPSAsyncIO::~CPSAsyncIO()
+{
+	if (this->ringFd_m >= 0) {
+		::munmap(this->sqes_m, this->sqesSize_m);
+
+		if (this->cqRing_m != this->sqRing_m) {
+			::munmap(this->cqRing_m, this->cqRingSize_m);
+		}
+
+		::munmap(this->sqRing_m, this->sqRingSize_m);
+
+		::close(this->ringFd_m);
+	}
+}
+
+bool CPSAsyncIO::isAvailable() const {
+	return (this->ringFd_m >= 0);
+}
+
+bool CPSAsyncIO::hasOperations() const {
+	return (this->numberOfUnsubmitted_m + this->numberOfInFlight_m) > 0;
+}
+
+bool CPSAsyncIO::hasUnsubmittedOperations() const {
+	return (this->numberOfUnsubmitted_m > 0);
+}
+
+void CPSAsyncIO::read(int fd, void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute) {
+	this->prepare(IORING_OP_READ, fd, (uint64_t)(uintptr_t)buffer, length, offset, pcont, continuationsToExecute);
+}
+
+void CPSAsyncIO::write(int fd, const void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute) {
+	this->prepare(IORING_OP_WRITE, fd, (uint64_t)(uintptr_t)buffer, length, offset, pcont, continuationsToExecute);
+}
+
+void CPSAsyncIO::prepare(uint8_t opcode, int fd, uint64_t address, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute) {
+	if (!this->isAvailable()) {
+		throw std::runtime_error("Asynchronous I/O not available");
+	}
+
+	if (this->firstFree_m == this->operations_m.size()) {
+		throw std::runtime_error("Too many asynchronous I/O operations");
+	}
+
+	const unsigned int tail = *this->sqTail_m;
+
+	// Si el anillo de envío está lleno enviar lo pendiente
+	if (tail - __atomic_load_n(this->sqHead_m, __ATOMIC_ACQUIRE) > this->sqMask_m) {
+		this->submit(continuationsToExecute);
+	}
+
+	const uint32_t operationIndex = this->firstFree_m;
+	Operation& operation = this->operations_m[operationIndex];
+
+	this->firstFree_m = operation.nextFree;
+	operation.pcont = pcont;
+
+	const unsigned int sqIndex = tail & this->sqMask_m;
+
+	struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(this->sqes_m) + sqIndex;
+	std::memset(sqe, 0, sizeof(*sqe));
+
+	sqe->opcode = opcode;
+	sqe->fd = fd;
+	sqe->addr = address;
+	sqe->len = (uint32_t)length;
+	sqe->off = (uint64_t)offset;
+	sqe->user_data = operationIndex;
+
+	this->sqArray_m[sqIndex] = sqIndex;
+
+	__atomic_store_n(this->sqTail_m, tail + 1, __ATOMIC_RELEASE);
+
+	this->numberOfUnsubmitted_m++;
+}
+
+void CPSAsyncIO::submit(CPSRunQueue& continuationsToExecute) {
+	if (!this->isAvailable()) {
+		return;
+	}
+
+	this->reap(continuationsToExecute);
+
+	if (this->numberOfUnsubmitted_m == 0) {
+		return;
+	}
+
+	int result;
+
+	do {
+		result = (int) ::syscall(__NR_io_uring_enter, this->ringFd_m, this->numberOfUnsubmitted_m, 0, 0, nullptr, 0);
+		this->numberOfSyscalls_m++;
+	} while ((result < 0) && (errno == EINTR));
+
+	if (result < 0) {
+		// Si la cola de terminadas está llena se reintenta en el próximo envío
+		if ((errno == EAGAIN) || (errno == EBUSY)) {
+			result = 0;
+		}
+		else {
+			throw std::runtime_error("Cannot submit asynchronous I/O");
+		}
+	}
+
+	this->numberOfUnsubmitted_m -= (unsigned int)result;
+	this->numberOfInFlight_m += (unsigned int)result;
+
+	this->reap(continuationsToExecute);
+}
+
+void CPSAsyncIO::reap(CPSRunQueue& continuationsToExecute) {
+	if (!this->isAvailable()) {
+		return;
+	}
+
+	unsigned int head = *this->cqHead_m;
+	const unsigned int tail = __atomic_load_n(this->cqTail_m, __ATOMIC_ACQUIRE);
+
+	// Si se llena la cola de continuaciones las demás quedan en la cola de terminadas, para la próxima vez
+	while ((head != tail) && (continuationsToExecute.size() < continuationsToExecute.capacity())) {
+		const struct io_uring_cqe *cqe = static_cast<const struct io_uring_cqe *>(this->cqes_m) + (head & this->cqMask_m);
+
+		Operation& operation = this->operations_m[(size_t)cqe->user_data];
+		operation.result = cqe->res;
+
+		continuationsToExecute.push(Cont(CPSAsyncIO::resume, &operation));
+
+		this->numberOfInFlight_m--;
+		head++;
+	}
+
+	__atomic_store_n(this->cqHead_m, head, __ATOMIC_RELEASE);
+}
+
+int CPSAsyncIO::getFileDescriptor() const {
+	return this->ringFd_m;
+}
+
+uint64_t CPSAsyncIO::getNumberOfSyscalls() const {
+	return this->numberOfSyscalls_m;
+}
+
+Cont CPSAsyncIO::resume(Operation *operation) {
+	CPSAsyncIO *asyncIO = operation->asyncIO;
+
+	PCont<ssize_t> pcont = operation->pcont;
+	const ssize_t result = operation->result;
+
+	// Liberar la operación antes de continuar, para que pueda reusarse
+	operation->nextFree = asyncIO->firstFree_m;
+	asyncIO->firstFree_m = (uint32_t)(operation - asyncIO->operations_m.data());
+
+	return pcont.invoke(result);
+}
\ No newline at end of file
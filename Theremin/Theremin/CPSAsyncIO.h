@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSRunQueue.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <sys/types.h>
+
+/*
+ * E/S asíncrona de un scheduler de continuaciones, con io_uring.
+ *
+ * Las operaciones se encolan en el anillo de envío sin hacer syscalls,
+ * y se envían todas juntas con un solo io_uring_enter. Al terminar
+ * cada operación se encola su continuación en el scheduler.
+ *
+ * Nunca bloquea: el scheduler espera las operaciones terminadas con el
+ * descriptor del io_uring, junto con el resto de las esperas.
+ *
+ * Si el kernel no soporta io_uring no está disponible,
+ * y el scheduler hace las operaciones de forma síncrona
+ */
+class CPSAsyncIO final
+{
+public:
+	/**
+	 * @post Crea la E/S asíncrona, con la capacidad de operaciones
+	         en curso especificada
+	 */
+	CPSAsyncIO(unsigned int capacity = 64);
+
+	CPSAsyncIO(const CPSAsyncIO&) = delete;
+	CPSAsyncIO& operator=(const CPSAsyncIO&) = delete;
+
+	/**
+	 * @post Destruye la E/S asíncrona
+	 */
+	~CPSAsyncIO();
+
+	/**
+	 * @post Devuelve si está disponible
+	 */
+	bool isAvailable() const;
+
+	/**
+	 * @post Devuelve si hay operaciones sin enviar o en curso
+	 */
+	bool hasOperations() const;
+
+	/**
+	 * @post Devuelve si hay operaciones sin enviar
+	 */
+	bool hasUnsubmittedOperations() const;
+
+	/**
+	 * @pre Tiene que estar disponible
+	 * @post Encola una lectura (pread), que al terminar continúa
+	         con la cantidad de bytes leídos o -errno
+	 */
+	void read(int fd, void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @pre Tiene que estar disponible
+	 * @post Encola una escritura (pwrite), que al terminar continúa
+	         con la cantidad de bytes escritos o -errno
+	 */
+	void write(int fd, const void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Envía las operaciones pendientes con un solo io_uring_enter,
+	         sin esperar, y encola las continuaciones de las terminadas
+	 */
+	void submit(CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Encola las continuaciones de las operaciones terminadas,
+	         sin hacer syscalls, mientras haya lugar en la cola de continuaciones
+	 */
+	void reap(CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @pre Tiene que estar disponible
+	 * @post Devuelve el descriptor del io_uring, que está listo
+	         para leer cuando hay operaciones terminadas
+	 */
+	int getFileDescriptor() const;
+
+	/**
+	 * @post Devuelve la cantidad de io_uring_enter realizados
+	 */
+	uint64_t getNumberOfSyscalls() const;
+
+private:
+	// Operación en curso
+	struct Operation {
+		CPSAsyncIO *asyncIO;
+		PCont<ssize_t> pcont;
+		ssize_t result;
+		uint32_t nextFree; // Siguiente operación libre
+	};
+
+	/**
+	 * @post Encola la operación especificada (IORING_OP_*)
+	 */
+	void prepare(uint8_t opcode, int fd, uint64_t address, size_t length, off_t offset, PCont<ssize_t> pcont, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Continúa la operación terminada
+	 */
+	static Cont resume(Operation *operation);
+
+	int ringFd_m;
+
+	void *sqRing_m;
+	size_t sqRingSize_m;
+	void *cqRing_m;
+	size_t cqRingSize_m;
+	void *sqes_m;
+	size_t sqesSize_m;
+
+	unsigned int *sqHead_m;
+	unsigned int *sqTail_m;
+	unsigned int sqMask_m;
+	unsigned int *sqArray_m;
+
+	unsigned int *cqHead_m;
+	unsigned int *cqTail_m;
+	unsigned int cqMask_m;
+	void *cqes_m;
+
+	std::vector<Operation> operations_m;
+	uint32_t firstFree_m; // Primera operación libre
+
+	unsigned int numberOfUnsubmitted_m; // Operaciones sin enviar
+	unsigned int numberOfInFlight_m; // Operaciones enviadas sin terminar
+
+	uint64_t numberOfSyscalls_m;
+};
@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSSched.h"
+
+#include <coroutine>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <stdexcept>
+
+/*
+ * Canal acotado entre dos hilos de ejecución de CPS (Un emisor
+ * y un receptor) del mismo scheduler.
+ *
+ * Es un buffer circular que se reserva al crearse, con lo cual
+ * enviar y recibir no reservan ni liberan memoria, y no usa locks
+ * porque los dos extremos se ejecutan en el mismo thread.
+ *
+ * Si el canal está lleno el emisor queda esperando hasta que el
+ * receptor libere lugar, y si está vacío el receptor queda esperando
+ * hasta que el emisor envíe un valor. Así una cadena de etapas
+ * (Por ejemplo muestras del eco -> filtro -> mapeo) queda limitada
+ * por la más lenta, sin acumular valores.
+ *
+ * El tipo de los valores tiene que poder construirse por defecto
+ */
+template<typename T>
+class CPSChannel final
+{
+public:
+	/**
+	 * @pre La capacidad tiene que ser mayor a cero
+	 * @post Crea el canal vacío con la capacidad especificada
+	 */
+	CPSChannel(size_t capacity) :
+		buffer_m(new T[capacity]),
+		capacity_m(capacity)
+	{
+		if (capacity == 0) {
+			throw std::runtime_error("Invalid CPS channel capacity");
+		}
+
+		this->head_m = 0;
+		this->size_m = 0;
+		this->isSenderWaiting_m = false;
+		this->isReceiverWaiting_m = false;
+	}
+
+	CPSChannel(const CPSChannel&) = delete;
+	CPSChannel& operator=(const CPSChannel&) = delete;
+
+	/**
+	 * @post Devuelve la cantidad de valores en el canal
+	 */
+	size_t size() const {
+		return this->size_m;
+	}
+
+	/**
+	 * @post Devuelve la capacidad
+	 */
+	size_t capacity() const {
+		return this->capacity_m;
+	}
+
+	/**
+	 * @pre No puede haber otro envío esperando
+	 * @post Envía el valor especificado y sigue con la continuación
+	         especificada. Si el canal está lleno espera hasta que
+			 el receptor libere lugar
+	 */
+	Cont send(T value, Cont cont) {
+		if (this->isSenderWaiting_m) {
+			throw std::runtime_error("CPS channel already has a waiting sender");
+		}
+
+		if (this->size_m == this->capacity_m) {
+			// Esperar al receptor con el valor pendiente
+			this->pendingValue_m = std::move(value);
+			this->sender_m = cont;
+			this->isSenderWaiting_m = true;
+
+			return CPSSched::finish();
+		}
+
+		this->pushValue(std::move(value));
+
+		// Si el receptor estaba esperando encolarlo, y seguir con el emisor
+		if (this->isReceiverWaiting_m) {
+			this->isReceiverWaiting_m = false;
+
+			CPSSched::getInstance()->continuationsToExecute.push(Cont(CPSChannel::resumeReceiver, this));
+		}
+
+		return cont;
+	}
+
+	/**
+	 * @pre No puede haber otra recepción esperando
+	 * @post Recibe un valor y sigue con la continuación parametrizada
+	         especificada. Si el canal está vacío espera hasta que
+			 el emisor envíe un valor
+	 */
+	Cont recv(PCont<T> pcont) {
+		if (this->isReceiverWaiting_m) {
+			throw std::runtime_error("CPS channel already has a waiting receiver");
+		}
+
+		if (this->size_m == 0) {
+			this->receiver_m = pcont;
+			this->isReceiverWaiting_m = true;
+
+			return CPSSched::finish();
+		}
+
+		T value = std::move(this->buffer_m[this->head_m]);
+
+		this->head_m = (this->head_m + 1) % this->capacity_m;
+		this->size_m--;
+
+		// Si el emisor estaba esperando lugar, completar su envío y encolarlo
+		if (this->isSenderWaiting_m) {
+			this->isSenderWaiting_m = false;
+
+			this->pushValue(std::move(this->pendingValue_m));
+
+			CPSSched::getInstance()->continuationsToExecute.push(this->sender_m);
+		}
+
+		return pcont.invoke(std::move(value));
+	}
+
+	// Envío desde una corrutina (co_await channel.send(value))
+	class Send final {
+	public:
+		Send(CPSChannel *channel, T value) : channel_m(channel), value_m(std::move(value)) { }
+
+		bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			CPSCoroutine::setNext(this->channel_m->send(std::move(this->value_m), CPSCoroutine::resumeCont(handle)));
+		}
+
+		void await_resume() const noexcept { }
+
+	private:
+		CPSChannel *channel_m;
+		T value_m;
+	};
+
+	// Recepción desde una corrutina (co_await channel.recv())
+	class Recv final {
+	public:
+		Recv(CPSChannel *channel) : channel_m(channel) { }
+
+		bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			this->handle_m = handle;
+
+			CPSCoroutine::setNext(this->channel_m->recv(PCont<T>(Recv::complete, this)));
+		}
+
+		T await_resume() { return std::move(this->value_m); }
+
+	private:
+		static Cont complete(Recv *awaiter, T value) {
+			awaiter->value_m = std::move(value);
+
+			return CPSCoroutine::resumeCont(awaiter->handle_m);
+		}
+
+		CPSChannel *channel_m;
+		std::coroutine_handle<> handle_m;
+		T value_m;
+	};
+
+	/**
+	 * @post Envía el valor especificado desde una corrutina
+	 */
+	Send send(T value) {
+		return Send(this, std::move(value));
+	}
+
+	/**
+	 * @post Recibe un valor desde una corrutina
+	 */
+	Recv recv() {
+		return Recv(this);
+	}
+
+private:
+	/**
+	 * @pre El canal no tiene que estar lleno
+	 * @post Agrega el valor especificado al final
+	 */
+	void pushValue(T value) {
+		this->buffer_m[(this->head_m + this->size_m) % this->capacity_m] = std::move(value);
+		this->size_m++;
+	}
+
+	/**
+	 * @post Reanuda la recepción que estaba esperando
+	 */
+	static Cont resumeReceiver(CPSChannel *channel) {
+		return channel->recv(channel->receiver_m);
+	}
+
+	std::unique_ptr<T[]> buffer_m;
+	size_t capacity_m;
+
+	size_t head_m; // Índice del primer valor
+	size_t size_m;
+
+	T pendingValue_m; // Valor del emisor que espera lugar
+	Cont sender_m;
+	bool isSenderWaiting_m;
+
+	PCont<T> receiver_m;
+	bool isReceiverWaiting_m;
+};
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSDeadlineQueue.h"
+
+#include <stdexcept>
+
+CPSDeadlineQueue::CPSDeadlineQueue(size_t capacity) :
+	heap_m(capacity)
+{
+	if (capacity == 0) {
+		throw std::runtime_error("Invalid deadline queue capacity");
+	}
+
+	this->size_m = 0;
+	this->nextSequence_m = 0;
+}
+
+bool CPSDeadlineQueue::empty() const {
+	return (this->size_m == 0);
+}
+
+size_t CPSDeadlineQueue::size() const {
+	return this->size_m;
+}
+
+size_t CPSDeadlineQueue::capacity() const {
+	return this->heap_m.size();
+}
+
+void CPSDeadlineQueue::push(std::chrono::steady_clock::time_point deadline, Cont cont) {
+	if (this->size_m == this->heap_m.size()) {
+		throw std::runtime_error("CPS deadline queue overflow");
+	}
+
+	Entry entry;
+	entry.deadline = deadline;
+	entry.sequence = this->nextSequence_m++;
+	entry.cont = cont;
+
+	// Subir la entrada desde el final hasta su lugar
+	size_t index = this->size_m++;
+
+	while (index > 0) {
+		const size_t parentIndex = (index - 1) / 2;
+
+		if (!CPSDeadlineQueue::precedes(entry, this->heap_m[parentIndex])) {
+			break;
+		}
+
+		this->heap_m[index] = this->heap_m[parentIndex];
+		index = parentIndex;
+	}
+
+	this->heap_m[index] = entry;
+}
+
+Cont CPSDeadlineQueue::front() const {
+	return this->heap_m[0].cont;
+}
+
+std::chrono::steady_clock::time_point CPSDeadlineQueue::frontDeadline() const {
+	return this->heap_m[0].deadline;
+}
+
+void CPSDeadlineQueue::pop() {
+	const Entry entry = this->heap_m[--this->size_m];
+
+	// Bajar la última entrada desde la raíz hasta su lugar
+	size_t index = 0;
+
+	for (;;) {
+		size_t childIndex = 2 * index + 1;
+
+		if (childIndex >= this->size_m) {
+			break;
+		}
+
+		if ((childIndex + 1 < this->size_m) && CPSDeadlineQueue::precedes(this->heap_m[childIndex + 1], this->heap_m[childIndex])) {
+			childIndex++;
+		}
+
+		if (!CPSDeadlineQueue::precedes(this->heap_m[childIndex], entry)) {
+			break;
+		}
+
+		this->heap_m[index] = this->heap_m[childIndex];
+		index = childIndex;
+	}
+
+	if (this->size_m > 0) {
+		this->heap_m[index] = entry;
+	}
+}
+
+bool CPSDeadlineQueue::precedes(const Entry& entry1, const Entry& entry2) {
+	if (entry1.deadline != entry2.deadline) {
+		return (entry1.deadline < entry2.deadline);
+	}
+	else {
+		return (entry1.sequence < entry2.sequence);
+	}
+}
\ No newline at end of file
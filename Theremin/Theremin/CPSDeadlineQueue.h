@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Cola de continuaciones con plazo, de capacidad fija, que se
+ * desencolan por plazo más próximo primero (EDF).
+ *
+ * Es un heap binario que se reserva al crearse, con lo cual encolar
+ * y desencolar no reservan ni liberan memoria. Las continuaciones con
+ * el mismo plazo se desencolan en el orden en el que se encolaron.
+ * Si se supera la capacidad lanza una excepción, en lugar de crecer
+ */
+class CPSDeadlineQueue final
+{
+public:
+	/**
+	 * @pre La capacidad tiene que ser mayor a cero
+	 * @post Crea la cola vacía con la capacidad especificada
+	 */
+	CPSDeadlineQueue(size_t capacity);
+
+	/**
+	 * @post Devuelve si está vacía
+	 */
+	bool empty() const;
+
+	/**
+	 * @post Devuelve la cantidad de continuaciones encoladas
+	 */
+	size_t size() const;
+
+	/**
+	 * @post Devuelve la capacidad
+	 */
+	size_t capacity() const;
+
+	/**
+	 * @post Encola la continuación especificada con el plazo especificado.
+	         Si está llena lanza una excepción
+	 */
+	void push(std::chrono::steady_clock::time_point deadline, Cont cont);
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Devuelve la continuación de plazo más próximo
+	 */
+	Cont front() const;
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Devuelve el plazo más próximo
+	 */
+	std::chrono::steady_clock::time_point frontDeadline() const;
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Desencola la continuación de plazo más próximo
+	 */
+	void pop();
+
+private:
+	// Continuación con plazo
+	struct Entry {
+		std::chrono::steady_clock::time_point deadline;
+		uint64_t sequence; // Orden de llegada, para desempatar
+		Cont cont;
+	};
+
+	/**
+	 * @post Devuelve si la primer entrada especificada va antes que la segunda
+	 */
+	static bool precedes(const Entry& entry1, const Entry& entry2);
+
+	std::vector<Entry> heap_m;
+	size_t size_m;
+	uint64_t nextSequence_m;
+};
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSFrameArena.h"
+
+#include <stdexcept>
+#include <new>
+
+CPSFrameArena::CPSFrameArena(size_t chunkSize) :
+	chunkSize_m(chunkSize)
+{
+	if (chunkSize < CPSFrameArena::granularity * CPSFrameArena::numberOfClasses) {
+		throw std::runtime_error("Invalid frame arena chunk size");
+	}
+
+	this->chunkPosition_m = nullptr;
+	this->chunkRemaining_m = 0;
+
+	for (size_t i = 0; i < CPSFrameArena::numberOfClasses; i++) {
+		this->freeBlocks_m[i] = nullptr;
+	}
+
+	this->numberOfLargeFrames_m = 0;
+}
+
+CPSFrameArena::~CPSFrameArena()
+{
+
+}
+
+void * CPSFrameArena::allocate(size_t size) {
+	const size_t sizeClass = (size + CPSFrameArena::granularity - 1) / CPSFrameArena::granularity;
+
+	if ((sizeClass == 0) || (sizeClass > CPSFrameArena::numberOfClasses)) {
+		this->numberOfLargeFrames_m++;
+
+		return ::operator new(size);
+	}
+
+	FreeBlock *&freeBlocks = this->freeBlocks_m[sizeClass - 1];
+
+	// Reusar un bloque libre de la misma clase
+	if (freeBlocks != nullptr) {
+		FreeBlock *block = freeBlocks;
+		freeBlocks = block->next;
+
+		return block;
+	}
+
+	const size_t blockSize = sizeClass * CPSFrameArena::granularity;
+
+	// Si no entra en el resto del último bloque grande reservar otro
+	if (this->chunkRemaining_m < blockSize) {
+		this->chunks_m.emplace_back(new char[this->chunkSize_m]);
+
+		this->chunkPosition_m = this->chunks_m.back().get();
+		this->chunkRemaining_m = this->chunkSize_m;
+	}
+
+	void *block = this->chunkPosition_m;
+
+	this->chunkPosition_m += blockSize;
+	this->chunkRemaining_m -= blockSize;
+
+	return block;
+}
+
+void CPSFrameArena::deallocate(void *frame, size_t size) {
+	const size_t sizeClass = (size + CPSFrameArena::granularity - 1) / CPSFrameArena::granularity;
+
+	if ((sizeClass == 0) || (sizeClass > CPSFrameArena::numberOfClasses)) {
+		this->numberOfLargeFrames_m--;
+
+		::operator delete(frame);
+
+		return;
+	}
+
+	FreeBlock *block = static_cast<FreeBlock *>(frame);
+
+	block->next = this->freeBlocks_m[sizeClass - 1];
+	this->freeBlocks_m[sizeClass - 1] = block;
+}
+
+size_t CPSFrameArena::getNumberOfChunks() const {
+	return this->chunks_m.size();
+}
+
+size_t CPSFrameArena::getNumberOfLargeFrames() const {
+	return this->numberOfLargeFrames_m;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/*
+ * Arena de frames de corrutinas de un scheduler.
+ *
+ * Los frames se reparten en clases de tamaño (Múltiplos de 64 bytes), cada
+ * una con su lista de bloques libres, y los bloques nuevos se toman de
+ * bloques grandes reservados de a uno cuando hace falta. Como las corrutinas
+ * de un scheduler se crean y terminan repetidamente con los mismos tamaños,
+ * después de las primeras no se reserva memoria.
+ *
+ * No es thread-safe: sólo se usa desde el thread del scheduler
+ */
+class CPSFrameArena final
+{
+public:
+	/**
+	 * @post Crea la arena vacía, con el tamaño especificado
+	         de los bloques grandes
+	 */
+	CPSFrameArena(size_t chunkSize = 64 * 1024);
+
+	CPSFrameArena(const CPSFrameArena&) = delete;
+	CPSFrameArena& operator=(const CPSFrameArena&) = delete;
+
+	/**
+	 * @pre No tiene que haber frames sin liberar
+	 * @post Destruye la arena, liberando los bloques grandes
+	 */
+	~CPSFrameArena();
+
+	/**
+	 * @post Reserva un frame del tamaño especificado.
+	         Si supera el tamaño de la clase más grande lo
+			 reserva directamente del heap
+	 */
+	void * allocate(size_t size);
+
+	/**
+	 * @pre El frame tiene que haberse reservado en la arena con
+	        el tamaño especificado
+	 * @post Libera el frame especificado
+	 */
+	void deallocate(void *frame, size_t size);
+
+	/**
+	 * @post Devuelve la cantidad de bloques grandes reservados
+	 */
+	size_t getNumberOfChunks() const;
+
+	/**
+	 * @post Devuelve la cantidad de frames reservados
+	         directamente del heap, sin liberar
+	 */
+	size_t getNumberOfLargeFrames() const;
+
+private:
+	static const size_t granularity = 64; // Diferencia de tamaño entre las clases
+	static const size_t numberOfClasses = 64; // Cantidad de clases de tamaño (Hasta 4 KB)
+
+	// Bloque libre
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	const size_t chunkSize_m;
+
+	std::vector<std::unique_ptr<char[]>> chunks_m;
+	char *chunkPosition_m; // Resto sin usar del último bloque grande
+	size_t chunkRemaining_m;
+
+	FreeBlock *freeBlocks_m[numberOfClasses]; // Listas de bloques libres por clase de tamaño
+
+	size_t numberOfLargeFrames_m;
+};
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSHistogram.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+CPSHistogram::Snapshot::Snapshot() :
+	counts_m(CPSHistogram::numberOfBuckets, 0)
+{
+	this->count_m = 0;
+	this->sum_m = 0;
+	this->min_m = 0;
+	this->max_m = 0;
+}
+
+uint64_t CPSHistogram::Snapshot::getCount() const {
+	return this->count_m;
+}
+
+uint64_t CPSHistogram::Snapshot::getMin() const {
+	return this->min_m;
+}
+
+uint64_t CPSHistogram::Snapshot::getMax() const {
+	return this->max_m;
+}
+
+double CPSHistogram::Snapshot::getMean() const {
+	if (this->count_m > 0) {
+		return (double)this->sum_m / (double)this->count_m;
+	}
+	else {
+		return 0.0;
+	}
+}
+
+uint64_t CPSHistogram::Snapshot::getPercentile(double percentile) const {
+	if ((percentile < 0.0) || (percentile > 100.0)) {
+		throw std::runtime_error("Invalid percentile");
+	}
+
+	uint64_t total = 0;
+
+	for (uint64_t count : this->counts_m) {
+		total += count;
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	// Cantidad de valores que tienen que quedar a la izquierda (Al menos uno)
+	uint64_t target = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+
+	if (target == 0) {
+		target = 1;
+	}
+
+	uint64_t accumulated = 0;
+
+	for (size_t i = 0; i < this->counts_m.size(); i++) {
+		accumulated += this->counts_m[i];
+
+		if (accumulated >= target) {
+			// No informar más que el máximo registrado
+			return std::min(CPSHistogram::bucketMaxValue(i), this->max_m);
+		}
+	}
+
+	return this->max_m;
+}
+
+CPSHistogram::CPSHistogram()
+{
+	for (std::atomic<uint64_t>& count : this->counts_m) {
+		count.store(0, std::memory_order_relaxed);
+	}
+
+	this->count_m.store(0, std::memory_order_relaxed);
+	this->sum_m.store(0, std::memory_order_relaxed);
+	this->min_m.store(UINT64_MAX, std::memory_order_relaxed);
+	this->max_m.store(0, std::memory_order_relaxed);
+}
+
+void CPSHistogram::record(uint64_t value) {
+	// Hay un solo thread que escribe, alcanza con leer y escribir por separado
+	std::atomic<uint64_t>& bucketCount = this->counts_m[CPSHistogram::bucketIndex(value)];
+
+	bucketCount.store(bucketCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	this->sum_m.store(this->sum_m.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+
+	if (value < this->min_m.load(std::memory_order_relaxed)) {
+		this->min_m.store(value, std::memory_order_relaxed);
+	}
+
+	if (value > this->max_m.load(std::memory_order_relaxed)) {
+		this->max_m.store(value, std::memory_order_relaxed);
+	}
+
+	this->count_m.store(this->count_m.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+CPSHistogram::Snapshot CPSHistogram::getSnapshot() const {
+	Snapshot snapshot;
+
+	snapshot.count_m = this->count_m.load(std::memory_order_acquire);
+
+	for (size_t i = 0; i < numberOfBuckets; i++) {
+		snapshot.counts_m[i] = this->counts_m[i].load(std::memory_order_relaxed);
+	}
+
+	snapshot.sum_m = this->sum_m.load(std::memory_order_relaxed);
+	snapshot.max_m = this->max_m.load(std::memory_order_relaxed);
+
+	if (snapshot.count_m > 0) {
+		snapshot.min_m = this->min_m.load(std::memory_order_relaxed);
+	}
+
+	return snapshot;
+}
+
+size_t CPSHistogram::bucketIndex(uint64_t value) {
+	const uint64_t maxValue = ((uint64_t)1 << maxValueBits) - 1;
+
+	if (value > maxValue) {
+		value = maxValue;
+	}
+
+	if (value < ((uint64_t)1 << subBucketBits)) {
+		return (size_t)value;
+	}
+
+	const unsigned int msb = 63 - (unsigned int)__builtin_clzll(value);
+	const unsigned int shift = msb - subBucketBits;
+
+	return ((size_t)(msb - subBucketBits + 1) << subBucketBits) + (size_t)((value >> shift) & (((uint64_t)1 << subBucketBits) - 1));
+}
+
+uint64_t CPSHistogram::bucketMaxValue(size_t index) {
+	if (index < ((size_t)1 << subBucketBits)) {
+		return (uint64_t)index;
+	}
+
+	const unsigned int msb = (unsigned int)(index >> subBucketBits) + subBucketBits - 1;
+	const unsigned int shift = msb - subBucketBits;
+	const uint64_t subBucket = (uint64_t)(index & (((size_t)1 << subBucketBits) - 1));
+
+	return ((((uint64_t)1 << subBucketBits) + subBucket + 1) << shift) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Histograma de valores enteros, con buckets de precisión relativa
+ * constante (Estilo HDR): cada potencia de dos se divide en 16 buckets,
+ * con lo cual el error relativo es menor al 6.25%.
+ *
+ * Lo registra un solo thread, sin locks ni operaciones atómicas
+ * de lectura-modificación-escritura, y se puede leer desde cualquier
+ * thread mientras se registra
+ */
+class CPSHistogram final
+{
+public:
+	static const unsigned int subBucketBits = 4;
+	static const unsigned int maxValueBits = 40; // Los valores mayores se cuentan como el máximo
+	static const size_t numberOfBuckets = (size_t)(maxValueBits - subBucketBits + 1) << subBucketBits;
+
+	// Copia del estado del histograma
+	class Snapshot final {
+	public:
+		/**
+		 * @post Crea una copia vacía
+		 */
+		Snapshot();
+
+		/**
+		 * @post Devuelve la cantidad de valores
+		 */
+		uint64_t getCount() const;
+
+		/**
+		 * @post Devuelve el valor mínimo (Cero si no hay valores)
+		 */
+		uint64_t getMin() const;
+
+		/**
+		 * @post Devuelve el valor máximo
+		 */
+		uint64_t getMax() const;
+
+		/**
+		 * @post Devuelve el promedio
+		 */
+		double getMean() const;
+
+		/**
+		 * @pre El percentil tiene que estar entre 0 y 100
+		 * @post Devuelve el valor del percentil especificado
+		         (El máximo valor de su bucket)
+		 */
+		uint64_t getPercentile(double percentile) const;
+
+	private:
+		friend class CPSHistogram;
+
+		std::vector<uint64_t> counts_m;
+		uint64_t count_m;
+		uint64_t sum_m;
+		uint64_t min_m;
+		uint64_t max_m;
+	};
+
+	/**
+	 * @post Crea el histograma vacío
+	 */
+	CPSHistogram();
+
+	CPSHistogram(const CPSHistogram&) = delete;
+	CPSHistogram& operator=(const CPSHistogram&) = delete;
+
+	/**
+	 * @pre Sólo lo puede llamar un thread
+	 * @post Registra el valor especificado
+	 */
+	void record(uint64_t value);
+
+	/**
+	 * @post Devuelve una copia del estado, desde cualquier thread
+	 */
+	Snapshot getSnapshot() const;
+
+private:
+	/**
+	 * @post Devuelve el índice del bucket del valor especificado
+	 */
+	static size_t bucketIndex(uint64_t value);
+
+	/**
+	 * @post Devuelve el máximo valor del bucket especificado
+	 */
+	static uint64_t bucketMaxValue(size_t index);
+
+	std::atomic<uint64_t> counts_m[numberOfBuckets];
+	std::atomic<uint64_t> count_m;
+	std::atomic<uint64_t> sum_m;
+	std::atomic<uint64_t> min_m;
+	std::atomic<uint64_t> max_m;
+};
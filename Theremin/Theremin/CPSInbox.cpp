@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSInbox.h"
+
+#include <stdexcept>
+
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+	size_t result = 1;
+
+	while (result < value) {
+		result <<= 1;
+	}
+
+	return result;
+}
+
+CPSInbox::CPSInbox(size_t capacity) :
+	mask_m(roundUpToPowerOfTwo(capacity) - 1),
+	enqueuePosition_m(0),
+	sleeping_m(false)
+{
+	if (capacity == 0) {
+		throw std::runtime_error("Invalid inbox capacity");
+	}
+
+	this->cells_m.reset(new Cell[this->mask_m + 1]);
+
+	for (size_t i = 0; i <= this->mask_m; i++) {
+		this->cells_m[i].sequence_m.store(i, std::memory_order_relaxed);
+	}
+
+	this->dequeuePosition_m = 0;
+
+	this->eventFd_m = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (this->eventFd_m < 0) {
+		throw std::runtime_error("Cannot create inbox eventfd");
+	}
+}
+
+CPSInbox::~CPSInbox()
+{
+	::close(this->eventFd_m);
+}
+
+bool CPSInbox::post(Cont cont) {
+	size_t position = this->enqueuePosition_m.load(std::memory_order_relaxed);
+
+	Cell *cell;
+
+	// Reservar una celda libre, compitiendo con los demás productores
+	for (;;) {
+		cell = &this->cells_m[position & this->mask_m];
+
+		const size_t sequence = cell->sequence_m.load(std::memory_order_acquire);
+		const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference == 0) {
+			if (this->enqueuePosition_m.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			// La celda todavía no la desencoló el scheduler, está llena
+			return false;
+		}
+		else {
+			position = this->enqueuePosition_m.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->cont_m = cont;
+	cell->sequence_m.store(position + 1, std::memory_order_release);
+
+	this->wakeIfSleeping();
+
+	return true;
+}
+
+void CPSInbox::wake() {
+	const uint64_t value = 1;
+
+	// Si el contador está saturado ya hay un aviso pendiente
+	while ((::write(this->eventFd_m, &value, sizeof(value)) < 0) && (errno == EINTR));
+}
+
+int CPSInbox::getFileDescriptor() const {
+	return this->eventFd_m;
+}
+
+bool CPSInbox::empty() const {
+	const Cell& cell = this->cells_m[this->dequeuePosition_m & this->mask_m];
+
+	return (cell.sequence_m.load(std::memory_order_acquire) != (this->dequeuePosition_m + 1));
+}
+
+void CPSInbox::collect(CPSRunQueue& continuationsToExecute) {
+	while (!this->empty() && (continuationsToExecute.size() < continuationsToExecute.capacity())) {
+		Cell& cell = this->cells_m[this->dequeuePosition_m & this->mask_m];
+
+		continuationsToExecute.push(cell.cont_m);
+
+		// Liberar la celda para la siguiente vuelta
+		cell.sequence_m.store(this->dequeuePosition_m + this->mask_m + 1, std::memory_order_release);
+		this->dequeuePosition_m++;
+	}
+}
+
+void CPSInbox::setSleeping(bool sleeping) {
+	this->sleeping_m.store(sleeping, std::memory_order_relaxed);
+
+	/*
+	 * Ordenar el anuncio antes de volver a mirar si hay algo para ejecutar,
+	 * para que quien publique después de que se miró vea que tiene que despertarlo
+	 */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool CPSInbox::wakeIfSleeping() {
+	// Ordenar la publicación antes de mirar si está durmiendo
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (this->sleeping_m.load(std::memory_order_relaxed)) {
+		this->wake();
+
+		return true;
+	}
+
+	return false;
+}
+
+void CPSInbox::clearWakeup() {
+	uint64_t value;
+
+	while ((::read(this->eventFd_m, &value, sizeof(value)) < 0) && (errno == EINTR));
+}
\ No newline at end of file
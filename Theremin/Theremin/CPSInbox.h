@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSRunQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+/*
+ * Bandeja de entrada de continuaciones de un scheduler, en la que
+ * pueden encolar continuaciones otros threads (Audio, control, handlers
+ * de señales).
+ *
+ * Es una cola acotada de varios productores y un consumidor sin locks
+ * (Cada celda tiene un número de secuencia que indica si está libre
+ * o publicada). Encolar no reserva memoria, no bloquea y es seguro
+ * en un handler de señales.
+ *
+ * El scheduler anuncia que va a dormir antes de mirar si está vacía,
+ * y quien encola mira si está durmiendo después de publicar, con lo
+ * cual sólo se escribe en el eventfd (Y se hace un syscall) cuando
+ * hace falta despertarlo
+ */
+class CPSInbox final
+{
+public:
+	/**
+	 * @pre La capacidad tiene que ser mayor a cero
+	 * @post Crea la bandeja vacía con la capacidad especificada
+	         (Redondeada a la potencia de dos siguiente)
+	 */
+	CPSInbox(size_t capacity);
+
+	CPSInbox(const CPSInbox&) = delete;
+	CPSInbox& operator=(const CPSInbox&) = delete;
+
+	/**
+	 * @post Destruye la bandeja
+	 */
+	~CPSInbox();
+
+	/**
+	 * @post Encola la continuación especificada, despertando al
+	         scheduler si está durmiendo. Se puede llamar desde cualquier
+			 thread, o desde un handler de señales.
+			 Devuelve si había lugar
+	 */
+	bool post(Cont cont);
+
+	/**
+	 * @post Despierta al scheduler, aunque no haya nada encolado.
+	         Se puede llamar desde cualquier thread, o desde un handler
+			 de señales
+	 */
+	void wake();
+
+	/**
+	 * @post Devuelve el eventfd en el que se avisa al scheduler
+	 */
+	int getFileDescriptor() const;
+
+private:
+	friend class CPSSched;
+	friend class CPSWorkerPool;
+
+	// Celda de la cola
+	struct Cell {
+		std::atomic<size_t> sequence_m; // Igual a la posición si está libre, a la posición + 1 si está publicada
+		Cont cont_m;
+	};
+
+	/**
+	 * @post Devuelve si no hay continuaciones publicadas.
+	         Sólo desde el thread del scheduler
+	 */
+	bool empty() const;
+
+	/**
+	 * @post Pasa las continuaciones publicadas a la cola especificada,
+	         mientras haya lugar.
+	         Sólo desde el thread del scheduler
+	 */
+	void collect(CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Especifica si el scheduler está por dormir, o si ya se
+	         despertó. Sólo desde el thread del scheduler.
+			 Después de anunciar que va a dormir tiene que volver
+			 a mirar si hay algo para ejecutar
+	 */
+	void setSleeping(bool sleeping);
+
+	/**
+	 * @post Despierta al scheduler si está durmiendo,
+	         y devuelve si lo despertó
+	 */
+	bool wakeIfSleeping();
+
+	/**
+	 * @post Descarta los avisos del eventfd, sin bloquear.
+	         Sólo desde el thread del scheduler
+	 */
+	void clearWakeup();
+
+	std::unique_ptr<Cell[]> cells_m;
+	const size_t mask_m;
+
+	std::atomic<size_t> enqueuePosition_m; // Posición en la que encolan los productores
+	size_t dequeuePosition_m; // Posición de la que desencola el scheduler
+
+	std::atomic<bool> sleeping_m;
+
+	int eventFd_m;
+};
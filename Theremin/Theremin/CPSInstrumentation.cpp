@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSInstrumentation.h"
+
+#include <cstdint>
+
+double CPSInstrumentation::Snapshot::getContinuationsPerSecond(const Snapshot& previous) const {
+	const double elapsedTime = std::chrono::duration<double>(this->timestamp - previous.timestamp).count();
+
+	if (elapsedTime > 0.0) {
+		return (double)(this->numberOfContinuations - previous.numberOfContinuations) / elapsedTime;
+	}
+	else {
+		return 0.0;
+	}
+}
+
+CPSInstrumentation::CPSInstrumentation() :
+	schedulerFunction_m(nullptr),
+	numberOfContinuations_m(0),
+	functionEntries_m(new FunctionEntry[maxContinuationFunctions + 1])
+{
+	for (size_t i = 0; i <= maxContinuationFunctions; i++) {
+		this->functionEntries_m[i].function.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+void CPSInstrumentation::setSchedulerFunction(const void *function) {
+	this->schedulerFunction_m = function;
+}
+
+void CPSInstrumentation::recordContinuation(const void *function, std::chrono::steady_clock::duration cost) {
+	// Sólo se registran las continuaciones despachadas, no las esperas ni los reintentos del scheduler
+	if (function == this->schedulerFunction_m) {
+		return;
+	}
+
+	this->getFunctionEntry(function).cost.record(CPSInstrumentation::toNanoseconds(cost));
+
+	this->numberOfContinuations_m.store(this->numberOfContinuations_m.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void CPSInstrumentation::recordQueueDepths(size_t runQueueDepth, size_t timerQueueDepth) {
+	this->runQueueDepth_m.record(runQueueDepth);
+	this->timerQueueDepth_m.record(timerQueueDepth);
+}
+
+void CPSInstrumentation::recordTimerLateness(std::chrono::steady_clock::duration lateness) {
+	this->timerLateness_m.record(CPSInstrumentation::toNanoseconds(lateness));
+}
+
+CPSInstrumentation::Snapshot CPSInstrumentation::getSnapshot() const {
+	Snapshot snapshot;
+
+	snapshot.timestamp = std::chrono::steady_clock::now();
+	snapshot.numberOfContinuations = this->numberOfContinuations_m.load(std::memory_order_relaxed);
+
+	snapshot.runQueueDepth = this->runQueueDepth_m.getSnapshot();
+	snapshot.timerQueueDepth = this->timerQueueDepth_m.getSnapshot();
+	snapshot.timerLateness = this->timerLateness_m.getSnapshot();
+
+	for (size_t i = 0; i <= maxContinuationFunctions; i++) {
+		const FunctionEntry& entry = this->functionEntries_m[i];
+		const void *function = entry.function.load(std::memory_order_acquire);
+
+		// La última entrada es la de las demás funciones
+		if ((function != nullptr) || (i == maxContinuationFunctions)) {
+			CPSHistogram::Snapshot cost = entry.cost.getSnapshot();
+
+			if (cost.getCount() > 0) {
+				snapshot.continuationCosts.push_back(ContinuationCost{ function, cost });
+			}
+		}
+	}
+
+	return snapshot;
+}
+
+CPSInstrumentation::FunctionEntry& CPSInstrumentation::getFunctionEntry(const void *function) {
+	const size_t hash = (size_t)((uintptr_t)function >> 4);
+
+	// Direccionamiento abierto, con sondeo lineal
+	for (size_t i = 0; i < maxContinuationFunctions; i++) {
+		FunctionEntry& entry = this->functionEntries_m[(hash + i) % maxContinuationFunctions];
+		const void *entryFunction = entry.function.load(std::memory_order_relaxed);
+
+		if (entryFunction == function) {
+			return entry;
+		}
+		else if (entryFunction == nullptr) {
+			// Publicarla para los threads que leen
+			entry.function.store(function, std::memory_order_release);
+
+			return entry;
+		}
+	}
+
+	return this->functionEntries_m[maxContinuationFunctions];
+}
+
+uint64_t CPSInstrumentation::toNanoseconds(std::chrono::steady_clock::duration duration) {
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+	return (nanoseconds > 0) ? (uint64_t)nanoseconds : 0;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "CPSHistogram.h"
+
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Instrumentación de un scheduler de continuaciones.
+ *
+ * Sólo se registra si se compila con CPS_INSTRUMENTATION definido,
+ * caso contrario el scheduler no la crea y no tiene costo.
+ *
+ * La registra el thread del scheduler, y se puede obtener una
+ * copia de su estado desde cualquier thread sin detenerlo
+ */
+class CPSInstrumentation final
+{
+public:
+	// Cantidad máxima de funciones de continuación que se distinguen, las demás se cuentan juntas
+	static const size_t maxContinuationFunctions = 64;
+
+	// Costo de las continuaciones de una función
+	struct ContinuationCost {
+		const void *function; // Puntero a la función (nullptr para las que no se distinguen)
+		CPSHistogram::Snapshot cost; // Tiempo dentro de la continuación, en nanosegundos
+	};
+
+	// Copia del estado de la instrumentación
+	struct Snapshot {
+		std::chrono::steady_clock::time_point timestamp;
+		uint64_t numberOfContinuations; // Continuaciones ejecutadas
+
+		CPSHistogram::Snapshot runQueueDepth; // Continuaciones para ejecutar, en cada ejecución del scheduler
+		CPSHistogram::Snapshot timerQueueDepth; // Continuaciones que esperan tiempo, en cada ejecución del scheduler
+		CPSHistogram::Snapshot timerLateness; // Retraso de las continuaciones que esperan tiempo, en nanosegundos
+
+		std::vector<ContinuationCost> continuationCosts;
+
+		/**
+		 * @post Devuelve las continuaciones ejecutadas por segundo
+		         desde la copia anterior especificada
+		 */
+		double getContinuationsPerSecond(const Snapshot& previous) const;
+	};
+
+	/**
+	 * @post Crea la instrumentación vacía
+	 */
+	CPSInstrumentation();
+
+	CPSInstrumentation(const CPSInstrumentation&) = delete;
+	CPSInstrumentation& operator=(const CPSInstrumentation&) = delete;
+
+	/**
+	 * @post Especifica la función de continuación del scheduler, que no
+	         se registra: puede bloquear esperando, y cuando no hay nada
+			 para ejecutar se vuelve a ejecutar a sí misma
+	 */
+	void setSchedulerFunction(const void *function);
+
+	/**
+	 * @post Registra la ejecución de una continuación de la
+	         función especificada, con el tiempo especificado,
+			 salvo que sea la del scheduler
+	 */
+	void recordContinuation(const void *function, std::chrono::steady_clock::duration cost);
+
+	/**
+	 * @post Registra la cantidad de continuaciones para ejecutar
+	         y la cantidad de continuaciones que esperan tiempo
+	 */
+	void recordQueueDepths(size_t runQueueDepth, size_t timerQueueDepth);
+
+	/**
+	 * @post Registra el retraso de una continuación que esperaba tiempo
+	 */
+	void recordTimerLateness(std::chrono::steady_clock::duration lateness);
+
+	/**
+	 * @post Devuelve una copia del estado, desde cualquier thread
+	 */
+	Snapshot getSnapshot() const;
+
+private:
+	// Costo de las continuaciones de una función
+	struct FunctionEntry {
+		std::atomic<const void *> function; // nullptr si no está ocupada
+		CPSHistogram cost;
+	};
+
+	/**
+	 * @post Devuelve la entrada de la función especificada,
+	         agregándola si no existe
+	 */
+	FunctionEntry& getFunctionEntry(const void *function);
+
+	/**
+	 * @post Convierte la duración especificada en nanosegundos,
+	         sin negativos
+	 */
+	static uint64_t toNanoseconds(std::chrono::steady_clock::duration duration);
+
+	const void *schedulerFunction_m; // Función de continuación del scheduler, que no se registra
+
+	std::atomic<uint64_t> numberOfContinuations_m;
+
+	CPSHistogram runQueueDepth_m;
+	CPSHistogram timerQueueDepth_m;
+	CPSHistogram timerLateness_m;
+
+	std::unique_ptr<FunctionEntry[]> functionEntries_m; // Tabla de dispersión, con una entrada extra para las demás funciones
+};
@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSPoller.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+CPSPoller::CPSPoller(CPSTimingWheel& timers, unsigned int capacity) :
+	timers_m(timers),
+	waiters_m(capacity)
+{
+	this->firstFree_m = 0;
+	this->numberOfWaiters_m = 0;
+
+	for (uint32_t i = 0; i < capacity; i++) {
+		this->waiters_m[i].poller = this;
+		this->waiters_m[i].nextFree = i + 1;
+	}
+
+	this->epollFd_m = ::epoll_create1(EPOLL_CLOEXEC);
+
+	if (this->epollFd_m < 0) {
+		throw std::runtime_error("Cannot create epoll instance");
+	}
+
+	this->timerFd_m = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (this->timerFd_m < 0) {
+		::close(this->epollFd_m);
+
+		throw std::runtime_error("Cannot create timerfd");
+	}
+
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.u32 = timerTag;
+
+	if (::epoll_ctl(this->epollFd_m, EPOLL_CTL_ADD, this->timerFd_m, &event) < 0) {
+		::close(this->timerFd_m);
+		::close(this->epollFd_m);
+
+		throw std::runtime_error("Cannot add timerfd to epoll instance");
+	}
+}
+
+CPSPoller::~CPSPoller()
+{
+	::close(this->timerFd_m);
+	::close(this->epollFd_m);
+}
+
+bool CPSPoller::hasWaiters() const {
+	return (this->numberOfWaiters_m > 0);
+}
+
+void CPSPoller::add(int fd, uint32_t events, PCont<uint32_t> pcont) {
+	this->addWaiter(fd, events, pcont);
+}
+
+void CPSPoller::add(int fd, uint32_t events, std::chrono::steady_clock::time_point timeout, PCont<uint32_t> pcont) {
+	Waiter& waiter = this->addWaiter(fd, events, pcont);
+
+	waiter.hasTimeout = true;
+	waiter.timer = this->timers_m.add(timeout, Cont(CPSPoller::expire, &waiter));
+}
+
+CPSPoller::Waiter& CPSPoller::addWaiter(int fd, uint32_t events, PCont<uint32_t> pcont) {
+	if (this->firstFree_m == this->waiters_m.size()) {
+		throw std::runtime_error("Too many file descriptor waits");
+	}
+
+	const uint32_t waiterIndex = this->firstFree_m;
+	Waiter& waiter = this->waiters_m[waiterIndex];
+
+	struct epoll_event event;
+	event.events = events | EPOLLONESHOT;
+	event.data.u32 = waiterIndex;
+
+	if (::epoll_ctl(this->epollFd_m, EPOLL_CTL_ADD, fd, &event) < 0) {
+		throw std::runtime_error("Cannot wait for file descriptor");
+	}
+
+	this->firstFree_m = waiter.nextFree;
+
+	waiter.fd = fd;
+	waiter.pcont = pcont;
+	waiter.events = 0;
+	waiter.hasTimeout = false;
+
+	this->numberOfWaiters_m++;
+
+	return waiter;
+}
+
+void CPSPoller::addWakeup(int fd) {
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.u32 = wakeupTag;
+
+	if (::epoll_ctl(this->epollFd_m, EPOLL_CTL_ADD, fd, &event) < 0) {
+		throw std::runtime_error("Cannot add wakeup file descriptor");
+	}
+}
+
+void CPSPoller::poll(CPSRunQueue& continuationsToExecute) {
+	this->waitEvents(0, continuationsToExecute);
+}
+
+void CPSPoller::wait(boost::optional<std::chrono::steady_clock::time_point> timeout, CPSRunQueue& continuationsToExecute) {
+	this->setTimer(timeout);
+
+	this->waitEvents(-1, continuationsToExecute);
+}
+
+void CPSPoller::waitEvents(int timeoutMs, CPSRunQueue& continuationsToExecute) {
+	struct epoll_event events[16];
+
+	/*
+	 * Tomar sólo tantos eventos como lugar haya en la cola de continuaciones.
+	 * Los demás descriptores siguen listos, y se toman en la próxima revisión
+	 */
+	const size_t freeSpace = continuationsToExecute.capacity() - continuationsToExecute.size();
+
+	if (freeSpace == 0) {
+		return;
+	}
+
+	const int maxNumberOfEvents = (int) std::min<size_t>(16, freeSpace);
+
+	int numberOfEvents;
+
+	do {
+		numberOfEvents = ::epoll_wait(this->epollFd_m, events, maxNumberOfEvents, timeoutMs);
+	} while ((numberOfEvents < 0) && (errno == EINTR));
+
+	if (numberOfEvents < 0) {
+		throw std::runtime_error("Cannot wait for epoll events");
+	}
+
+	for (int i = 0; i < numberOfEvents; i++) {
+		const uint32_t tag = events[i].data.u32;
+
+		if (tag == timerTag) {
+			uint64_t numberOfExpirations;
+
+			// Leer para que deje de estar listo
+			if (::read(this->timerFd_m, &numberOfExpirations, sizeof(numberOfExpirations)) > 0) {
+				this->timerTimestamp_m = boost::optional<std::chrono::steady_clock::time_point>();
+			}
+		}
+		else if (tag != wakeupTag) {
+			Waiter& waiter = this->waiters_m[tag];
+
+			// Quitar el descriptor, para que se lo pueda volver a esperar
+			::epoll_ctl(this->epollFd_m, EPOLL_CTL_DEL, waiter.fd, nullptr);
+
+			waiter.events = events[i].events;
+			this->numberOfWaiters_m--;
+
+			// Ya no hace falta esperar el tiempo máximo
+			if (waiter.hasTimeout) {
+				this->timers_m.cancel(waiter.timer);
+			}
+
+			continuationsToExecute.push(Cont(CPSPoller::resume, &waiter));
+		}
+	}
+}
+
+void CPSPoller::setTimer(boost::optional<std::chrono::steady_clock::time_point> timeout) {
+	// Si ya está armado para el mismo instante no hace falta volver a armarlo
+	if (timeout == this->timerTimestamp_m) {
+		return;
+	}
+
+	struct itimerspec timerSpec = {};
+
+	if (timeout.is_initialized()) {
+		// steady_clock es CLOCK_MONOTONIC
+		int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout->time_since_epoch()).count();
+
+		// Cero desarma el timer
+		if (nanoseconds <= 0) {
+			nanoseconds = 1;
+		}
+
+		timerSpec.it_value.tv_sec = nanoseconds / 1000000000;
+		timerSpec.it_value.tv_nsec = nanoseconds % 1000000000;
+	}
+
+	if (::timerfd_settime(this->timerFd_m, TFD_TIMER_ABSTIME, &timerSpec, nullptr) < 0) {
+		throw std::runtime_error("Cannot set timerfd");
+	}
+
+	this->timerTimestamp_m = timeout;
+}
+
+Cont CPSPoller::resume(Waiter *waiter) {
+	CPSPoller *poller = waiter->poller;
+
+	PCont<uint32_t> pcont = waiter->pcont;
+	const uint32_t events = waiter->events;
+
+	// Liberar la espera antes de continuar, para que pueda reusarse
+	waiter->nextFree = poller->firstFree_m;
+	poller->firstFree_m = (uint32_t)(waiter - poller->waiters_m.data());
+
+	return pcont.invoke(events);
+}
+
+Cont CPSPoller::expire(Waiter *waiter) {
+	CPSPoller *poller = waiter->poller;
+
+	::epoll_ctl(poller->epollFd_m, EPOLL_CTL_DEL, waiter->fd, nullptr);
+
+	waiter->events = 0;
+	poller->numberOfWaiters_m--;
+
+	return CPSPoller::resume(waiter);
+}
\ No newline at end of file
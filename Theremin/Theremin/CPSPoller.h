@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSRunQueue.h"
+#include "CPSTimingWheel.h"
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+#include <boost/optional.hpp>
+
+/*
+ * Espera de un scheduler de continuaciones, con epoll y un timerfd.
+ *
+ * Permite esperar a la vez a que esté listo algún descriptor de archivo,
+ * a que se cumpla un tiempo determinado (Con el timerfd, en tiempo absoluto),
+ * y a que se despierte el scheduler por algún descriptor de aviso
+ * (Por ejemplo el del io_uring de la E/S asíncrona).
+ *
+ * Cada espera de descriptor es de una sola vez: al estar listo se deja
+ * de esperar y se encola su continuación con los eventos ocurridos.
+ * Puede tener un tiempo máximo, que se espera en la rueda de tiempo
+ * del scheduler y se cancela si el descriptor está listo antes
+ */
+class CPSPoller final
+{
+public:
+	/**
+	 * @post Crea la espera, con la rueda de tiempo para los tiempos
+	         máximos y la capacidad especificada de esperas de
+			 descriptor simultáneas
+	 */
+	CPSPoller(CPSTimingWheel& timers, unsigned int capacity = 64);
+
+	CPSPoller(const CPSPoller&) = delete;
+	CPSPoller& operator=(const CPSPoller&) = delete;
+
+	/**
+	 * @post Destruye la espera
+	 */
+	~CPSPoller();
+
+	/**
+	 * @post Devuelve si hay esperas de descriptor
+	 */
+	bool hasWaiters() const;
+
+	/**
+	 * @post Espera a que ocurra alguno de los eventos especificados (EPOLL*)
+	         en el descriptor especificado, y continúa con los eventos ocurridos.
+			 No puede haber dos esperas del mismo descriptor a la vez
+	 */
+	void add(int fd, uint32_t events, PCont<uint32_t> pcont);
+
+	/**
+	 * @post Espera a que ocurra alguno de los eventos especificados (EPOLL*)
+	         en el descriptor especificado hasta el instante especificado,
+			 y continúa con los eventos ocurridos, o con cero si se cumplió
+			 el tiempo antes.
+			 No puede haber dos esperas del mismo descriptor a la vez
+	 */
+	void add(int fd, uint32_t events, std::chrono::steady_clock::time_point timeout, PCont<uint32_t> pcont);
+
+	/**
+	 * @post Agrega un descriptor de aviso, que despierta la espera
+	         cuando tiene datos para leer, sin continuación asociada
+	 */
+	void addWakeup(int fd);
+
+	/**
+	 * @post Encola las continuaciones de los descriptores listos, sin bloquear,
+	         mientras haya lugar en la cola de continuaciones
+	 */
+	void poll(CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Espera hasta que esté listo algún descriptor, o hasta que se cumpla
+	         el tiempo especificado (Si lo hay).
+			 Encola las continuaciones de los descriptores listos
+	 */
+	void wait(boost::optional<std::chrono::steady_clock::time_point> timeout, CPSRunQueue& continuationsToExecute);
+
+private:
+	// Espera de descriptor
+	struct Waiter {
+		CPSPoller *poller;
+		int fd;
+		PCont<uint32_t> pcont;
+		uint32_t events; // Eventos ocurridos
+		bool hasTimeout; // Si tiene tiempo máximo
+		CPSTimer timer; // Espera del tiempo máximo
+		uint32_t nextFree; // Siguiente espera libre
+	};
+
+	static const uint32_t timerTag = UINT32_MAX; // Marca de los eventos del timerfd
+	static const uint32_t wakeupTag = UINT32_MAX - 1; // Marca de los eventos de los descriptores de aviso
+
+	/**
+	 * @post Espera eventos hasta el tiempo especificado en milisegundos (-1 indefinido),
+	         y encola las continuaciones de los descriptores listos
+	 */
+	void waitEvents(int timeoutMs, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Arma el timerfd para el instante especificado,
+	         o lo desarma si no hay
+	 */
+	void setTimer(boost::optional<std::chrono::steady_clock::time_point> timeout);
+
+	/**
+	 * @post Registra la espera del descriptor especificado,
+	         y la devuelve
+	 */
+	Waiter& addWaiter(int fd, uint32_t events, PCont<uint32_t> pcont);
+
+	/**
+	 * @post Continúa la espera terminada
+	 */
+	static Cont resume(Waiter *waiter);
+
+	/**
+	 * @post Deja de esperar el descriptor porque se cumplió
+	         el tiempo máximo, y continúa con cero eventos
+	 */
+	static Cont expire(Waiter *waiter);
+
+	CPSTimingWheel& timers_m;
+
+	int epollFd_m;
+	int timerFd_m;
+
+	boost::optional<std::chrono::steady_clock::time_point> timerTimestamp_m; // Instante para el que está armado el timerfd
+
+	std::vector<Waiter> waiters_m;
+	uint32_t firstFree_m; // Primer espera libre
+	unsigned int numberOfWaiters_m;
+};
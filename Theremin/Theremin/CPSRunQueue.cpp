@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSRunQueue.h"
+
+#include <stdexcept>
+
+CPSRunQueue::CPSRunQueue(size_t capacity) :
+	buffer_m(capacity)
+{
+	if (capacity == 0) {
+		throw std::runtime_error("Invalid run queue capacity");
+	}
+
+	this->head_m = 0;
+	this->size_m = 0;
+}
+
+bool CPSRunQueue::empty() const {
+	return (this->size_m == 0);
+}
+
+size_t CPSRunQueue::size() const {
+	return this->size_m;
+}
+
+size_t CPSRunQueue::capacity() const {
+	return this->buffer_m.size();
+}
+
+void CPSRunQueue::push(Cont cont) {
+	if (this->size_m == this->buffer_m.size()) {
+		throw std::runtime_error("CPS run queue overflow");
+	}
+
+	size_t index = this->head_m + this->size_m;
+
+	if (index >= this->buffer_m.size()) {
+		index -= this->buffer_m.size();
+	}
+
+	this->buffer_m[index] = cont;
+	this->size_m++;
+}
+
+Cont CPSRunQueue::front() const {
+	return this->buffer_m[this->head_m];
+}
+
+void CPSRunQueue::pop() {
+	if (++this->head_m == this->buffer_m.size()) {
+		this->head_m = 0;
+	}
+
+	this->size_m--;
+}
+
+Cont CPSRunQueue::back() const {
+	size_t index = this->head_m + this->size_m - 1;
+
+	if (index >= this->buffer_m.size()) {
+		index -= this->buffer_m.size();
+	}
+
+	return this->buffer_m[index];
+}
+
+void CPSRunQueue::popBack() {
+	this->size_m--;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+
+#include <vector>
+#include <cstddef>
+
+/*
+ * Cola de continuaciones para ejecutar, de capacidad fija.
+ *
+ * Es un buffer circular que se reserva al crearse, con lo cual
+ * encolar y desencolar no reservan ni liberan memoria.
+ * Si se supera la capacidad lanza una excepción, en lugar de
+ * crecer, para no reservar memoria en el thread del scheduler
+ */
+class CPSRunQueue final
+{
+public:
+	/**
+	 * @pre La capacidad tiene que ser mayor a cero
+	 * @post Crea la cola vacía con la capacidad especificada
+	 */
+	CPSRunQueue(size_t capacity);
+
+	/**
+	 * @post Devuelve si está vacía
+	 */
+	bool empty() const;
+
+	/**
+	 * @post Devuelve la cantidad de continuaciones encoladas
+	 */
+	size_t size() const;
+
+	/**
+	 * @post Devuelve la capacidad
+	 */
+	size_t capacity() const;
+
+	/**
+	 * @post Encola la continuación especificada.
+	         Si está llena lanza una excepción
+	 */
+	void push(Cont cont);
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Devuelve la primer continuación
+	 */
+	Cont front() const;
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Desencola la primer continuación
+	 */
+	void pop();
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Devuelve la última continuación
+	 */
+	Cont back() const;
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Quita la última continuación
+	 */
+	void popBack();
+
+private:
+	std::vector<Cont> buffer_m;
+
+	size_t head_m; // Índice de la primer continuación
+	size_t size_m;
+};
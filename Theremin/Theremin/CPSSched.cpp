@@ -31,25 +31,46 @@
  */
 
 #include "CPSSched.h"
+#include "CPSAsyncIO.h"
+#include "CPSWorkerPool.h"
 #include <stdexcept>
-#include <thread>
+
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
 
 #include <limits>
 
+constexpr std::chrono::microseconds CPSSched::defaultSpinWindow;
+
 thread_local CPSSched *threadSched = nullptr;
 
 thread_local uint64_t threadSched_refcount = 0;
 
-void CPSSched::create() {
+void CPSSched::create(size_t runQueueCapacity) {
 	if (threadSched_refcount == std::numeric_limits<uint64_t>::max()) {
 		throw std::runtime_error("Count overflow");
 	}
 
 	if (threadSched_refcount++ == 0) {
-		threadSched = new CPSSched();
+		threadSched = new CPSSched(runQueueCapacity);
 	}
 }
 
+void CPSSched::createWorker(CPSWorkerPool *pool, size_t workerIndex, size_t runQueueCapacity) {
+	if (threadSched_refcount != 0) {
+		throw std::runtime_error("CPSSched already exists on current thread");
+	}
+
+	CPSSched::create(runQueueCapacity);
+
+	threadSched->pool_m = pool;
+	threadSched->workerIndex_m = workerIndex;
+
+	// Las continuaciones encoladas en el worker por otros threads llegan por su bandeja de entrada
+	CPSSched::setInbox(&pool->getInbox(workerIndex));
+}
+
 void CPSSched::destroy() {
 	if (threadSched != nullptr ) {
 		if ( threadSched_refcount-- == 1 ) {
@@ -66,23 +87,163 @@ Cont CPSSched::fork(Cont cont1, Cont cont2) {
 	CPSSched *scheduler = CPSSched::getInstance();
 
 	scheduler->continuationsToExecute.push(cont1);
-	scheduler->continuationsToExecute.push(cont2);
+
+	// Si es un worker la segunda continuación se puede repartir entre los demás
+	if (scheduler->pool_m != nullptr) {
+		scheduler->pool_m->pushStealable(scheduler->workerIndex_m, cont2);
+	}
+	else {
+		scheduler->continuationsToExecute.push(cont2);
+	}
 
 	return Cont(CPSSched::executePendingContinuation, scheduler);
 }
 
+Cont CPSSched::forkOn(size_t workerIndex, Cont cont1, Cont cont2) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->continuationsToExecute.push(cont1);
+
+	if (scheduler->pool_m != nullptr) {
+		workerIndex %= scheduler->pool_m->getNumberOfWorkers();
+	}
+
+	if ((scheduler->pool_m != nullptr) && (workerIndex != scheduler->workerIndex_m)) {
+		scheduler->pool_m->pushInbox(workerIndex, cont2);
+	}
+	else {
+		scheduler->continuationsToExecute.push(cont2);
+	}
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+size_t CPSSched::getWorkerIndex() {
+	return CPSSched::getInstance()->workerIndex_m;
+}
+
 Cont CPSSched::waitFor(std::chrono::steady_clock::duration duration, Cont cont) {
 	CPSSched *scheduler = CPSSched::getInstance();
 
-	std::chrono::steady_clock::time_point& currentTimestamp = scheduler->currentTimestamp_m;
+	scheduler->updateWaitingContinuations();
 
-	currentTimestamp = std::chrono::steady_clock::now();
+	scheduler->waitingContinuations_m.add(scheduler->clock_m->now() + duration, cont);
 
-	scheduler->waitingContinuationsByTimestamp.push(Timestamped<std::chrono::steady_clock::time_point, Cont>(currentTimestamp + duration, cont));
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+Cont CPSSched::waitUntil(std::chrono::steady_clock::time_point timestamp, Cont cont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->updateWaitingContinuations();
+
+	scheduler->waitingContinuations_m.add(timestamp, cont);
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+Cont CPSSched::waitFor(std::chrono::steady_clock::duration duration, std::chrono::steady_clock::duration deadline, Cont cont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->updateWaitingContinuations();
+
+	const std::chrono::steady_clock::time_point now = scheduler->clock_m->now();
+
+	scheduler->waitingContinuations_m.add(now + duration, now + deadline, cont);
 
 	return Cont(CPSSched::executePendingContinuation, scheduler);
 }
 
+Cont CPSSched::waitUntil(std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point deadline, Cont cont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->updateWaitingContinuations();
+
+	scheduler->waitingContinuations_m.add(timestamp, deadline, cont);
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+CPSTimer CPSSched::startTimer(std::chrono::steady_clock::duration duration, Cont cont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->updateWaitingContinuations();
+
+	return scheduler->waitingContinuations_m.add(scheduler->clock_m->now() + duration, cont);
+}
+
+bool CPSSched::cancelTimer(CPSTimer timer) {
+	return CPSSched::getInstance()->waitingContinuations_m.cancel(timer);
+}
+
+std::chrono::steady_clock::duration CPSSched::getOversleep() {
+	return CPSSched::getInstance()->waitingContinuations_m.getLastOversleep();
+}
+
+void CPSSched::setSpinWindow(std::chrono::steady_clock::duration spinWindow) {
+	CPSSched::getInstance()->spinWindow_m = spinWindow;
+}
+
+void CPSSched::setClock(Clock& clock) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	if (!scheduler->waitingContinuations_m.empty()) {
+		throw std::runtime_error("Cannot change CPSSched clock with waiting continuations");
+	}
+
+	scheduler->clock_m = &clock;
+	scheduler->waitingContinuations_m.setClock(clock);
+
+	scheduler->currentTimestamp_m = clock.now();
+}
+
+Clock& CPSSched::getClock() {
+	return *CPSSched::getInstance()->clock_m;
+}
+
+std::chrono::steady_clock::time_point CPSSched::now() {
+	return CPSSched::getInstance()->clock_m->now();
+}
+
+CPSInstrumentation * CPSSched::getInstrumentation() {
+	return CPSSched::getInstance()->instrumentation_m.get();
+}
+
+uint64_t CPSSched::getNumberOfAsyncIOSyscalls() {
+	CPSAsyncIO *asyncIO = CPSSched::getInstance()->asyncIO_m.get();
+
+	return (asyncIO != nullptr) ? asyncIO->getNumberOfSyscalls() : 0;
+}
+
+CPSInbox * CPSSched::getInbox() {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	if (scheduler->inbox_m == nullptr) {
+		scheduler->ownInbox_m.reset(new CPSInbox(CPSSched::defaultInboxCapacity));
+
+		CPSSched::setInbox(scheduler->ownInbox_m.get());
+	}
+
+	return scheduler->inbox_m;
+}
+
+void CPSSched::setInbox(CPSInbox *inbox) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	if (scheduler->inbox_m != nullptr) {
+		throw std::runtime_error("CPSSched already has an inbox");
+	}
+
+	scheduler->inbox_m = inbox;
+
+	// Despertar cuando otro thread encola algo y no hay nada para ejecutar
+	scheduler->poller_m.addWakeup(inbox->getFileDescriptor());
+}
+
+Cont CPSSched::finish() {
+	return Cont(CPSSched::executePendingContinuation, CPSSched::getInstance());
+}
+
 Cont CPSSched::yield(Cont cont) {
 	CPSSched *scheduler = CPSSched::getInstance();
 
@@ -91,9 +252,117 @@ Cont CPSSched::yield(Cont cont) {
 	return Cont(CPSSched::executePendingContinuation, scheduler);
 }
 
-CPSSched::CPSSched()
+Cont CPSSched::yield(std::chrono::steady_clock::time_point deadline, Cont cont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->deadlineContinuations_m.push(deadline, cont);
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+Cont CPSSched::asyncRead(int fd, void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+	CPSAsyncIO *asyncIO = scheduler->getAsyncIO();
+
+	if (asyncIO->isAvailable()) {
+		asyncIO->read(fd, buffer, length, offset, pcont, scheduler->continuationsToExecute);
+
+		return Cont(CPSSched::executePendingContinuation, scheduler);
+	}
+	else {
+		ssize_t result = ::pread(fd, buffer, length, offset);
+
+		return pcont.invoke((result >= 0) ? result : -errno);
+	}
+}
+
+Cont CPSSched::asyncWrite(int fd, const void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+	CPSAsyncIO *asyncIO = scheduler->getAsyncIO();
+
+	if (asyncIO->isAvailable()) {
+		asyncIO->write(fd, buffer, length, offset, pcont, scheduler->continuationsToExecute);
+
+		return Cont(CPSSched::executePendingContinuation, scheduler);
+	}
+	else {
+		ssize_t result = ::pwrite(fd, buffer, length, offset);
+
+		return pcont.invoke((result >= 0) ? result : -errno);
+	}
+}
+
+Cont CPSSched::waitForFd(int fd, uint32_t events, PCont<uint32_t> pcont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	scheduler->poller_m.add(fd, events, pcont);
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+Cont CPSSched::waitAny(int fd, uint32_t events, std::chrono::steady_clock::duration timeout, PCont<uint32_t> pcont) {
+	CPSSched *scheduler = CPSSched::getInstance();
+
+	// El tiempo máximo se espera en la rueda de tiempo, y se cancela si el descriptor está listo antes
+	scheduler->updateWaitingContinuations();
+
+	scheduler->poller_m.add(fd, events, scheduler->clock_m->now() + timeout, pcont);
+
+	return Cont(CPSSched::executePendingContinuation, scheduler);
+}
+
+CPSCoroutine::WaitFor CPSSched::waitFor(std::chrono::steady_clock::duration duration) {
+	return CPSCoroutine::WaitFor(duration);
+}
+
+CPSCoroutine::WaitUntil CPSSched::waitUntil(std::chrono::steady_clock::time_point timestamp) {
+	return CPSCoroutine::WaitUntil(timestamp);
+}
+
+CPSCoroutine::Yield CPSSched::yield() {
+	return CPSCoroutine::Yield();
+}
+
+CPSCoroutine::AsyncIO CPSSched::asyncRead(int fd, void *buffer, size_t length, off_t offset) {
+	return CPSCoroutine::AsyncIO(false, fd, buffer, length, offset);
+}
+
+CPSCoroutine::AsyncIO CPSSched::asyncWrite(int fd, const void *buffer, size_t length, off_t offset) {
+	return CPSCoroutine::AsyncIO(true, fd, const_cast<void *>(buffer), length, offset);
+}
+
+CPSCoroutine::WaitForFd CPSSched::waitForFd(int fd, uint32_t events) {
+	return CPSCoroutine::WaitForFd(fd, events);
+}
+
+CPSCoroutine::WaitForFd CPSSched::waitAny(int fd, uint32_t events, std::chrono::steady_clock::duration timeout) {
+	return CPSCoroutine::WaitForFd(fd, events, timeout);
+}
+
+CPSSched::CPSSched(size_t runQueueCapacity) :
+	continuationsToExecute(runQueueCapacity),
+	deadlineContinuations_m(runQueueCapacity),
+	poller_m(waitingContinuations_m)
 {
+	// Las continuaciones de tiempo canceladas después de encolarse siguen con el scheduler
+	this->waitingContinuations_m.setCancelledContinuation(Cont(CPSSched::executePendingContinuation, this));
+
+	this->dispatchesSinceSubmit_m = 0;
+	this->dispatchesSincePoll_m = 0;
+
+	this->spinWindow_m = CPSSched::defaultSpinWindow;
+	this->clock_m = &Clock::getSteady();
+
+#ifdef CPS_INSTRUMENTATION
+	this->instrumentation_m.reset(new CPSInstrumentation());
+	this->instrumentation_m->setSchedulerFunction(reinterpret_cast<const void *>(CPSSched::executePendingContinuation));
+	this->waitingContinuations_m.setInstrumentation(this->instrumentation_m.get());
+#endif
+
+	this->inbox_m = nullptr;
 
+	this->pool_m = nullptr;
+	this->workerIndex_m = 0;
 }
 
 CPSSched::~CPSSched()
@@ -112,51 +381,239 @@ CPSSched * CPSSched::getInstance() {
 	}
 }
 
+size_t CPSSched::getNumberOfContinuationsToExecute() const {
+	return this->continuationsToExecute.size() + this->deadlineContinuations_m.size();
+}
+
+void CPSSched::updateWaitingContinuations() {
+	if (this->waitingContinuations_m.empty()) {
+		this->currentTimestamp_m = this->clock_m->now();
+		this->waitingContinuations_m.advance(this->currentTimestamp_m, this->continuationsToExecute, this->deadlineContinuations_m);
+	}
+}
+
+CPSAsyncIO * CPSSched::getAsyncIO() {
+	if (this->asyncIO_m == nullptr) {
+		this->asyncIO_m.reset(new CPSAsyncIO());
+
+		// Despertar al terminar operaciones cuando no hay nada para ejecutar
+		if (this->asyncIO_m->isAvailable()) {
+			this->poller_m.addWakeup(this->asyncIO_m->getFileDescriptor());
+		}
+	}
+
+	return this->asyncIO_m.get();
+}
+
+void CPSSched::sleepUntil(std::chrono::steady_clock::time_point timestamp) {
+	// steady_clock es CLOCK_MONOTONIC
+	const int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+
+	struct timespec timestampSpec;
+	timestampSpec.tv_sec = nanoseconds / 1000000000;
+	timestampSpec.tv_nsec = nanoseconds % 1000000000;
+
+	// Si lo interrumpe una señal volver a dormir hasta el mismo instante
+	while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &timestampSpec, nullptr) == EINTR);
+}
+
+void CPSSched::cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
 Cont CPSSched::executePendingContinuation(CPSSched *scheduler) {
-	// Tratar las continuaciones que deben empezar despus en un momento determinado (En sleep)
-	if (!scheduler->waitingContinuationsByTimestamp.empty()) {
-		auto nextTimestampedCont = scheduler->waitingContinuationsByTimestamp.top();
-		auto& currentTimestamp = scheduler->currentTimestamp_m;
+	CPSWorkerPool *pool = scheduler->pool_m;
+	CPSInbox *inbox = scheduler->inbox_m;
+
+	if (pool != nullptr) {
+		// Si se pidió terminar a los workers terminar
+		if (pool->isStopping()) {
+			return CPS_EXIT;
+		}
+
+		// Tomar las continuaciones encoladas para el worker
+		pool->collect(scheduler->workerIndex_m, scheduler->continuationsToExecute);
+	}
+	else if (inbox != nullptr) {
+		// Tomar las continuaciones encoladas por otros threads
+		inbox->collect(scheduler->continuationsToExecute);
+	}
 
-		bool queueContinuation;
+	CPSAsyncIO *asyncIO = scheduler->asyncIO_m.get();
+	const bool hasAsyncIO = (asyncIO != nullptr) && asyncIO->hasOperations();
+
+	if (hasAsyncIO) {
+		// Encolar las continuaciones de las operaciones terminadas, sin syscalls
+		asyncIO->reap(scheduler->continuationsToExecute);
 
 		/*
-		 * Si no hay ms continuaciones para ejecutar immediatamente esperar a que
-		 * se cumpla el tiempo de la continuacin ms prxima a ejecutarse
+		 * Enviar las operaciones pendientes todas juntas, cuando no hay nada más para
+		 * ejecutar o cuando ya se dio una vuelta a la cola de continuaciones
 		 */
-		if (scheduler->continuationsToExecute.empty()) {
-			if (currentTimestamp < nextTimestampedCont.timestamp()) {
-				auto waitTime = nextTimestampedCont.timestamp() - currentTimestamp;
+		if (asyncIO->hasUnsubmittedOperations()) {
+			const size_t numberOfContinuationsToExecute = scheduler->getNumberOfContinuationsToExecute();
+
+			if ((numberOfContinuationsToExecute == 0) || (++scheduler->dispatchesSinceSubmit_m >= numberOfContinuationsToExecute)) {
+				asyncIO->submit(scheduler->continuationsToExecute);
+				scheduler->dispatchesSinceSubmit_m = 0;
+			}
+		}
+	}
 
-				std::this_thread::sleep_for(waitTime);
+	// Revisar los descriptores esperados, sin bloquear, cada vez que se da una vuelta a la cola de continuaciones
+	if (scheduler->poller_m.hasWaiters() && (scheduler->getNumberOfContinuationsToExecute() > 0)) {
+		if (++scheduler->dispatchesSincePoll_m >= scheduler->getNumberOfContinuationsToExecute()) {
+			scheduler->poller_m.poll(scheduler->continuationsToExecute);
+			scheduler->dispatchesSincePoll_m = 0;
+		}
+	}
+
+	auto& currentTimestamp = scheduler->currentTimestamp_m;
+
+	/*
+	 * Si no hay más continuaciones para ejecutar immediatamente esperar a que
+	 * se cumpla el tiempo de la continuación más próxima a ejecutarse, a que
+	 * esté listo algún descriptor esperado, o a que termine alguna operación de E/S
+	 */
+	if (scheduler->getNumberOfContinuationsToExecute() == 0) {
+		boost::optional<std::chrono::steady_clock::time_point> nextTimestamp;
+
+		boost::optional<std::chrono::steady_clock::time_point> wakeupTimestamp;
+
+		/*
+		 * Despertarse antes de la continuación más próxima, y esperar
+		 * activamente el resto, para no depender de la latencia de despertarse
+		 */
+		if (!scheduler->waitingContinuations_m.empty()) {
+			nextTimestamp = scheduler->waitingContinuations_m.nextTimestamp();
+			wakeupTimestamp = *nextTimestamp - scheduler->spinWindow_m;
+		}
+
+		if ((pool != nullptr) && pool->steal(scheduler->workerIndex_m, scheduler->continuationsToExecute)) {
+			// Si es un worker robarle continuaciones a los demás antes de dormir
+		}
+		else if (nextTimestamp.is_initialized() && scheduler->clock_m->skipTo(*nextTimestamp)) {
+			/*
+			 * Con un reloj virtual no se duerme: se salta directamente al instante
+			 * de la continuación más próxima, después de revisar sin bloquear
+			 * si llegó algo de otros threads, de descriptores o de E/S
+			 */
+			if (pool != nullptr) {
+				pool->collect(scheduler->workerIndex_m, scheduler->continuationsToExecute);
+			}
+			else if (inbox != nullptr) {
+				inbox->collect(scheduler->continuationsToExecute);
+			}
 
-				currentTimestamp = nextTimestampedCont.timestamp();
+			if (hasAsyncIO) {
+				asyncIO->reap(scheduler->continuationsToExecute);
 			}
 
-			queueContinuation = true;
+			if (scheduler->poller_m.hasWaiters()) {
+				scheduler->poller_m.poll(scheduler->continuationsToExecute);
+			}
+		}
+		else if ((inbox == nullptr) && nextTimestamp.is_initialized() && !hasAsyncIO && !scheduler->poller_m.hasWaiters()) {
+			/*
+			 * Si sólo hay esperas de tiempo, y ningún otro thread puede
+			 * encolar continuaciones, dormir directamente, en tiempo absoluto
+			 */
+			if (scheduler->clock_m->now() < *wakeupTimestamp) {
+				CPSSched::sleepUntil(*wakeupTimestamp);
+			}
 		}
-		else {
-			// Caso contrario encolarla para ejecutarse slo si se cumpli el tiempo que le corresponde
-			queueContinuation = (currentTimestamp >= nextTimestampedCont.timestamp());
+		else if ((inbox != nullptr) || nextTimestamp.is_initialized() || hasAsyncIO || scheduler->poller_m.hasWaiters()) {
+			/*
+			 * Anunciarse como dormido antes de volver a mirar si hay algo
+			 * encolado, para que quien encole después lo despierte por el eventfd
+			 */
+			if (inbox != nullptr) {
+				inbox->setSleeping(true);
+			}
+
+			bool hasWork;
+
+			if (pool != nullptr) {
+				hasWork = pool->isStopping() || pool->hasWork(scheduler->workerIndex_m);
+			}
+			else {
+				hasWork = (inbox != nullptr) && !inbox->empty();
+			}
+
+			if (!hasWork) {
+				scheduler->poller_m.wait(wakeupTimestamp, scheduler->continuationsToExecute);
+			}
+
+			if (inbox != nullptr) {
+				inbox->setSleeping(false);
+				inbox->clearWakeup();
+
+				if (pool != nullptr) {
+					pool->collect(scheduler->workerIndex_m, scheduler->continuationsToExecute);
+				}
+				else {
+					inbox->collect(scheduler->continuationsToExecute);
+				}
+			}
+
+			if (hasAsyncIO) {
+				asyncIO->reap(scheduler->continuationsToExecute);
+			}
 		}
 
-		// Encolar la continuacin para ser ejecutada si corresponde
-		if ( queueContinuation ) {
-			Cont nextCont = nextTimestampedCont.value();
+		/*
+		 * Esperar activamente hasta la continuación más próxima, si ya se está
+		 * dentro de la ventana y no llegó otra cosa para ejecutar
+		 */
+		if (nextTimestamp.is_initialized() && (scheduler->getNumberOfContinuationsToExecute() == 0)) {
+			std::chrono::steady_clock::time_point now = scheduler->clock_m->now();
 
-			scheduler->waitingContinuationsByTimestamp.pop();
+			if (now >= *wakeupTimestamp) {
+				while (now < *nextTimestamp) {
+					CPSSched::cpuRelax();
 
-			scheduler->continuationsToExecute.push(nextCont);
+					now = scheduler->clock_m->now();
+				}
+			}
 		}
 	}
 
-    // Desencolar y ejecutar una continuacin pendiente de ser ejecutada
-	if (!scheduler->continuationsToExecute.empty()) {
+	/*
+	 * Encolar las continuaciones que esperan tiempo cuyo tiempo se cumplió.
+	 * El tiempo se actualiza siempre, para que no se atrasen mientras haya
+	 * otras continuaciones ejecutándose (Por ejemplo esperando un eco)
+	 */
+	if (!scheduler->waitingContinuations_m.empty()) {
+		currentTimestamp = scheduler->clock_m->now();
+
+		scheduler->waitingContinuations_m.advance(currentTimestamp, scheduler->continuationsToExecute, scheduler->deadlineContinuations_m);
+	}
+
+#ifdef CPS_INSTRUMENTATION
+	scheduler->instrumentation_m->recordQueueDepths(scheduler->getNumberOfContinuationsToExecute(), scheduler->waitingContinuations_m.size());
+#endif
+
+	// Desencolar y ejecutar una continuación pendiente de ser ejecutada, primero las que tienen plazo
+	if (!scheduler->deadlineContinuations_m.empty()) {
+		Cont nextCont = scheduler->deadlineContinuations_m.front();
+		scheduler->deadlineContinuations_m.pop();
+
+		return nextCont;
+	}
+	else if (!scheduler->continuationsToExecute.empty()) {
 		Cont nextCont = scheduler->continuationsToExecute.front();
 		scheduler->continuationsToExecute.pop();
 
 		return nextCont;
 	}
+	else if ((inbox != nullptr) || !scheduler->waitingContinuations_m.empty() || hasAsyncIO || scheduler->poller_m.hasWaiters()) {
+		// Todavía no hay nada para ejecutar, volver a intentar
+		return Cont(CPSSched::executePendingContinuation, scheduler);
+	}
 	else {
 		throw std::runtime_error("Assertion error: Missing tasks!");
 	}
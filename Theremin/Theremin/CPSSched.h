@@ -37,68 +37,371 @@
 
 #include <chrono>
 
-#include <queue>
+#include "CPSRunQueue.h"
+#include "CPSDeadlineQueue.h"
+#include "CPSTimingWheel.h"
+#include "CPSPoller.h"
+#include "CPSInstrumentation.h"
+#include "CPSInbox.h"
+#include "CPSFrameArena.h"
+#include "CPSTask.h"
+#include "Clock.h"
 
-#include "Timestamped.h"
+#include <memory>
+#include <sys/types.h>
+
+class CPSAsyncIO;
+class CPSWorkerPool;
 
 class CPSSched final
 {
 public:
+	// Capacidad por defecto de la cola de continuaciones para ejecutar
+	static const size_t defaultRunQueueCapacity = 4096;
+
 	/**
 	 * @pre No tiene que haber un scheduler creado
-	 * @post Crea el scheduler en el thread
+	 * @post Crea el scheduler en el thread, con la capacidad
+	         especificada de la cola de continuaciones para ejecutar.
+			 Superar la capacidad es un error (Lanza una excepción)
 
 			 Si ya existe incrementa la cuenta de referencias
+			 (Y la capacidad especificada no tiene efecto)
 	 */
-	static void create();
+	static void create(size_t runQueueCapacity = defaultRunQueueCapacity);
 
 	/**
 	 * @pre El scheduler tiene que existir
-	 * @post Destruye el scheduler del thread, si slo
+	 * @post Destruye el scheduler del thread, si sólo
 	         hay una referencia.
-			 Caso contrario slo decrementa la cuenta de referencias
+			 Caso contrario sólo decrementa la cuenta de referencias
 	 */
 	static void destroy();
 
 	/**
-	 * @post Forkea el hilo de ejecucin en dos continuaciones
+	 * @post Forkea el hilo de ejecución en dos continuaciones.
+	         Si el scheduler es un worker de un conjunto de workers
+			 la segunda continuación la puede ejecutar cualquiera de ellos
 	 */
 	static Cont fork(Cont cont1, Cont cont2);
 
+	/**
+	 * @post Forkea el hilo de ejecución en dos continuaciones, ejecutando
+	         la segunda en el worker especificado (Módulo la cantidad de workers),
+			 sin que la puedan robar los demás.
+			 Si el scheduler no es un worker es equivalente a 'fork'
+	 */
+	static Cont forkOn(size_t workerIndex, Cont cont1, Cont cont2);
+
+	/**
+	 * @post Devuelve el índice del worker del thread
+	         (Cero si el scheduler no es un worker)
+	 */
+	static size_t getWorkerIndex();
+
 	/**
 	 * @post Espera la cantidad de tiempo especificada,
-	         y ejecuta la continuacin especificada
+	         y ejecuta la continuación especificada
 	 */
 	static Cont waitFor(std::chrono::steady_clock::duration duration, Cont cont);
 
 	/**
-	 * @post Deja el CPU a otra continuacin
+	 * @post Espera hasta el instante especificado,
+	         y ejecuta la continuación especificada.
+			 Para esperas periódicas sin acumular el retraso
+	 */
+	static Cont waitUntil(std::chrono::steady_clock::time_point timestamp, Cont cont);
+
+	/**
+	 * @post Espera la cantidad de tiempo especificada, y ejecuta la
+	         continuación especificada con plazo hasta el tiempo
+			 especificado desde ahora (Ver yield con plazo)
+	 */
+	static Cont waitFor(std::chrono::steady_clock::duration duration, std::chrono::steady_clock::duration deadline, Cont cont);
+
+	/**
+	 * @post Espera hasta el instante especificado, y ejecuta la
+	         continuación especificada con el plazo especificado
+			 (Ver yield con plazo)
+	 */
+	static Cont waitUntil(std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point deadline, Cont cont);
+
+	/**
+	 * @post Programa la continuación especificada para ejecutarse después de
+	         la cantidad de tiempo especificada, como un hilo de ejecución
+			 aparte, y devuelve la referencia para cancelarla
+	 */
+	static CPSTimer startTimer(std::chrono::steady_clock::duration duration, Cont cont);
+
+	/**
+	 * @post Cancela la continuación programada especificada (En O(1)), si
+	         todavía no se ejecutó. Devuelve si se canceló
+	 */
+	static bool cancelTimer(CPSTimer timer);
+
+	/**
+	 * @post Devuelve cuánto después de su instante empezó a ejecutarse la
+	         última continuación que esperaba tiempo.
+			 Llamado al principio de la continuación de 'waitFor' o
+			 'waitUntil' devuelve el retraso de esa espera
+	 */
+	static std::chrono::steady_clock::duration getOversleep();
+
+	// Ventana de espera activa por defecto
+	static constexpr std::chrono::microseconds defaultSpinWindow = std::chrono::microseconds(50);
+
+	/**
+	 * @post Especifica cuánto antes de la continuación más próxima deja
+	         de dormir para esperar activamente (Consumiendo CPU), para que
+			 se ejecute a tiempo a pesar de la latencia de despertarse.
+			 Cero para no esperar activamente
+	 */
+	static void setSpinWindow(std::chrono::steady_clock::duration spinWindow);
+
+	/**
+	 * @post Especifica el reloj del scheduler del thread (Por defecto
+	         steady_clock), con el que se miden todas las esperas de tiempo.
+			 Con un reloj virtual, cuando sólo hay esperas de tiempo en lugar
+			 de dormir salta directamente al instante de la más próxima, para
+			 ejecutar simulaciones más rápido que en tiempo real.
+			 El reloj tiene que existir mientras exista el scheduler
+	 * @pre No tiene que haber continuaciones esperando tiempo
+	 */
+	static void setClock(Clock& clock);
+
+	/**
+	 * @post Devuelve el reloj del scheduler del thread
+	 */
+	static Clock& getClock();
+
+	/**
+	 * @post Devuelve el instante actual según el reloj del scheduler del thread.
+	         Con él se tienen que calcular los instantes y plazos absolutos
+	 */
+	static std::chrono::steady_clock::time_point now();
+
+	/**
+	 * @post Devuelve la instrumentación del scheduler del thread, de la que
+	         se pueden obtener copias desde otros threads mientras exista el
+			 scheduler.
+			 Si no se compiló con CPS_INSTRUMENTATION devuelve nullptr
+	 */
+	static CPSInstrumentation * getInstrumentation();
+
+	/**
+	 * @post Devuelve la cantidad de syscalls (io_uring_enter) de la E/S
+	         asíncrona del scheduler del thread.
+			 Cero si todavía no hubo E/S asíncrona o no hay io_uring
+	 */
+	static uint64_t getNumberOfAsyncIOSyscalls();
+
+	// Capacidad por defecto de la bandeja de entrada
+	static const size_t defaultInboxCapacity = 256;
+
+	/**
+	 * @post Devuelve la bandeja de entrada del scheduler del thread, en la
+	         que otros threads pueden encolar continuaciones o despertarlo.
+			 Si no tiene la crea, con la capacidad por defecto.
+			 Existe mientras exista el scheduler
+	 */
+	static CPSInbox * getInbox();
+
+	/**
+	 * @pre El scheduler no tiene que tener bandeja de entrada, y la
+	        especificada tiene que existir mientras exista el scheduler
+	 * @post Especifica la bandeja de entrada del scheduler del thread.
+	         Las continuaciones encoladas antes de especificarla se
+			 ejecutan igual
+	 */
+	static void setInbox(CPSInbox *inbox);
+
+	/**
+	 * @post Termina el hilo de ejecución actual, y sigue con las demás
+	         continuaciones. Por ejemplo al final de una continuación
+			 encolada desde otro thread
+	 */
+	static Cont finish();
+
+	/**
+	 * @post Deja el CPU a otra continuación
 	 */
 	static Cont yield(Cont cont);
 
+	/**
+	 * @post Deja el CPU a otra continuación, y sigue con la continuación
+	         especificada con el plazo especificado.
+			 Las continuaciones con plazo se ejecutan antes que las demás,
+			 la de plazo más próximo primero (EDF), con lo cual las que
+			 son críticas en tiempo no esperan detrás de las demás.
+			 Mientras haya continuaciones con plazo las demás no se
+			 ejecutan, tienen que ser pasos cortos
+	 */
+	static Cont yield(std::chrono::steady_clock::time_point deadline, Cont cont);
+
+	/**
+	 * @post Lee del archivo especificado (pread), y continúa
+	         con la cantidad de bytes leídos o -errno.
+			 La lectura se encola en el io_uring del scheduler
+			 y se envía junto con las demás pendientes.
+			 Si no hay io_uring se hace de forma síncrona
+	 */
+	static Cont asyncRead(int fd, void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont);
+
+	/**
+	 * @post Escribe en el archivo especificado (pwrite), y continúa
+	         con la cantidad de bytes escritos o -errno.
+			 La escritura se encola en el io_uring del scheduler
+			 y se envía junto con las demás pendientes.
+			 Si no hay io_uring se hace de forma síncrona
+	 */
+	static Cont asyncWrite(int fd, const void *buffer, size_t length, off_t offset, PCont<ssize_t> pcont);
+
+	/**
+	 * @post Espera a que ocurra alguno de los eventos especificados (EPOLL*)
+	         en el descriptor de archivo especificado, sin bloquear a las
+			 demás continuaciones, y continúa con los eventos ocurridos.
+			 No puede haber dos esperas del mismo descriptor a la vez
+	 */
+	static Cont waitForFd(int fd, uint32_t events, PCont<uint32_t> pcont);
+
+	/**
+	 * @post Espera lo primero que ocurra entre alguno de los eventos
+	         especificados (EPOLL*) en el descriptor de archivo especificado
+			 y el tiempo máximo especificado, sin bloquear a las demás
+			 continuaciones. Continúa con los eventos ocurridos, o con
+			 cero si se cumplió el tiempo.
+			 No puede haber dos esperas del mismo descriptor a la vez
+	 */
+	static Cont waitAny(int fd, uint32_t events, std::chrono::steady_clock::duration timeout, PCont<uint32_t> pcont);
+
+	/*
+	 * Esperas para corrutinas (co_await), equivalentes a las de continuaciones
+	 */
+
+	/**
+	 * @post Espera la cantidad de tiempo especificada
+	 */
+	static CPSCoroutine::WaitFor waitFor(std::chrono::steady_clock::duration duration);
+
+	/**
+	 * @post Espera hasta el instante especificado
+	 */
+	static CPSCoroutine::WaitUntil waitUntil(std::chrono::steady_clock::time_point timestamp);
+
+	/**
+	 * @post Deja el CPU a otra continuación
+	 */
+	static CPSCoroutine::Yield yield();
+
+	/**
+	 * @post Lee del archivo especificado (pread), y devuelve
+	         la cantidad de bytes leídos o -errno
+	 */
+	static CPSCoroutine::AsyncIO asyncRead(int fd, void *buffer, size_t length, off_t offset);
+
+	/**
+	 * @post Escribe en el archivo especificado (pwrite), y devuelve
+	         la cantidad de bytes escritos o -errno
+	 */
+	static CPSCoroutine::AsyncIO asyncWrite(int fd, const void *buffer, size_t length, off_t offset);
+
+	/**
+	 * @post Espera a que ocurra alguno de los eventos especificados (EPOLL*)
+	         en el descriptor de archivo especificado, y devuelve los
+			 eventos ocurridos
+	 */
+	static CPSCoroutine::WaitForFd waitForFd(int fd, uint32_t events);
+
+	/**
+	 * @post Espera lo primero que ocurra entre alguno de los eventos
+	         especificados (EPOLL*) en el descriptor de archivo especificado
+			 y el tiempo máximo especificado. Devuelve los eventos ocurridos,
+			 o cero si se cumplió el tiempo
+	 */
+	static CPSCoroutine::WaitForFd waitAny(int fd, uint32_t events, std::chrono::steady_clock::duration timeout);
+
 private:
 	/**
-	* @post Crea el scheduler
+	* @post Crea el scheduler, con la capacidad especificada
+	        de la cola de continuaciones para ejecutar
 	*/
-	CPSSched();
+	CPSSched(size_t runQueueCapacity);
 
 	/**
 	* @post Destruye el scheduler
 	*/
 	~CPSSched();
 
+	friend class CPSWorkerPool;
+	friend class CPSCoroutine;
+	template<typename T> friend class CPSChannel;
+
+	/**
+	 * @pre No tiene que haber un scheduler creado
+	 * @post Crea el scheduler en el thread, como el worker especificado
+	         del conjunto de workers especificado
+	 */
+	static void createWorker(CPSWorkerPool *pool, size_t workerIndex, size_t runQueueCapacity);
+
 	/**
 	 * @post Devuelve la instancia de thread
 	 */
 	static CPSSched * getInstance();
 
+	/**
+	 * @post Si no hay esperas de tiempo pone al día la rueda de tiempo,
+	         que puede haber quedado atrás
+	 */
+	void updateWaitingContinuations();
+
+	/**
+	 * @post Devuelve la cantidad de continuaciones para ejecutar,
+	         con y sin plazo
+	 */
+	size_t getNumberOfContinuationsToExecute() const;
+
+	/**
+	 * @post Devuelve la E/S asíncrona, creándola si no existe
+	 */
+	CPSAsyncIO * getAsyncIO();
+
+	/**
+	 * @post Duerme el thread hasta el instante especificado,
+	         en tiempo absoluto (clock_nanosleep)
+	 */
+	static void sleepUntil(std::chrono::steady_clock::time_point timestamp);
+
+	/**
+	 * @post Avisa al CPU que está en una espera activa
+	 */
+	static void cpuRelax();
+
 	/*
-	 * @post Ejecuta una continuacin pendiente del scheduler
+	 * @post Ejecuta una continuación pendiente del scheduler
 	 */
 	static Cont executePendingContinuation(CPSSched *scheduler);
 
-	std::priority_queue<Timestamped<std::chrono::steady_clock::time_point, Cont>, std::deque<Timestamped<std::chrono::steady_clock::time_point, Cont>>, Timestamped<std::chrono::steady_clock::time_point, Cont>::TimeCompare> waitingContinuationsByTimestamp;
-	std::queue<Cont> continuationsToExecute;
+	CPSTimingWheel waitingContinuations_m; // Continuaciones que esperan tiempo
+	CPSRunQueue continuationsToExecute;
+	CPSDeadlineQueue deadlineContinuations_m; // Continuaciones para ejecutar con plazo, antes que las demás
 
 	std::chrono::steady_clock::time_point currentTimestamp_m;
+	std::chrono::steady_clock::duration spinWindow_m; // Ventana de espera activa antes de la continuación más próxima
+	Clock *clock_m; // Reloj de las esperas de tiempo
+
+	std::unique_ptr<CPSAsyncIO> asyncIO_m;
+	size_t dispatchesSinceSubmit_m; // Continuaciones ejecutadas desde el último envío de E/S
+
+	CPSPoller poller_m; // Espera de descriptores y tiempo cuando no hay nada para ejecutar
+	size_t dispatchesSincePoll_m; // Continuaciones ejecutadas desde la última revisión de descriptores
+
+	CPSFrameArena frameArena_m; // Frames de las corrutinas
+
+	std::unique_ptr<CPSInstrumentation> instrumentation_m; // Sólo si se compiló con CPS_INSTRUMENTATION
+
+	std::unique_ptr<CPSInbox> ownInbox_m; // Bandeja de entrada creada por el scheduler (Opcional)
+	CPSInbox *inbox_m; // Bandeja de entrada, propia o externa (Opcional)
+
+	CPSWorkerPool *pool_m; // Conjunto de workers al que pertenece (Opcional)
+	size_t workerIndex_m; // Índice en el conjunto de workers
 };
\ No newline at end of file
@@ -0,0 +1,309 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSSched.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include <sys/types.h>
+
+/*
+ * Máquina de estados sobre el scheduler de continuaciones, con los
+ * estados y las transiciones conocidos en tiempo de compilación.
+ *
+ * La máquina (Machine) define los estados con un enum (State) y un
+ * método 'step' que, dado el estado actual, hace su trabajo y devuelve
+ * la transición al siguiente estado. Normalmente es un switch sobre
+ * el estado, que el compilador puede incorporar al loop de despacho
+ * de la máquina.
+ *
+ * Las transiciones directas (go) no pasan por el scheduler: se sigue
+ * con el siguiente estado en el mismo loop, sin llamadas indirectas.
+ * Las demás (yield, waitFor, asyncRead...) devuelven el control al
+ * scheduler con una sola continuación que reanuda la máquina, y el
+ * resultado de las que lo tienen queda en getResult().
+ *
+ * Una máquina tiene un solo hilo de ejecución a la vez
+ */
+template<typename Machine, typename State>
+class CPSStateMachine final
+{
+public:
+	// Transición al siguiente estado, que devuelve 'step'
+	class Transition final {
+	public:
+		friend class CPSStateMachine;
+
+	private:
+		enum class Kind {
+			go,
+			yield,
+			yieldWithDeadline,
+			waitFor,
+			waitForWithDeadline,
+			waitUntil,
+			asyncRead,
+			waitAny,
+			exit
+		};
+
+		Transition(Kind kind, State state) : kind_m(kind), state_m(state) { }
+
+		// Parámetros de la transición, según el tipo (Sin constructores, para que las directas no tengan costo)
+		union Parameters {
+			Parameters() { }
+
+			std::chrono::steady_clock::duration duration; // waitFor
+			std::chrono::steady_clock::time_point timestamp; // waitUntil, yield con plazo
+
+			struct {
+				std::chrono::steady_clock::duration duration;
+				std::chrono::steady_clock::duration deadline;
+			} timer; // waitFor con plazo
+
+			struct {
+				int fd;
+				void *buffer;
+				size_t length;
+				off_t offset;
+			} read; // asyncRead
+
+			struct {
+				int fd;
+				uint32_t events;
+				std::chrono::steady_clock::duration timeout;
+			} wait; // waitAny
+
+			Cont cont; // exit
+		};
+
+		Kind kind_m;
+		State state_m;
+		Parameters parameters_m;
+	};
+
+	/**
+	 * @post Crea la máquina de estados de la máquina especificada
+	 */
+	CPSStateMachine(Machine *machine) : machine_m(machine), state_m(), result_m(0) { }
+
+	CPSStateMachine(const CPSStateMachine&) = delete;
+	CPSStateMachine& operator=(const CPSStateMachine&) = delete;
+
+	/**
+	 * @post Devuelve la continuación que empieza la máquina
+	         en el estado especificado
+	 */
+	Cont start(State state) {
+		this->state_m = state;
+
+		return Cont(CPSStateMachine::resume, this);
+	}
+
+	/**
+	 * @post Devuelve el resultado de la última transición que lo tiene
+	         (Bytes leídos o -errno en asyncRead, eventos o cero en waitAny)
+	 */
+	ssize_t getResult() const {
+		return this->result_m;
+	}
+
+	/**
+	 * @post Sigue con el estado especificado, sin pasar por el scheduler
+	 */
+	static Transition go(State state) {
+		return Transition(Transition::Kind::go, state);
+	}
+
+	/**
+	 * @post Cede el CPU y sigue con el estado especificado (CPSSched::yield)
+	 */
+	static Transition yield(State state) {
+		return Transition(Transition::Kind::yield, state);
+	}
+
+	/**
+	 * @post Cede el CPU y sigue con el estado especificado con el
+	         plazo especificado (CPSSched::yield con plazo)
+	 */
+	static Transition yield(std::chrono::steady_clock::time_point deadline, State state) {
+		Transition transition(Transition::Kind::yieldWithDeadline, state);
+		transition.parameters_m.timestamp = deadline;
+
+		return transition;
+	}
+
+	/**
+	 * @post Espera la cantidad de tiempo especificada y sigue con el
+	         estado especificado (CPSSched::waitFor)
+	 */
+	static Transition waitFor(std::chrono::steady_clock::duration duration, State state) {
+		Transition transition(Transition::Kind::waitFor, state);
+		transition.parameters_m.duration = duration;
+
+		return transition;
+	}
+
+	/**
+	 * @post Espera la cantidad de tiempo especificada y sigue con el
+	         estado especificado con plazo hasta el tiempo especificado
+			 desde ahora (CPSSched::waitFor con plazo)
+	 */
+	static Transition waitFor(std::chrono::steady_clock::duration duration, std::chrono::steady_clock::duration deadline, State state) {
+		Transition transition(Transition::Kind::waitForWithDeadline, state);
+		transition.parameters_m.timer.duration = duration;
+		transition.parameters_m.timer.deadline = deadline;
+
+		return transition;
+	}
+
+	/**
+	 * @post Espera hasta el instante especificado y sigue con el
+	         estado especificado (CPSSched::waitUntil)
+	 */
+	static Transition waitUntil(std::chrono::steady_clock::time_point timestamp, State state) {
+		Transition transition(Transition::Kind::waitUntil, state);
+		transition.parameters_m.timestamp = timestamp;
+
+		return transition;
+	}
+
+	/**
+	 * @post Lee asincrónicamente y sigue con el estado especificado,
+	         con el resultado en getResult() (CPSSched::asyncRead)
+	 */
+	static Transition asyncRead(int fd, void *buffer, size_t length, off_t offset, State state) {
+		Transition transition(Transition::Kind::asyncRead, state);
+		transition.parameters_m.read.fd = fd;
+		transition.parameters_m.read.buffer = buffer;
+		transition.parameters_m.read.length = length;
+		transition.parameters_m.read.offset = offset;
+
+		return transition;
+	}
+
+	/**
+	 * @post Espera eventos del descriptor de archivo con tiempo máximo
+	         y sigue con el estado especificado, con los eventos (O cero)
+			 en getResult() (CPSSched::waitAny)
+	 */
+	static Transition waitAny(int fd, uint32_t events, std::chrono::steady_clock::duration timeout, State state) {
+		Transition transition(Transition::Kind::waitAny, state);
+		transition.parameters_m.wait.fd = fd;
+		transition.parameters_m.wait.events = events;
+		transition.parameters_m.wait.timeout = timeout;
+
+		return transition;
+	}
+
+	/**
+	 * @post Termina la máquina y sigue con la continuación especificada
+	 */
+	static Transition exit(Cont cont) {
+		Transition transition(Transition::Kind::exit, State());
+		transition.parameters_m.cont = cont;
+
+		return transition;
+	}
+
+private:
+	/**
+	 * @post Ejecuta estados hasta que haya que pasar por el scheduler
+	 */
+	Cont dispatch() {
+		Transition transition(Transition::Kind::go, this->state_m);
+
+		// El estado se mantiene en una variable local mientras las transiciones sean directas
+		do {
+			transition = this->machine_m->step(transition.state_m);
+		} while (transition.kind_m == Transition::Kind::go);
+
+		this->state_m = transition.state_m;
+
+		const typename Transition::Parameters& parameters = transition.parameters_m;
+
+		switch (transition.kind_m) {
+		case Transition::Kind::yield:
+			return CPSSched::yield(Cont(CPSStateMachine::resume, this));
+		case Transition::Kind::yieldWithDeadline:
+			return CPSSched::yield(parameters.timestamp, Cont(CPSStateMachine::resume, this));
+		case Transition::Kind::waitFor:
+			return CPSSched::waitFor(parameters.duration, Cont(CPSStateMachine::resume, this));
+		case Transition::Kind::waitForWithDeadline:
+			return CPSSched::waitFor(parameters.timer.duration, parameters.timer.deadline, Cont(CPSStateMachine::resume, this));
+		case Transition::Kind::waitUntil:
+			return CPSSched::waitUntil(parameters.timestamp, Cont(CPSStateMachine::resume, this));
+		case Transition::Kind::asyncRead:
+			return CPSSched::asyncRead(parameters.read.fd, parameters.read.buffer, parameters.read.length, parameters.read.offset, PCont<ssize_t>(CPSStateMachine::complete, this));
+		case Transition::Kind::waitAny:
+			return CPSSched::waitAny(parameters.wait.fd, parameters.wait.events, parameters.wait.timeout, PCont<uint32_t>(CPSStateMachine::completeEvents, this));
+		default:
+			return parameters.cont;
+		}
+	}
+
+	/**
+	 * @post Reanuda la máquina
+	 */
+	static Cont resume(CPSStateMachine *stateMachine) {
+		return stateMachine->dispatch();
+	}
+
+	/**
+	 * @post Reanuda la máquina con el resultado de la lectura asíncrona
+	 */
+	static Cont complete(CPSStateMachine *stateMachine, ssize_t result) {
+		stateMachine->result_m = result;
+
+		// Sin E/S asíncrona se completa dentro de la transición, reanudar desde el loop de CPS para no anidar
+		return Cont(CPSStateMachine::resume, stateMachine);
+	}
+
+	/**
+	 * @post Reanuda la máquina con los eventos ocurridos
+	 */
+	static Cont completeEvents(CPSStateMachine *stateMachine, uint32_t events) {
+		stateMachine->result_m = (ssize_t)events;
+
+		return Cont(CPSStateMachine::resume, stateMachine);
+	}
+
+	Machine * const machine_m;
+
+	State state_m;
+	ssize_t result_m;
+};
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSTask.h"
+#include "CPSSched.h"
+
+// Continuación con la que sigue el loop de CPS al suspenderse la corrutina que se está ejecutando
+thread_local Cont coroutineNext;
+
+void CPSCoroutine::setNext(Cont cont) {
+	coroutineNext = cont;
+}
+
+void * CPSCoroutine::allocateFrame(size_t size) {
+	return CPSSched::getInstance()->frameArena_m.allocate(size);
+}
+
+void CPSCoroutine::deallocateFrame(void *frame, size_t size) {
+	CPSSched::getInstance()->frameArena_m.deallocate(frame, size);
+}
+
+Cont CPSCoroutine::resume(void *address) {
+	// Si la corrutina se suspende sin dejar continuación es un error
+	coroutineNext = Cont();
+
+	std::coroutine_handle<>::from_address(address).resume();
+
+	return coroutineNext;
+}
+
+void CPSCoroutine::WaitFor::await_suspend(std::coroutine_handle<> handle) {
+	CPSCoroutine::setNext(CPSSched::waitFor(this->duration_m, CPSCoroutine::resumeCont(handle)));
+}
+
+void CPSCoroutine::WaitUntil::await_suspend(std::coroutine_handle<> handle) {
+	CPSCoroutine::setNext(CPSSched::waitUntil(this->timestamp_m, CPSCoroutine::resumeCont(handle)));
+}
+
+void CPSCoroutine::Yield::await_suspend(std::coroutine_handle<> handle) {
+	CPSCoroutine::setNext(CPSSched::yield(CPSCoroutine::resumeCont(handle)));
+}
+
+void CPSCoroutine::AsyncIO::await_suspend(std::coroutine_handle<> handle) {
+	this->handle_m = handle;
+
+	/*
+	 * Si la operación se hace de forma síncrona la continuación de
+	 * finalización se invoca acá mismo, y devuelve la que reanuda la corrutina
+	 */
+	if (this->write_m) {
+		CPSCoroutine::setNext(CPSSched::asyncWrite(this->fd_m, this->buffer_m, this->length_m, this->offset_m, PCont<ssize_t>(CPSCoroutine::AsyncIO::complete, this)));
+	}
+	else {
+		CPSCoroutine::setNext(CPSSched::asyncRead(this->fd_m, this->buffer_m, this->length_m, this->offset_m, PCont<ssize_t>(CPSCoroutine::AsyncIO::complete, this)));
+	}
+}
+
+Cont CPSCoroutine::AsyncIO::complete(CPSCoroutine::AsyncIO *awaiter, ssize_t result) {
+	awaiter->result_m = result;
+
+	return CPSCoroutine::resumeCont(awaiter->handle_m);
+}
+
+void CPSCoroutine::WaitForFd::await_suspend(std::coroutine_handle<> handle) {
+	this->handle_m = handle;
+
+	if (this->hasTimeout_m) {
+		CPSCoroutine::setNext(CPSSched::waitAny(this->fd_m, this->events_m, this->timeout_m, PCont<uint32_t>(CPSCoroutine::WaitForFd::complete, this)));
+	}
+	else {
+		CPSCoroutine::setNext(CPSSched::waitForFd(this->fd_m, this->events_m, PCont<uint32_t>(CPSCoroutine::WaitForFd::complete, this)));
+	}
+}
+
+Cont CPSCoroutine::WaitForFd::complete(CPSCoroutine::WaitForFd *awaiter, uint32_t events) {
+	awaiter->result_m = events;
+
+	return CPSCoroutine::resumeCont(awaiter->handle_m);
+}
\ No newline at end of file
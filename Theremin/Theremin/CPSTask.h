@@ -0,0 +1,421 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+
+#include <coroutine>
+#include <exception>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/optional.hpp>
+
+#include <sys/types.h>
+
+/*
+ * Corrutinas (C++20) sobre el scheduler de continuaciones.
+ *
+ * Una corrutina que devuelve CPSTask<T> puede esperar con co_await lo
+ * mismo que las continuaciones (CPSSched::waitFor, yield, asyncRead...),
+ * y otras corrutinas. Se ejecuta en el mismo scheduler: cada vez que se
+ * suspende deja encolada (O devuelve) la continuación que la reanuda,
+ * y el loop de CPS sigue con lo que corresponda.
+ *
+ * Los frames se reservan en la arena del scheduler del thread, con lo
+ * cual una corrutina tiene que terminar en el mismo scheduler en el que
+ * se creó (En un conjunto de workers usar 'forkOn')
+ */
+class CPSCoroutine final
+{
+public:
+	/**
+	 * @post Devuelve la continuación que reanuda la corrutina especificada
+	 */
+	static Cont resumeCont(std::coroutine_handle<> handle) {
+		return Cont(CPSCoroutine::resume, handle.address());
+	}
+
+	/**
+	 * @post Especifica la continuación con la que sigue el loop de CPS
+	         cuando se suspende la corrutina que se está ejecutando
+	 */
+	static void setNext(Cont cont);
+
+	/**
+	 * @post Reserva un frame en la arena del scheduler del thread
+	 */
+	static void * allocateFrame(size_t size);
+
+	/**
+	 * @post Libera un frame en la arena del scheduler del thread
+	 */
+	static void deallocateFrame(void *frame, size_t size);
+
+	// Espera de tiempo relativo (CPSSched::waitFor)
+	class WaitFor final {
+	public:
+		WaitFor(std::chrono::steady_clock::duration duration) : duration_m(duration) { }
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept { }
+
+	private:
+		std::chrono::steady_clock::duration duration_m;
+	};
+
+	// Espera de tiempo absoluto (CPSSched::waitUntil)
+	class WaitUntil final {
+	public:
+		WaitUntil(std::chrono::steady_clock::time_point timestamp) : timestamp_m(timestamp) { }
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept { }
+
+	private:
+		std::chrono::steady_clock::time_point timestamp_m;
+	};
+
+	// Cesión del CPU (CPSSched::yield)
+	class Yield final {
+	public:
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept { }
+	};
+
+	// Lectura o escritura asíncrona (CPSSched::asyncRead, CPSSched::asyncWrite)
+	class AsyncIO final {
+	public:
+		AsyncIO(bool write, int fd, void *buffer, size_t length, off_t offset) :
+			write_m(write), fd_m(fd), buffer_m(buffer), length_m(length), offset_m(offset), result_m(0) { }
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		ssize_t await_resume() const noexcept { return this->result_m; }
+
+	private:
+		static Cont complete(AsyncIO *awaiter, ssize_t result);
+
+		bool write_m;
+		int fd_m;
+		void *buffer_m;
+		size_t length_m;
+		off_t offset_m;
+
+		std::coroutine_handle<> handle_m;
+		ssize_t result_m;
+	};
+
+	// Espera de eventos de un descriptor de archivo (CPSSched::waitForFd, CPSSched::waitAny)
+	class WaitForFd final {
+	public:
+		WaitForFd(int fd, uint32_t events) : fd_m(fd), events_m(events), hasTimeout_m(false), result_m(0) { }
+		WaitForFd(int fd, uint32_t events, std::chrono::steady_clock::duration timeout) : fd_m(fd), events_m(events), hasTimeout_m(true), timeout_m(timeout), result_m(0) { }
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		uint32_t await_resume() const noexcept { return this->result_m; }
+
+	private:
+		static Cont complete(WaitForFd *awaiter, uint32_t events);
+
+		int fd_m;
+		uint32_t events_m;
+		bool hasTimeout_m; // Si tiene tiempo máximo (CPSSched::waitAny)
+		std::chrono::steady_clock::duration timeout_m;
+
+		std::coroutine_handle<> handle_m;
+		uint32_t result_m;
+	};
+
+private:
+	/**
+	 * @post Reanuda la corrutina especificada hasta que se suspenda,
+	         y sigue con la continuación que dejó
+	 */
+	static Cont resume(void *address);
+};
+
+/*
+ * Excepción con la que terminó una corrutina.
+ *
+ * Se guarda en lugar de dejarla salir de la corrutina, para
+ * relanzarla después de liberar su frame
+ */
+class CPSTaskException
+{
+public:
+	void unhandled_exception() {
+		this->exception_m = std::current_exception();
+	}
+
+	/**
+	 * @post Devuelve la excepción con la que terminó, si hay,
+	         y la quita
+	 */
+	std::exception_ptr takeException() {
+		std::exception_ptr exception = this->exception_m;
+		this->exception_m = nullptr;
+
+		return exception;
+	}
+
+private:
+	std::exception_ptr exception_m;
+};
+
+/*
+ * Resultado de una corrutina, y continuación de CPS con la que sigue
+ * al terminar si se la empezó desde una continuación
+ */
+template<typename T>
+class CPSTaskResult : public CPSTaskException
+{
+public:
+	typedef PCont<T> Continuation;
+
+	void return_value(T value) {
+		this->value_m = std::move(value);
+	}
+
+	T takeValue() {
+		return std::move(*this->value_m);
+	}
+
+	void setContinuation(Continuation continuation) {
+		this->continuation_m = continuation;
+	}
+
+	/**
+	 * @post Libera el frame de la corrutina especificada, y devuelve
+	         la continuación de CPS con el resultado.
+			 Si terminó con una excepción la relanza hacia el loop de CPS
+	 */
+	template<typename Promise>
+	static Cont finish(std::coroutine_handle<Promise> handle) {
+		CPSTaskResult& result = handle.promise();
+
+		std::exception_ptr exception = result.takeException();
+
+		if (exception) {
+			handle.destroy();
+
+			std::rethrow_exception(exception);
+		}
+
+		Continuation continuation = result.continuation_m;
+		T value = result.takeValue();
+
+		handle.destroy();
+
+		return continuation.invoke(std::move(value));
+	}
+
+private:
+	boost::optional<T> value_m;
+	Continuation continuation_m;
+};
+
+template<>
+class CPSTaskResult<void> : public CPSTaskException
+{
+public:
+	typedef Cont Continuation;
+
+	void return_void() {
+
+	}
+
+	void takeValue() {
+
+	}
+
+	void setContinuation(Continuation continuation) {
+		this->continuation_m = continuation;
+	}
+
+	template<typename Promise>
+	static Cont finish(std::coroutine_handle<Promise> handle) {
+		CPSTaskResult& result = handle.promise();
+
+		std::exception_ptr exception = result.takeException();
+
+		if (exception) {
+			handle.destroy();
+
+			std::rethrow_exception(exception);
+		}
+
+		Continuation continuation = result.continuation_m;
+
+		handle.destroy();
+
+		return continuation;
+	}
+
+private:
+	Continuation continuation_m;
+};
+
+/*
+ * Corrutina con resultado de tipo T.
+ *
+ * Empieza suspendida, y se ejecuta cuando la espera otra corrutina
+ * (co_await) o cuando se la empieza desde una continuación ('start')
+ */
+template<typename T>
+class CPSTask final
+{
+public:
+	class promise_type;
+
+	// Suspensión final
+	class FinalAwaiter final {
+	public:
+		bool await_ready() const noexcept { return false; }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+			std::coroutine_handle<> awaiting = handle.promise().awaiting_m;
+
+			// Si la espera otra corrutina pasarle el control directamente
+			if (awaiting) {
+				return awaiting;
+			}
+			else {
+				// Caso contrario seguir en CPS, fuera de la corrutina
+				CPSCoroutine::setNext(Cont(CPSTask::finish, handle.address()));
+
+				return std::noop_coroutine();
+			}
+		}
+
+		void await_resume() const noexcept { }
+	};
+
+	class promise_type final : public CPSTaskResult<T> {
+	public:
+		CPSTask get_return_object() {
+			return CPSTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept {
+			return std::suspend_always();
+		}
+
+		FinalAwaiter final_suspend() const noexcept {
+			return FinalAwaiter();
+		}
+
+		/*
+		 * Las excepciones se guardan (CPSTaskException) y se relanzan al
+		 * terminar, después de liberar el frame: hacia la corrutina que
+		 * espera el resultado, o hacia el loop de CPS como en las continuaciones
+		 */
+
+		static void * operator new(size_t size) {
+			return CPSCoroutine::allocateFrame(size);
+		}
+
+		static void operator delete(void *frame, size_t size) {
+			CPSCoroutine::deallocateFrame(frame, size);
+		}
+
+		std::coroutine_handle<> awaiting_m; // Corrutina que espera el resultado (Opcional)
+	};
+
+	CPSTask(CPSTask&& other) noexcept : handle_m(other.handle_m) {
+		other.handle_m = nullptr;
+	}
+
+	CPSTask(const CPSTask&) = delete;
+	CPSTask& operator=(const CPSTask&) = delete;
+
+	/**
+	 * @post Destruye la corrutina, si no se la empezó desde una continuación
+	 */
+	~CPSTask() {
+		if (this->handle_m) {
+			this->handle_m.destroy();
+		}
+	}
+
+	/**
+	 * @post Empieza la corrutina desde una continuación, que sigue
+	         con la continuación especificada cuando termina
+	 */
+	Cont start(typename CPSTaskResult<T>::Continuation continuation) {
+		std::coroutine_handle<promise_type> handle = this->handle_m;
+		this->handle_m = nullptr;
+
+		handle.promise().setContinuation(continuation);
+
+		return CPSCoroutine::resumeCont(handle);
+	}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	// Empieza la corrutina, y la reanuda al terminar
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+		this->handle_m.promise().awaiting_m = awaiting;
+
+		return this->handle_m;
+	}
+
+	T await_resume() {
+		std::exception_ptr exception = this->handle_m.promise().takeException();
+
+		if (exception) {
+			this->handle_m.destroy();
+			this->handle_m = nullptr;
+
+			std::rethrow_exception(exception);
+		}
+
+		return this->handle_m.promise().takeValue();
+	}
+
+private:
+	explicit CPSTask(std::coroutine_handle<promise_type> handle) : handle_m(handle) { }
+
+	static Cont finish(void *address) {
+		return CPSTaskResult<T>::finish(std::coroutine_handle<promise_type>::from_address(address));
+	}
+
+	std::coroutine_handle<promise_type> handle_m;
+};
@@ -0,0 +1,483 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSTimingWheel.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+CPSTimingWheel::CPSTimingWheel()
+{
+	for (Level& level : this->levels_m) {
+		for (List& slot : level.slots) {
+			CPSTimingWheel::clear(slot);
+		}
+
+		std::memset(level.nonEmptySlots, 0, sizeof(level.nonEmptySlots));
+	}
+
+	CPSTimingWheel::clear(this->overflow_m);
+
+	this->firstFreeNode_m = nullNode;
+	this->currentTick_m = 0;
+	this->size_m = 0;
+
+	this->lastOversleep_m = std::chrono::steady_clock::duration::zero();
+	this->instrumentation_m = nullptr;
+	this->clock_m = &Clock::getSteady();
+}
+
+bool CPSTimingWheel::empty() const {
+	return (this->size_m == 0);
+}
+
+size_t CPSTimingWheel::size() const {
+	return this->size_m;
+}
+
+CPSTimer CPSTimingWheel::add(std::chrono::steady_clock::time_point timestamp, Cont cont) {
+	return this->addNode(timestamp, false, std::chrono::steady_clock::time_point(), cont);
+}
+
+CPSTimer CPSTimingWheel::add(std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point deadline, Cont cont) {
+	return this->addNode(timestamp, true, deadline, cont);
+}
+
+CPSTimer CPSTimingWheel::addNode(std::chrono::steady_clock::time_point timestamp, bool hasDeadline, std::chrono::steady_clock::time_point deadline, Cont cont) {
+	uint32_t nodeIndex;
+
+	// Reusar un nodo libre, o crear uno nuevo si no hay
+	if (this->firstFreeNode_m != nullNode) {
+		nodeIndex = this->firstFreeNode_m;
+		this->firstFreeNode_m = this->nodes_m[nodeIndex].next;
+	}
+	else {
+		if (this->nodes_m.size() == nullNode) {
+			throw std::runtime_error("Too many waiting continuations");
+		}
+
+		nodeIndex = (uint32_t) this->nodes_m.size();
+		this->nodes_m.emplace_back();
+
+		this->nodes_m[nodeIndex].wheel = this;
+		this->nodes_m[nodeIndex].index = nodeIndex;
+		this->nodes_m[nodeIndex].generation = 0;
+	}
+
+	Node& node = this->nodes_m[nodeIndex];
+	node.tick = std::max(toTick(timestamp), this->currentTick_m);
+	node.timestamp = timestamp;
+	node.cont = cont;
+	node.hasDeadline = hasDeadline;
+	node.deadline = deadline;
+	node.cancelled = false;
+
+	this->place(nodeIndex);
+
+	this->size_m++;
+
+	return CPSTimer(nodeIndex, node.generation);
+}
+
+bool CPSTimingWheel::cancel(CPSTimer timer) {
+	if (timer.index_m >= this->nodes_m.size()) {
+		return false;
+	}
+
+	Node& node = this->nodes_m[timer.index_m];
+
+	// Si el nodo se liberó (Y quizás se reusó) ya se ejecutó o se canceló
+	if ((node.generation != timer.generation_m) || node.cancelled) {
+		return false;
+	}
+
+	if (node.list != nullptr) {
+		this->unlink(node.index);
+		this->size_m--;
+
+		this->release(node);
+	}
+	else {
+		// Ya se encoló para ejecutarse, el nodo se libera al ejecutarse
+		node.cancelled = true;
+	}
+
+	return true;
+}
+
+void CPSTimingWheel::setCancelledContinuation(Cont cont) {
+	this->cancelledCont_m = cont;
+}
+
+std::chrono::steady_clock::time_point CPSTimingWheel::nextTimestamp() const {
+	if (this->size_m == 0) {
+		throw std::runtime_error("No waiting continuations");
+	}
+
+	uint64_t tick = UINT64_MAX;
+
+	/*
+	 * Dentro de un nivel las ranuras están ordenadas circularmente a partir
+	 * de la actual, pero un nodo ubicado hace tiempo en un nivel superior puede
+	 * ser anterior a los de los niveles inferiores. Se toma el mínimo de la primer
+	 * ranura con nodos de cada nivel, salteando las que empiezan después
+	 */
+	for (unsigned int i = 0; i < numberOfLevels; i++) {
+		const unsigned int shift = slotBits * i;
+		const uint64_t currentSlot = this->currentTick_m >> shift;
+
+		const uint32_t slotIndex = this->findNonEmptySlot(this->levels_m[i], (uint32_t)(currentSlot & slotMask));
+
+		if (slotIndex != numberOfSlots) {
+			const uint64_t slotTick = (currentSlot + ((slotIndex - currentSlot) & slotMask)) << shift;
+
+			if (i == 0) {
+				// En el primer nivel todos los nodos de una ranura tienen el mismo tick
+				tick = slotTick;
+			}
+			else if (slotTick < tick) {
+				tick = std::min(tick, this->minimumTick(this->levels_m[i].slots[slotIndex]));
+			}
+		}
+	}
+
+	// La lista aparte se redistribuye al dar la vuelta el último nivel, con lo cual empieza después
+	const unsigned int overflowShift = slotBits * numberOfLevels;
+
+	if ((((this->currentTick_m >> overflowShift) + 1) << overflowShift) < tick) {
+		tick = std::min(tick, this->minimumTick(this->overflow_m));
+	}
+
+	return std::chrono::steady_clock::time_point(
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(tick))
+	);
+}
+
+void CPSTimingWheel::advance(std::chrono::steady_clock::time_point currentTimestamp, CPSRunQueue& continuationsToExecute, CPSDeadlineQueue& deadlineContinuations) {
+	const uint64_t targetTick = (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(currentTimestamp.time_since_epoch()).count();
+
+	while (this->currentTick_m <= targetTick) {
+		// Si no hay nada en espera saltar directamente
+		if (this->size_m == 0) {
+			this->currentTick_m = targetTick + 1;
+			break;
+		}
+
+		Level& firstLevel = this->levels_m[0];
+		const uint32_t slotIndex = (uint32_t)(this->currentTick_m & slotMask);
+		List& slot = firstLevel.slots[slotIndex];
+
+		/*
+		 * Encolar las continuaciones de la ranura actual (Los nodos se liberan al ejecutarse).
+		 * Si se llena la cola que le corresponde a una, dejarla junto con las
+		 * siguientes en la ranura, sin avanzar, para encolarlas en el próximo avance
+		 */
+		while (slot.head != nullNode) {
+			Node& node = this->nodes_m[slot.head];
+
+			if (node.hasDeadline) {
+				if (deadlineContinuations.size() == deadlineContinuations.capacity()) {
+					return;
+				}
+
+				this->unlink(node.index);
+				deadlineContinuations.push(node.deadline, Cont(CPSTimingWheel::expire, &node));
+			}
+			else {
+				if (continuationsToExecute.size() == continuationsToExecute.capacity()) {
+					return;
+				}
+
+				this->unlink(node.index);
+				continuationsToExecute.push(Cont(CPSTimingWheel::expire, &node));
+			}
+
+			this->size_m--;
+		}
+
+		/*
+		 * Saltar a la próxima ranura con nodos del primer nivel, sin pasarse
+		 * del principio de la próxima ranura del segundo nivel.
+		 * Si el primer nivel está vacío saltar directamente a la próxima
+		 * ranura con nodos de los niveles superiores
+		 */
+		const uint64_t nextBlockTick = (this->currentTick_m | slotMask) + 1;
+		uint64_t nextTick;
+
+		const uint32_t nextSlotIndex = this->findNonEmptySlot(firstLevel, (slotIndex + 1) & slotMask);
+
+		if (nextSlotIndex != numberOfSlots) {
+			nextTick = std::min(nextBlockTick, this->currentTick_m + 1 + ((nextSlotIndex - slotIndex - 1) & slotMask));
+		}
+		else {
+			nextTick = this->nextCascadeTick();
+		}
+
+		this->currentTick_m = std::min(nextTick, targetTick + 1);
+
+		if ((this->currentTick_m & slotMask) == 0) {
+			this->cascade();
+		}
+	}
+}
+
+std::chrono::steady_clock::duration CPSTimingWheel::getLastOversleep() const {
+	return this->lastOversleep_m;
+}
+
+void CPSTimingWheel::setInstrumentation(CPSInstrumentation *instrumentation) {
+	this->instrumentation_m = instrumentation;
+}
+
+void CPSTimingWheel::setClock(Clock& clock) {
+	this->clock_m = &clock;
+}
+
+void CPSTimingWheel::place(uint32_t nodeIndex) {
+	Node& node = this->nodes_m[nodeIndex];
+
+	for (unsigned int i = 0; i < numberOfLevels; i++) {
+		const unsigned int shift = slotBits * i;
+
+		if ((node.tick >> shift) - (this->currentTick_m >> shift) < numberOfSlots) {
+			Level& level = this->levels_m[i];
+			const uint32_t slotIndex = (uint32_t)((node.tick >> shift) & slotMask);
+
+			this->append(level.slots[slotIndex], nodeIndex);
+			level.nonEmptySlots[slotIndex / 64] |= (uint64_t)1 << (slotIndex % 64);
+
+			return;
+		}
+	}
+
+	this->append(this->overflow_m, nodeIndex);
+}
+
+void CPSTimingWheel::append(List& list, uint32_t nodeIndex) {
+	Node& node = this->nodes_m[nodeIndex];
+
+	node.next = nullNode;
+	node.previous = list.tail;
+	node.list = &list;
+
+	if (list.tail != nullNode) {
+		this->nodes_m[list.tail].next = nodeIndex;
+	}
+	else {
+		list.head = nodeIndex;
+	}
+
+	list.tail = nodeIndex;
+
+	list.minimumTick = std::min(list.minimumTick, node.tick);
+}
+
+void CPSTimingWheel::unlink(uint32_t nodeIndex) {
+	Node& node = this->nodes_m[nodeIndex];
+	List& list = *node.list;
+
+	if (node.previous != nullNode) {
+		this->nodes_m[node.previous].next = node.next;
+	}
+	else {
+		list.head = node.next;
+	}
+
+	if (node.next != nullNode) {
+		this->nodes_m[node.next].previous = node.previous;
+	}
+	else {
+		list.tail = node.previous;
+	}
+
+	node.list = nullptr;
+
+	if (list.head == nullNode) {
+		CPSTimingWheel::clear(list);
+	}
+	else if (node.tick == list.minimumTick) {
+		list.isMinimumTickValid = false;
+	}
+
+	// Si la ranura quedó vacía quitarla del mapa de bits de su nivel
+	if (list.head == nullNode) {
+		for (Level& level : this->levels_m) {
+			if ((&list >= level.slots) && (&list < level.slots + numberOfSlots)) {
+				const uint32_t slotIndex = (uint32_t)(&list - level.slots);
+
+				level.nonEmptySlots[slotIndex / 64] &= ~((uint64_t)1 << (slotIndex % 64));
+
+				break;
+			}
+		}
+	}
+}
+
+void CPSTimingWheel::release(Node& node) {
+	node.generation++;
+	node.cancelled = false;
+
+	node.next = this->firstFreeNode_m;
+	this->firstFreeNode_m = node.index;
+}
+
+void CPSTimingWheel::cascade() {
+	// Empezando desde el nivel más alto, para que los nodos bajen hasta el primero
+	if ((this->currentTick_m & (((uint64_t)1 << (slotBits * numberOfLevels)) - 1)) == 0) {
+		this->replace(this->overflow_m);
+	}
+
+	for (unsigned int i = numberOfLevels - 1; i > 0; i--) {
+		const unsigned int shift = slotBits * i;
+
+		if ((this->currentTick_m & (((uint64_t)1 << shift) - 1)) == 0) {
+			Level& level = this->levels_m[i];
+			const uint32_t slotIndex = (uint32_t)((this->currentTick_m >> shift) & slotMask);
+
+			level.nonEmptySlots[slotIndex / 64] &= ~((uint64_t)1 << (slotIndex % 64));
+			this->replace(level.slots[slotIndex]);
+		}
+	}
+}
+
+uint64_t CPSTimingWheel::nextCascadeTick() const {
+	uint64_t tick = UINT64_MAX;
+
+	for (unsigned int i = 1; i < numberOfLevels; i++) {
+		const unsigned int shift = slotBits * i;
+		const uint64_t currentSlot = this->currentTick_m >> shift;
+
+		const uint32_t slotIndex = this->findNonEmptySlot(this->levels_m[i], (uint32_t)(currentSlot & slotMask));
+
+		if (slotIndex != numberOfSlots) {
+			tick = std::min(tick, (currentSlot + ((slotIndex - currentSlot) & slotMask)) << shift);
+		}
+	}
+
+	if (this->overflow_m.head != nullNode) {
+		const unsigned int overflowShift = slotBits * numberOfLevels;
+
+		tick = std::min(tick, ((this->currentTick_m >> overflowShift) + 1) << overflowShift);
+	}
+
+	return tick;
+}
+
+void CPSTimingWheel::replace(List& list) {
+	uint32_t nodeIndex = list.head;
+
+	CPSTimingWheel::clear(list);
+
+	while (nodeIndex != nullNode) {
+		const uint32_t nextNodeIndex = this->nodes_m[nodeIndex].next;
+
+		this->place(nodeIndex);
+
+		nodeIndex = nextNodeIndex;
+	}
+}
+
+uint32_t CPSTimingWheel::findNonEmptySlot(const Level& level, uint32_t fromIndex) const {
+	const uint32_t numberOfWords = numberOfSlots / 64;
+
+	// Primera palabra, sin los bits anteriores al índice
+	uint32_t wordIndex = fromIndex / 64;
+	uint64_t word = level.nonEmptySlots[wordIndex] & (UINT64_MAX << (fromIndex % 64));
+
+	for (uint32_t i = 0; i <= numberOfWords; i++) {
+		if (word != 0) {
+			return wordIndex * 64 + (uint32_t)__builtin_ctzll(word);
+		}
+
+		wordIndex = (wordIndex + 1) % numberOfWords;
+		word = level.nonEmptySlots[wordIndex];
+
+		// Al volver a la primera palabra sólo quedan los bits anteriores al índice
+		if (i == numberOfWords - 1) {
+			word &= ~(UINT64_MAX << (fromIndex % 64));
+		}
+	}
+
+	return numberOfSlots;
+}
+
+void CPSTimingWheel::clear(List& list) {
+	list.head = nullNode;
+	list.tail = nullNode;
+	list.minimumTick = UINT64_MAX;
+	list.isMinimumTickValid = true;
+}
+
+uint64_t CPSTimingWheel::minimumTick(const List& list) const {
+	if (!list.isMinimumTickValid) {
+		uint64_t tick = UINT64_MAX;
+
+		for (uint32_t nodeIndex = list.head; nodeIndex != nullNode; nodeIndex = this->nodes_m[nodeIndex].next) {
+			tick = std::min(tick, this->nodes_m[nodeIndex].tick);
+		}
+
+		list.minimumTick = tick;
+		list.isMinimumTickValid = true;
+	}
+
+	return list.minimumTick;
+}
+
+Cont CPSTimingWheel::expire(Node *node) {
+	CPSTimingWheel *wheel = node->wheel;
+
+	// Si se canceló después de encolarse seguir con la continuación de cancelación
+	if (node->cancelled) {
+		wheel->release(*node);
+
+		return wheel->cancelledCont_m;
+	}
+
+	wheel->lastOversleep_m = wheel->clock_m->now() - node->timestamp;
+
+	if (wheel->instrumentation_m != nullptr) {
+		wheel->instrumentation_m->recordTimerLateness(wheel->lastOversleep_m);
+	}
+
+	Cont cont = node->cont;
+
+	wheel->release(*node);
+
+	return cont;
+}
+
+uint64_t CPSTimingWheel::toTick(std::chrono::steady_clock::time_point timestamp) {
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+
+	return (uint64_t)((nanoseconds + 999) / 1000);
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSRunQueue.h"
+#include "CPSDeadlineQueue.h"
+#include "CPSInstrumentation.h"
+#include "Clock.h"
+
+#include <chrono>
+#include <deque>
+#include <cstdint>
+
+/*
+ * Referencia a una continuación en espera, para cancelarla.
+ * Deja de ser válida cuando la continuación se ejecuta o se cancela
+ * (Aunque el nodo se reuse)
+ */
+class CPSTimer final
+{
+public:
+	/**
+	 * @post Crea una referencia inválida
+	 */
+	CPSTimer() : index_m(UINT32_MAX), generation_m(0) { }
+
+private:
+	friend class CPSTimingWheel;
+
+	CPSTimer(uint32_t index, uint32_t generation) : index_m(index), generation_m(generation) { }
+
+	uint32_t index_m; // Índice del nodo
+	uint32_t generation_m; // Generación del nodo
+};
+
+/*
+ * Rueda de tiempo jerárquica, para las continuaciones que esperan tiempo.
+ *
+ * Tiene tres niveles de 1024 ranuras cada uno. El primero tiene ranuras
+ * de un microsegundo (Hasta 1 ms), el segundo de 1024 microsegundos (Hasta 1 s),
+ * y el tercero de 1024 * 1024 microsegundos (Hasta 17 minutos).
+ * Las esperas más largas quedan en una lista aparte, que se redistribuye
+ * cada vez que da la vuelta el último nivel.
+ *
+ * Agregar es O(1), y expirar es O(1) por continuación (Las ranuras vacías
+ * se saltean con un mapa de bits por nivel). Al pasar a la siguiente ranura de un nivel superior se
+ * redistribuyen sus continuaciones en los niveles inferiores.
+ * Cada ranura mantiene su menor tick, con lo cual el instante de la
+ * próxima continuación se obtiene sin recorrer las ranuras.
+ *
+ * Los nodos se reusan, con lo cual sólo se reserva memoria al superar
+ * la mayor cantidad de continuaciones en espera que hubo hasta el momento.
+ *
+ * Las listas de las ranuras son doblemente enlazadas, para poder cancelar
+ * una continuación en O(1) quitando su nodo directamente
+ */
+class CPSTimingWheel final
+{
+public:
+	/**
+	 * @post Crea la rueda de tiempo vacía
+	 */
+	CPSTimingWheel();
+
+	/**
+	 * @post Devuelve si no hay continuaciones en espera
+	 */
+	bool empty() const;
+
+	/**
+	 * @post Devuelve la cantidad de continuaciones en espera
+	 */
+	size_t size() const;
+
+	/**
+	 * @post Agrega la continuación especificada, para ejecutarse
+	         a partir del instante especificado, y devuelve la referencia
+			 para cancelarla.
+			 Si el instante ya pasó, se ejecuta en el próximo avance
+	 */
+	CPSTimer add(std::chrono::steady_clock::time_point timestamp, Cont cont);
+
+	/**
+	 * @post Agrega la continuación especificada, para ejecutarse
+	         a partir del instante especificado con el plazo especificado
+			 (Se encola en la cola de continuaciones con plazo), y devuelve
+			 la referencia para cancelarla
+	 */
+	CPSTimer add(std::chrono::steady_clock::time_point timestamp, std::chrono::steady_clock::time_point deadline, Cont cont);
+
+	/**
+	 * @post Cancela la continuación especificada, liberando su nodo.
+	         Si ya se encoló para ejecutarse, en su lugar se ejecuta
+			 la continuación de cancelación.
+			 Devuelve si se canceló (Falso si ya se ejecutó o se canceló)
+	 */
+	bool cancel(CPSTimer timer);
+
+	/**
+	 * @post Especifica la continuación que se ejecuta en lugar de las
+	         canceladas después de encolarse (Típicamente la que sigue
+			 con el scheduler)
+	 */
+	void setCancelledContinuation(Cont cont);
+
+	/**
+	 * @pre No tiene que estar vacía
+	 * @post Devuelve el instante de la próxima continuación a ejecutarse,
+	         redondeado al microsegundo siguiente
+	 */
+	std::chrono::steady_clock::time_point nextTimestamp() const;
+
+	/**
+	 * @post Avanza hasta el instante especificado, encolando
+	         las continuaciones cuyo instante haya llegado
+			 (Las que tienen plazo en la cola de continuaciones con plazo).
+			 Si se llena alguna de las colas se detiene, y las que faltan
+			 se encolan en el próximo avance
+	 */
+	void advance(std::chrono::steady_clock::time_point currentTimestamp, CPSRunQueue& continuationsToExecute, CPSDeadlineQueue& deadlineContinuations);
+
+	/**
+	 * @post Devuelve cuánto después de su instante empezó a ejecutarse
+	         la última continuación expirada
+	 */
+	std::chrono::steady_clock::duration getLastOversleep() const;
+
+	/**
+	 * @post Especifica la instrumentación en la que se registra
+	         el retraso de las continuaciones (Opcional)
+	 */
+	void setInstrumentation(CPSInstrumentation *instrumentation);
+
+	/**
+	 * @post Especifica el reloj con el que se mide el retraso
+	         de las continuaciones (Por defecto steady_clock)
+	 */
+	void setClock(Clock& clock);
+
+private:
+	static const unsigned int numberOfLevels = 3;
+	static const unsigned int slotBits = 10;
+	static const uint32_t numberOfSlots = 1 << slotBits;
+	static const uint32_t slotMask = numberOfSlots - 1;
+	static const uint32_t nullNode = UINT32_MAX;
+
+	/*
+	 * Lista de nodos, con su menor tick. Al cancelar el nodo del menor
+	 * tick se marca como desactualizado, y se recalcula recién al
+	 * consultarlo, con lo cual cancelar sigue siendo O(1)
+	 */
+	struct List {
+		uint32_t head;
+		uint32_t tail;
+		mutable uint64_t minimumTick; // Menor tick de los nodos (UINT64_MAX si está vacía)
+		mutable bool isMinimumTickValid; // Falso si se quitó el nodo del menor tick
+	};
+
+	// Continuación en espera
+	struct Node {
+		CPSTimingWheel *wheel;
+		uint32_t index; // Índice del nodo
+		uint32_t generation; // Se incrementa al liberarse, para invalidar las referencias
+		uint64_t tick; // Instante en microsegundos
+		std::chrono::steady_clock::time_point timestamp; // Instante exacto
+		Cont cont;
+		bool hasDeadline; // Si se encola con plazo al llegar su instante
+		std::chrono::steady_clock::time_point deadline;
+		uint32_t next; // Siguiente nodo de la lista
+		uint32_t previous; // Nodo anterior de la lista
+		List *list; // Lista en la que está (nullptr si ya se encoló para ejecutarse)
+		bool cancelled; // Si se canceló después de encolarse
+	};
+
+	// Nivel de la rueda
+	struct Level {
+		List slots[numberOfSlots];
+		uint64_t nonEmptySlots[numberOfSlots / 64]; // Mapa de bits de las ranuras con nodos
+	};
+
+	/**
+	 * @post Agrega la continuación especificada, con el plazo
+	         especificado si lo tiene
+	 */
+	CPSTimer addNode(std::chrono::steady_clock::time_point timestamp, bool hasDeadline, std::chrono::steady_clock::time_point deadline, Cont cont);
+
+	/**
+	 * @post Ubica el nodo en el nivel que le corresponde,
+	         según el tick actual
+	 */
+	void place(uint32_t nodeIndex);
+
+	/**
+	 * @post Agrega el nodo al final de la lista
+	 */
+	void append(List& list, uint32_t nodeIndex);
+
+	/**
+	 * @post Quita el nodo de su lista, y si la deja vacía
+	         la quita del mapa de bits de su nivel
+	 */
+	void unlink(uint32_t nodeIndex);
+
+	/**
+	 * @post Libera el nodo, invalidando sus referencias
+	 */
+	void release(Node& node);
+
+	/**
+	 * @post Redistribuye las ranuras de los niveles superiores
+	         que empiezan en el tick actual
+	 */
+	void cascade();
+
+	/**
+	 * @post Devuelve el próximo tick en el que hay que redistribuir
+	         nodos de los niveles superiores
+	 */
+	uint64_t nextCascadeTick() const;
+
+	/**
+	 * @post Redistribuye los nodos de la lista, y la vacía
+	 */
+	void replace(List& list);
+
+	/**
+	 * @post Devuelve el índice de la primer ranura con nodos del nivel,
+	         recorriéndolo circularmente a partir del índice especificado,
+			 o numberOfSlots si no hay ninguna
+	 */
+	uint32_t findNonEmptySlot(const Level& level, uint32_t fromIndex) const;
+
+	/**
+	 * @post Vacía la lista
+	 */
+	static void clear(List& list);
+
+	/**
+	 * @post Devuelve el menor tick de la lista, recorriéndola
+	         sólo si se quitó el nodo del menor tick
+	 */
+	uint64_t minimumTick(const List& list) const;
+
+	/**
+	 * @post Mide el retraso de la continuación del nodo
+	         expirado, lo libera y continúa
+	 */
+	static Cont expire(Node *node);
+
+	/**
+	 * @post Convierte el instante especificado en tick,
+	         redondeando hacia arriba
+	 */
+	static uint64_t toTick(std::chrono::steady_clock::time_point timestamp);
+
+	Level levels_m[numberOfLevels];
+	List overflow_m; // Continuaciones más allá del último nivel
+
+	std::deque<Node> nodes_m; // Los nodos no se mueven al agregar, para que las continuaciones de expiración los puedan referenciar
+	uint32_t firstFreeNode_m; // Primer nodo libre
+
+	uint64_t currentTick_m; // Próximo tick a procesar
+	size_t size_m;
+
+	std::chrono::steady_clock::duration lastOversleep_m; // Retraso de la última continuación expirada
+	CPSInstrumentation *instrumentation_m;
+	Clock *clock_m;
+
+	Cont cancelledCont_m; // Continuación que se ejecuta en lugar de las canceladas después de encolarse
+};
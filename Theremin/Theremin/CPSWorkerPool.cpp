@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CPSWorkerPool.h"
+#include "CPSSched.h"
+
+#include <stdexcept>
+#include <thread>
+
+CPSWorkerPool::Worker::Worker(size_t queueCapacity) :
+	stealable_m(queueCapacity),
+	numberOfStealable_m(0),
+	inbox_m(queueCapacity)
+{
+
+}
+
+CPSWorkerPool::CPSWorkerPool(size_t numberOfWorkers, size_t queueCapacity) :
+	queueCapacity_m(queueCapacity),
+	stopping_m(false),
+	numberOfSteals_m(0)
+{
+	if (numberOfWorkers == 0) {
+		throw std::runtime_error("Invalid number of workers");
+	}
+
+	for (size_t i = 0; i < numberOfWorkers; i++) {
+		this->workers_m.emplace_back(new Worker(queueCapacity));
+	}
+}
+
+CPSWorkerPool::~CPSWorkerPool()
+{
+
+}
+
+size_t CPSWorkerPool::getNumberOfWorkers() const {
+	return this->workers_m.size();
+}
+
+void CPSWorkerPool::run(Cont firstContinuation) {
+	std::vector<std::thread> threads;
+
+	this->stopping_m = false;
+
+	for (size_t i = 0; i < this->workers_m.size(); i++) {
+		boost::optional<Cont> workerContinuation;
+
+		if (i == 0) {
+			workerContinuation = firstContinuation;
+		}
+
+		threads.emplace_back(&CPSWorkerPool::runWorker, this, i, workerContinuation);
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+uint64_t CPSWorkerPool::getNumberOfSteals() const {
+	return this->numberOfSteals_m;
+}
+
+void CPSWorkerPool::runWorker(size_t workerIndex, boost::optional<Cont> firstContinuation) {
+	// El scheduler del worker tiene que existir antes de que runCPS cree el suyo
+	CPSSched::createWorker(this, workerIndex, this->queueCapacity_m);
+
+	if (firstContinuation.is_initialized()) {
+		runCPS(*firstContinuation);
+	}
+	else {
+		// Empezar esperando continuaciones
+		runCPS(Cont(CPSSched::executePendingContinuation, CPSSched::getInstance()));
+	}
+
+	// La continuación terminó, terminar los demás workers
+	this->stop();
+
+	CPSSched::destroy();
+}
+
+void CPSWorkerPool::pushStealable(size_t workerIndex, Cont cont) {
+	Worker& worker = *this->workers_m[workerIndex];
+
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex_m);
+
+		worker.stealable_m.push(cont);
+		worker.numberOfStealable_m++;
+	}
+
+	this->notifyWork(workerIndex);
+}
+
+CPSInbox& CPSWorkerPool::getInbox(size_t workerIndex) {
+	return this->workers_m[workerIndex]->inbox_m;
+}
+
+void CPSWorkerPool::pushInbox(size_t workerIndex, Cont cont) {
+	// Despierta al worker si está durmiendo
+	if (!this->workers_m[workerIndex]->inbox_m.post(cont)) {
+		throw std::runtime_error("CPS inbox overflow");
+	}
+}
+
+void CPSWorkerPool::collect(size_t workerIndex, CPSRunQueue& continuationsToExecute) {
+	Worker& worker = *this->workers_m[workerIndex];
+
+	worker.inbox_m.collect(continuationsToExecute);
+
+	// Evitar tomar el lock si no hay nada
+	if (worker.numberOfStealable_m == 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(worker.mutex_m);
+
+	// Tomar de a una las robables, la más reciente, para que las demás las puedan robar los demás workers mientras tanto
+	if (!worker.stealable_m.empty() && (continuationsToExecute.size() < continuationsToExecute.capacity())) {
+		continuationsToExecute.push(worker.stealable_m.back());
+		worker.stealable_m.popBack();
+		worker.numberOfStealable_m--;
+	}
+}
+
+bool CPSWorkerPool::steal(size_t workerIndex, CPSRunQueue& continuationsToExecute) {
+	const size_t numberOfWorkers = this->workers_m.size();
+
+	if (continuationsToExecute.size() == continuationsToExecute.capacity()) {
+		return false;
+	}
+
+	// Empezar por el siguiente worker, para repartir los robos
+	for (size_t i = 1; i < numberOfWorkers; i++) {
+		Worker& victim = *this->workers_m[(workerIndex + i) % numberOfWorkers];
+
+		if (victim.numberOfStealable_m > 0) {
+			bool hasStolen = false;
+
+			{
+				std::lock_guard<std::mutex> lock(victim.mutex_m);
+
+				// Robar la más antigua, por el extremo opuesto al del dueño
+				if (!victim.stealable_m.empty()) {
+					continuationsToExecute.push(victim.stealable_m.front());
+					victim.stealable_m.pop();
+					victim.numberOfStealable_m--;
+
+					hasStolen = true;
+				}
+			}
+
+			if (hasStolen) {
+				this->numberOfSteals_m++;
+
+				// Si quedan más despertar a otro worker, que siga robando
+				if (victim.numberOfStealable_m > 0) {
+					this->notifyWork(workerIndex);
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool CPSWorkerPool::hasWork(size_t workerIndex) const {
+	if (!this->workers_m[workerIndex]->inbox_m.empty()) {
+		return true;
+	}
+
+	for (const std::unique_ptr<Worker>& worker : this->workers_m) {
+		if (worker->numberOfStealable_m > 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CPSWorkerPool::notifyWork(size_t workerIndex) {
+	const size_t numberOfWorkers = this->workers_m.size();
+
+	// Empezar por el siguiente worker, para repartir el trabajo
+	for (size_t i = 1; i < numberOfWorkers; i++) {
+		if (this->workers_m[(workerIndex + i) % numberOfWorkers]->inbox_m.wakeIfSleeping()) {
+			return;
+		}
+	}
+}
+
+void CPSWorkerPool::stop() {
+	this->stopping_m = true;
+
+	// Hay que despertar a todos los workers
+	for (const std::unique_ptr<Worker>& worker : this->workers_m) {
+		worker->inbox_m.wakeIfSleeping();
+	}
+}
+
+bool CPSWorkerPool::isStopping() const {
+	return this->stopping_m;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "CPSRunQueue.h"
+#include "CPSInbox.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+#include <boost/optional.hpp>
+
+/*
+ * Conjunto de workers, cada uno con su thread y su scheduler de continuaciones.
+ *
+ * Cada worker tiene una cola de continuaciones robables, en la que 'fork'
+ * deja la segunda continuación. El worker toma de a una la más reciente
+ * entre sus continuaciones (Que tiene sus datos todavía en la caché), y
+ * cuando se queda sin nada para ejecutar le roba la más antigua a los
+ * demás, por el otro extremo.
+ *
+ * Al dejar una continuación robable se despierta a un solo worker dormido,
+ * y el que roba despierta a otro si todavía quedan, para no despertar a
+ * todos por cada 'fork'.
+ *
+ * Lo que se ejecuta en un worker (yield, waitFor, E/S asíncrona) sigue en
+ * el mismo worker, con lo cual una tarea sólo cambia de worker si la roban
+ * antes de empezar. Para que una tarea se ejecute en un worker determinado
+ * (Por ejemplo un lector de sensor, para mantener la estabilidad de los tiempos)
+ * se usa 'CPSSched::forkOn', que la deja en la bandeja de entrada del worker,
+ * que no se puede robar.
+ *
+ * La bandeja de entrada es la del scheduler del worker, sin locks, con lo
+ * cual un worker dormido se despierta por su eventfd tanto si le encolan
+ * continuaciones como si esperaba tiempo, descriptores o E/S
+ */
+class CPSWorkerPool final
+{
+public:
+	/**
+	 * @pre La cantidad de workers tiene que ser mayor a cero
+	 * @post Crea el conjunto con la cantidad de workers especificada,
+	         y la capacidad de las colas de cada uno
+	 */
+	CPSWorkerPool(size_t numberOfWorkers, size_t queueCapacity = 4096);
+
+	CPSWorkerPool(const CPSWorkerPool&) = delete;
+	CPSWorkerPool& operator=(const CPSWorkerPool&) = delete;
+
+	/**
+	 * @post Destruye el conjunto
+	 */
+	~CPSWorkerPool();
+
+	/**
+	 * @post Devuelve la cantidad de workers
+	 */
+	size_t getNumberOfWorkers() const;
+
+	/**
+	 * @post Ejecuta la continuación especificada en el primer worker, y
+	         se bloquea hasta que alguna continuación termine con CPS_EXIT,
+			 momento en el que terminan todos los workers
+	 */
+	void run(Cont firstContinuation);
+
+	/**
+	 * @post Devuelve la cantidad de continuaciones robadas
+	 */
+	uint64_t getNumberOfSteals() const;
+
+private:
+	friend class CPSSched;
+
+	// Worker
+	struct Worker {
+		Worker(size_t queueCapacity);
+
+		std::mutex mutex_m; // Protege las continuaciones robables
+		CPSRunQueue stealable_m; // Continuaciones que puede robar cualquier worker (El dueño toma del final, los demás del principio)
+		std::atomic<size_t> numberOfStealable_m;
+		CPSInbox inbox_m; // Continuaciones que sólo puede ejecutar este worker
+	};
+
+	/**
+	 * @post Ejecuta el worker especificado, hasta que termine
+	 */
+	void runWorker(size_t workerIndex, boost::optional<Cont> firstContinuation);
+
+	/**
+	 * @post Encola la continuación para ser robada, desde el worker especificado
+	 */
+	void pushStealable(size_t workerIndex, Cont cont);
+
+	/**
+	 * @post Devuelve la bandeja de entrada del worker especificado
+	 */
+	CPSInbox& getInbox(size_t workerIndex);
+
+	/**
+	 * @post Encola la continuación en la bandeja de entrada del worker especificado.
+	         Si está llena lanza una excepción
+	 */
+	void pushInbox(size_t workerIndex, Cont cont);
+
+	/**
+	 * @post Pasa las continuaciones de la bandeja de entrada del worker especificado,
+	         y una de sus robables, a la cola especificada, mientras haya lugar
+	 */
+	void collect(size_t workerIndex, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Roba una continuación de otro worker, y la pasa a la cola especificada.
+	         Devuelve si pudo
+	 */
+	bool steal(size_t workerIndex, CPSRunQueue& continuationsToExecute);
+
+	/**
+	 * @post Devuelve si hay continuaciones que pueda ejecutar el worker especificado.
+	         Sólo desde el thread del worker
+	 */
+	bool hasWork(size_t workerIndex) const;
+
+	/**
+	 * @post Despierta a un worker que espera continuaciones, empezando
+	         por el siguiente al especificado, si hay alguno
+	 */
+	void notifyWork(size_t workerIndex);
+
+	/**
+	 * @post Pide terminar a todos los workers
+	 */
+	void stop();
+
+	/**
+	 * @post Devuelve si se pidió terminar
+	 */
+	bool isStopping() const;
+
+	const size_t queueCapacity_m;
+
+	std::vector<std::unique_ptr<Worker>> workers_m;
+
+	std::atomic<bool> stopping_m;
+	std::atomic<uint64_t> numberOfSteals_m;
+};
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+
+/*
+ * Base de tiempo.
+ *
+ * Permite reemplazar std::chrono::steady_clock por
+ * un reloj virtual en simulaciones
+ */
+class Clock
+{
+public:
+	virtual ~Clock() {}
+
+	/**
+	 * @post Devuelve el instante actual
+	 */
+	virtual std::chrono::steady_clock::time_point now() = 0;
+
+	/**
+	 * @post Si el reloj es virtual avanza el tiempo hasta el instante
+	         especificado (Si es posterior al actual) y devuelve verdadero.
+			 Caso contrario devuelve falso, y hay que esperar el instante
+	 */
+	virtual bool skipTo(std::chrono::steady_clock::time_point timePoint);
+
+	/**
+	 * @post Devuelve el reloj de std::chrono::steady_clock
+	 */
+	static Clock& getSteady();
+};
+
+/*
+ * Reloj de std::chrono::steady_clock (CLOCK_MONOTONIC)
+ */
+class SteadyClock final : public Clock
+{
+public:
+	std::chrono::steady_clock::time_point now() override {
+		return std::chrono::steady_clock::now();
+	}
+};
@@ -48,9 +48,28 @@ void runCPS(Cont firstContinuation) {
 
 	CPSSched::create();
 
+#ifdef CPS_INSTRUMENTATION
+	CPSInstrumentation *instrumentation = CPSSched::getInstrumentation();
+
+	// El final de una continuación es el principio de la siguiente
+	std::chrono::steady_clock::time_point startTimestamp = std::chrono::steady_clock::now();
+
+	while (nextCont.funptr_m != nullptr) {
+		Cont currentCont = nextCont;
+
+		nextCont = currentCont.funptr_m(currentCont.data_m);
+
+		const std::chrono::steady_clock::time_point endTimestamp = std::chrono::steady_clock::now();
+
+		instrumentation->recordContinuation(reinterpret_cast<const void *>(currentCont.funptr_m), endTimestamp - startTimestamp);
+
+		startTimestamp = endTimestamp;
+	}
+#else
 	while (nextCont.funptr_m != nullptr) {
 		nextCont = nextCont.funptr_m(nextCont.data_m);
 	}
+#endif
 
 	CPSSched::destroy();
 }
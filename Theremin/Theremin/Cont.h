@@ -38,13 +38,13 @@ class Cont final
 {
 public:
 	/**
-	 * @post Crea una continuacin invlida
+	 * @post Crea una continuación inválida
 	 */
 	Cont();
 
 	/**
-	 * @post Crea una continuacin con el puntero
-			 a la funcin y los datos especificados
+	 * @post Crea una continuación con el puntero
+			 a la función y los datos especificados
 	 */
 	template<typename T>
 	Cont(Cont(*funptr) (T *), T *data) {
@@ -68,16 +68,16 @@ private:
 	void *data_m;
 };
 
-// Continuacin 'dummy' para salir del loop de CPS
+// Continuación 'dummy' para salir del loop de CPS
 static Cont CPS_EXIT = Cont::create<void *>(nullptr, nullptr);
 
 /**
  * @post Ejecuta la secuencia de continuaciones.
  *       
  *       Internamente, manda la orden para crear el scheduler, y
- *       destruirlo cuando sale del mtodo.
+ *       destruirlo cuando sale del método.
  *
- *       ATENCIN: Para evitar su destruccin, tiene que haberse creado
+ *       ATENCIÓN: Para evitar su destrucción, tiene que haberse creado
  *                 una referencia fuera.
  */
 void runCPS(Cont firstContinuation);
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorAlphaBetaEstimator.h"
+
+#include <stdexcept>
+#include <cmath>
+
+constexpr double DistanceSensor::AlphaBetaEstimator::defaultAlpha;
+constexpr double DistanceSensor::AlphaBetaEstimator::defaultBeta;
+constexpr double DistanceSensor::AlphaBetaEstimator::defaultGate;
+
+DistanceSensor::AlphaBetaEstimator::AlphaBetaEstimator(size_t maxMissingSamples, double alpha, double beta, double gate) :
+	maxMissingSamples_m(maxMissingSamples),
+	alpha_m(alpha),
+	beta_m(beta),
+	gate_m(gate)
+{
+	if ((alpha <= 0) || (alpha > 1) || (beta < 0) || (gate <= 0)) {
+		throw std::runtime_error("Invalid alpha-beta estimator parameters");
+	}
+
+	this->isTracking_m = false;
+	this->missingSamples_m = 0;
+	this->consecutiveOutliers_m = 0;
+}
+
+void DistanceSensor::AlphaBetaEstimator::update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) {
+	if (!this->isTracking_m) {
+		if (distance.is_initialized()) {
+			this->initialize(timestamp, *distance);
+		}
+
+		return;
+	}
+
+	const double dt = std::chrono::duration<double>(timestamp - this->timestamp_m).count();
+
+	if (dt <= 0) {
+		return;
+	}
+
+	// Predecir con la velocidad
+	this->timestamp_m = timestamp;
+	this->distance_m += this->velocity_m * dt;
+
+	// Sin muestra sólo se predice, y si faltan demasiadas seguidas se pierde el seguimiento
+	if (!distance.is_initialized()) {
+		if (++this->missingSamples_m >= this->maxMissingSamples_m) {
+			this->isTracking_m = false;
+		}
+
+		return;
+	}
+
+	this->missingSamples_m = 0;
+
+	const double residual = *distance - this->distance_m;
+
+	// Descartar las muestras atípicas, salvo que se repitan (La mano se movió de golpe)
+	if (std::fabs(residual) > this->gate_m) {
+		if (++this->consecutiveOutliers_m < maxConsecutiveOutliers) {
+			return;
+		}
+
+		this->initialize(timestamp, *distance);
+
+		return;
+	}
+
+	this->consecutiveOutliers_m = 0;
+
+	this->distance_m += this->alpha_m * residual;
+	this->velocity_m += this->beta_m * residual / dt;
+}
+
+boost::optional<DistanceSensor::Estimate> DistanceSensor::AlphaBetaEstimator::getEstimate() const {
+	if (this->isTracking_m) {
+		DistanceSensor::Estimate estimate;
+		estimate.timestamp = this->timestamp_m;
+		estimate.distance = this->distance_m;
+		estimate.velocity = this->velocity_m;
+
+		return estimate;
+	}
+	else {
+		return boost::optional<DistanceSensor::Estimate>();
+	}
+}
+
+void DistanceSensor::AlphaBetaEstimator::initialize(std::chrono::steady_clock::time_point timestamp, double distance) {
+	this->isTracking_m = true;
+	this->timestamp_m = timestamp;
+
+	this->distance_m = distance;
+	this->velocity_m = 0;
+
+	this->missingSamples_m = 0;
+	this->consecutiveOutliers_m = 0;
+}
\ No newline at end of file
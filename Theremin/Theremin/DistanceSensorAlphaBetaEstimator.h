@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "DistanceSensorEstimator.h"
+
+namespace DistanceSensor {
+	/*
+	 * Estimador alfa-beta: seguimiento de distancia y velocidad con
+	 * ganancias fijas (Un Kalman de velocidad constante en régimen,
+	 * sin calcular la covarianza).
+	 *
+	 * Las muestras más lejos de la predicción que la compuerta se
+	 * descartan como atípicas, salvo que se repitan, en cuyo caso
+	 * se reinicia el seguimiento desde la muestra
+	 */
+	class AlphaBetaEstimator final : public DistanceSensor::Estimator
+	{
+	public:
+		// Ganancia de distancia por defecto
+		static constexpr double defaultAlpha = 0.6;
+
+		// Ganancia de velocidad por defecto (Relación de Benedict-Bordner para alfa: alfa^2 / (2 - alfa))
+		static constexpr double defaultBeta = defaultAlpha * defaultAlpha / (2.0 - defaultAlpha);
+
+		// Compuerta de las muestras atípicas por defecto, en metros
+		static constexpr double defaultGate = 0.05;
+
+		// Muestras atípicas seguidas que reinician el seguimiento
+		static const unsigned int maxConsecutiveOutliers = 3;
+
+		/**
+		 * @post Crea el estimador con la cantidad especificada de
+		         muestras faltantes seguidas con las que se pierde el
+				 seguimiento, las ganancias de distancia y velocidad,
+				 y la compuerta de las muestras atípicas
+		 */
+		AlphaBetaEstimator(size_t maxMissingSamples, double alpha = defaultAlpha, double beta = defaultBeta, double gate = defaultGate);
+
+		void update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) override;
+
+		boost::optional<DistanceSensor::Estimate> getEstimate() const override;
+
+	private:
+		/**
+		 * @post Empieza el seguimiento en la distancia especificada,
+		         sin velocidad
+		 */
+		void initialize(std::chrono::steady_clock::time_point timestamp, double distance);
+
+		const size_t maxMissingSamples_m;
+		const double alpha_m;
+		const double beta_m;
+		const double gate_m;
+
+		bool isTracking_m; // Si hay seguimiento
+		std::chrono::steady_clock::time_point timestamp_m; // Instante del estado
+
+		double distance_m;
+		double velocity_m;
+
+		size_t missingSamples_m; // Muestras faltantes seguidas
+		unsigned int consecutiveOutliers_m; // Muestras atípicas seguidas
+	};
+}
@@ -81,6 +81,72 @@ DistanceSensor::Configuration DistanceSensor::Configuration::withMaxDistance(dou
 	return newConfig;
 }
 
+DistanceSensor::Configuration DistanceSensor::Configuration::withEchoDetection(DistanceSensor::EchoDetection echoDetection) {
+	DistanceSensor::Configuration newConfig = *this;
+
+	newConfig.echoDetection_m = echoDetection;
+
+	return newConfig;
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withSampling(DistanceSensor::Sampling sampling) {
+	DistanceSensor::Configuration newConfig = *this;
+
+	newConfig.sampling_m = sampling;
+
+	return newConfig;
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withSampleTolerance(double tolerance) {
+	if (tolerance >= 0) {
+		DistanceSensor::Configuration newConfig = *this;
+
+		newConfig.sampleTolerance_m = tolerance;
+
+		return newConfig;
+	}
+	else {
+		throw std::runtime_error("Invalid sample tolerance");
+	}
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withMaxNumberOfSamples(int maxNumberOfSamples) {
+	if (maxNumberOfSamples > 0) {
+		DistanceSensor::Configuration newConfig = *this;
+
+		newConfig.maxNumberOfSamples_m = maxNumberOfSamples;
+
+		return newConfig;
+	}
+	else {
+		throw std::runtime_error("Invalid max number of samples");
+	}
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withEstimation(DistanceSensor::Estimation estimation) {
+	DistanceSensor::Configuration newConfig = *this;
+
+	newConfig.estimation_m = estimation;
+
+	return newConfig;
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withGPIOBackend(GPIO::Backend *backend) {
+	DistanceSensor::Configuration newConfig = *this;
+
+	newConfig.gpioBackend_m = backend;
+
+	return newConfig;
+}
+
+DistanceSensor::Configuration DistanceSensor::Configuration::withEchoBank(GPIO::Bank *bank) {
+	DistanceSensor::Configuration newConfig = *this;
+
+	newConfig.echoBank_m = bank;
+
+	return newConfig;
+}
+
 int DistanceSensor::Configuration::getTriggerId() {
 	return *this->triggerId_m;
 }
@@ -99,4 +165,32 @@ double DistanceSensor::Configuration::getExpectedTemperature() {
 
 double DistanceSensor::Configuration::getMaxDistance() {
 	return *this->maxDistance_m;
+}
+
+DistanceSensor::EchoDetection DistanceSensor::Configuration::getEchoDetection() {
+	return this->echoDetection_m.value_or(DistanceSensor::EchoDetection::polling);
+}
+
+DistanceSensor::Sampling DistanceSensor::Configuration::getSampling() {
+	return this->sampling_m.value_or(DistanceSensor::Sampling::batch);
+}
+
+double DistanceSensor::Configuration::getSampleTolerance() {
+	return this->sampleTolerance_m.value_or(0.005);
+}
+
+int DistanceSensor::Configuration::getMaxNumberOfSamples() {
+	return this->maxNumberOfSamples_m.value_or(2 * this->getNumberOfSamples());
+}
+
+DistanceSensor::Estimation DistanceSensor::Configuration::getEstimation() {
+	return this->estimation_m.value_or(DistanceSensor::Estimation::median);
+}
+
+GPIO::Backend * DistanceSensor::Configuration::getGPIOBackend() {
+	return this->gpioBackend_m.value_or(&GPIO::Backend::getDefault());
+}
+
+GPIO::Bank * DistanceSensor::Configuration::getEchoBank() {
+	return this->echoBank_m.value_or(nullptr);
 }
\ No newline at end of file
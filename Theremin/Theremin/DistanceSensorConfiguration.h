@@ -34,12 +34,55 @@
 
 #include <boost/optional.hpp>
 
+#include "GPIOBackend.h"
+#include "GPIOBank.h"
+
 namespace DistanceSensor {
+	/*
+	 * Modo de detección del pin 'echo'
+	 *
+	 * polling: Lee el pin continuamente, cediendo CPU entre lecturas
+	 * edge: Espera los flancos con eventos del kernel (Interrupciones).
+	 *       Si el backend de GPIO no los soporta se usa polling
+	 * asyncPolling: Lee el pin continuamente con lecturas asíncronas del scheduler (io_uring),
+	 *               que se envían juntas con las de los demás sensores.
+	 *               Si el pin no tiene descriptor de archivo o se muestrea
+	 *               a través de un conjunto de pines se usa polling
+	 */
+	enum class EchoDetection { polling, edge, asyncPolling };
+
+	/*
+	 * Muestreo de cada lectura
+	 *
+	 * batch: Toma todas las muestras configuradas y devuelve su mediana
+	 * sliding: Toma una sola muestra y devuelve la mediana de las últimas
+	 *          muestras configuradas (Ventana deslizante), con una distancia
+	 *          nueva por cada impulso en lugar de una por cada lote
+	 * adaptive: Toma muestras hasta que las últimas consecutivas coinciden
+	 *           dentro de la tolerancia, o hasta el máximo de muestras si
+	 *           se dispersan, y devuelve su mediana
+	 */
+	enum class Sampling { batch, sliding, adaptive };
+
+	/*
+	 * Estimación de la distancia a partir de las muestras
+	 *
+	 * median: Mediana de la ventana de muestras
+	 * trimmedMean: Media intercuartil de la ventana de muestras
+	 * kalman: Seguimiento de distancia y velocidad con un filtro de Kalman
+	 *         de velocidad constante
+	 * alphaBeta: Seguimiento de distancia y velocidad con ganancias fijas
+	 *
+	 * Los seguimientos no se atrasan con el movimiento de la mano y
+	 * estiman la velocidad, para extrapolar la distancia
+	 */
+	enum class Estimation { median, trimmedMean, kalman, alphaBeta };
+
 	class Configuration final
 	{
 	public:
 		/**
-		 * @post Crea una configuracin de sensor
+		 * @post Crea una configuración de sensor
 		 */
 		Configuration();
 
@@ -54,7 +97,7 @@ namespace DistanceSensor {
 		Configuration withEchoId(int id);
 
 		/**
-		 * @post Especifica el nmero de muestras
+		 * @post Especifica el número de muestras
 		 */
 		Configuration withNumberOfSamples(int numberOfSamples);
 
@@ -64,10 +107,48 @@ namespace DistanceSensor {
 		Configuration withExpectedTemperature(double temperature);
 
 		/**
-		 * @post Especifica la mxima distancia en metros
+		 * @post Especifica la máxima distancia en metros
 		 */
 		Configuration withMaxDistance(double maxDistance);
 
+		/**
+		 * @post Especifica el modo de detección del pin 'echo'
+		 */
+		Configuration withEchoDetection(DistanceSensor::EchoDetection echoDetection);
+
+		/**
+		 * @post Especifica el muestreo de cada lectura
+		 */
+		Configuration withSampling(DistanceSensor::Sampling sampling);
+
+		/**
+		 * @post Especifica la tolerancia en metros con la que coinciden
+		         las muestras, para el muestreo adaptativo
+		 */
+		Configuration withSampleTolerance(double tolerance);
+
+		/**
+		 * @post Especifica el máximo número de muestras, para el muestreo adaptativo
+		 */
+		Configuration withMaxNumberOfSamples(int maxNumberOfSamples);
+
+		/**
+		 * @post Especifica la estimación de la distancia
+		 */
+		Configuration withEstimation(DistanceSensor::Estimation estimation);
+
+		/**
+		 * @post Especifica el backend de GPIO
+		 */
+		Configuration withGPIOBackend(GPIO::Backend *backend);
+
+		/**
+		 * @post Especifica el conjunto de pines en el que se muestrea
+		         el pin 'echo' al hacer polling, compartiendo las lecturas
+				 con los otros sensores del conjunto
+		 */
+		Configuration withEchoBank(GPIO::Bank *bank);
+
 		/**
 		 * @post Lee el id de trigger
 		 */
@@ -79,7 +160,7 @@ namespace DistanceSensor {
 		int getEchoId();
 
 		/**
-		 * @post Devuelve el nmero de muestras
+		 * @post Devuelve el número de muestras
 		 */
 		int getNumberOfSamples();
 
@@ -89,10 +170,52 @@ namespace DistanceSensor {
 		double getExpectedTemperature();
 
 		/**
-		 * @post Devuelve la mxima distancia
+		 * @post Devuelve la máxima distancia
 		 */
 		double getMaxDistance();
 
+		/**
+		 * @post Devuelve el modo de detección del pin 'echo'
+		         (Por defecto polling)
+		 */
+		DistanceSensor::EchoDetection getEchoDetection();
+
+		/**
+		 * @post Devuelve el muestreo de cada lectura
+		         (Por defecto batch)
+		 */
+		DistanceSensor::Sampling getSampling();
+
+		/**
+		 * @post Devuelve la tolerancia de las muestras
+		         (Por defecto 5 milímetros)
+		 */
+		double getSampleTolerance();
+
+		/**
+		 * @post Devuelve el máximo número de muestras
+		         (Por defecto el doble del número de muestras)
+		 */
+		int getMaxNumberOfSamples();
+
+		/**
+		 * @post Devuelve la estimación de la distancia
+		         (Por defecto median)
+		 */
+		DistanceSensor::Estimation getEstimation();
+
+		/**
+		 * @post Devuelve el backend de GPIO
+		         (Por defecto el predeterminado)
+		 */
+		GPIO::Backend * getGPIOBackend();
+
+		/**
+		 * @post Devuelve el conjunto de pines del pin 'echo'
+		         (nullptr si se lee individualmente)
+		 */
+		GPIO::Bank * getEchoBank();
+
 	private:
 		boost::optional<int> triggerId_m;
 		boost::optional<int> echoId_m;
@@ -100,6 +223,13 @@ namespace DistanceSensor {
 		boost::optional<int> numberOfSamples_m;
 		boost::optional<double> expectedTemperature_m;
 		boost::optional<double> maxDistance_m;
+		boost::optional<DistanceSensor::EchoDetection> echoDetection_m;
+		boost::optional<DistanceSensor::Sampling> sampling_m;
+		boost::optional<double> sampleTolerance_m;
+		boost::optional<int> maxNumberOfSamples_m;
+		boost::optional<DistanceSensor::Estimation> estimation_m;
+		boost::optional<GPIO::Backend *> gpioBackend_m;
+		boost::optional<GPIO::Bank *> echoBank_m;
 	};
 
 
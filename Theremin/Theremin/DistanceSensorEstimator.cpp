@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorEstimator.h"
+#include "DistanceSensorWindowEstimator.h"
+#include "DistanceSensorKalmanEstimator.h"
+#include "DistanceSensorAlphaBetaEstimator.h"
+
+#include <stdexcept>
+
+double DistanceSensor::Estimate::extrapolate(std::chrono::steady_clock::time_point timestamp) const {
+	if (this->velocity.is_initialized()) {
+		return this->distance + *this->velocity * std::chrono::duration<double>(timestamp - this->timestamp).count();
+	}
+	else {
+		return this->distance;
+	}
+}
+
+void DistanceSensor::Estimator::startBatch() {
+
+}
+
+std::unique_ptr<DistanceSensor::Estimator> DistanceSensor::Estimator::create(DistanceSensor::Configuration& configuration) {
+	// Con muestreo adaptativo la ventana tiene que alcanzar para el máximo de muestras
+	const size_t numberOfSamples = (size_t)((configuration.getSampling() == DistanceSensor::Sampling::adaptive) ? configuration.getMaxNumberOfSamples() : configuration.getNumberOfSamples());
+
+	switch (configuration.getEstimation()) {
+	case DistanceSensor::Estimation::median:
+		return std::unique_ptr<DistanceSensor::Estimator>(new DistanceSensor::WindowEstimator(numberOfSamples, DistanceSensor::WindowEstimator::medianTrimFraction));
+	case DistanceSensor::Estimation::trimmedMean:
+		return std::unique_ptr<DistanceSensor::Estimator>(new DistanceSensor::WindowEstimator(numberOfSamples, DistanceSensor::WindowEstimator::defaultTrimFraction));
+	case DistanceSensor::Estimation::kalman:
+		return std::unique_ptr<DistanceSensor::Estimator>(new DistanceSensor::KalmanEstimator(numberOfSamples));
+	case DistanceSensor::Estimation::alphaBeta:
+		return std::unique_ptr<DistanceSensor::Estimator>(new DistanceSensor::AlphaBetaEstimator(numberOfSamples));
+	}
+
+	throw std::runtime_error("Invalid estimation");
+}
\ No newline at end of file
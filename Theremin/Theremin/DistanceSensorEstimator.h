@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "DistanceSensorConfiguration.h"
+
+#include <chrono>
+#include <memory>
+
+#include <boost/optional.hpp>
+
+namespace DistanceSensor {
+	/*
+	 * Estimación de la distancia a partir de las muestras
+	 */
+	struct Estimate {
+		std::chrono::steady_clock::time_point timestamp; // Instante al que corresponde la estimación
+		double distance; // Distancia en metros
+		boost::optional<double> velocity; // Velocidad en m/s (Si el estimador la calcula)
+
+		/**
+		 * @post Devuelve la distancia extrapolada al instante especificado
+		         con la velocidad, o la distancia si no hay velocidad.
+				 Sirve para compensar la latencia hasta que se usa
+				 (Por ejemplo hasta que se reproduce el audio)
+		 */
+		double extrapolate(std::chrono::steady_clock::time_point timestamp) const;
+	};
+
+	/*
+	 * Estimador de distancia.
+	 *
+	 * Recibe una muestra por impulso, con el instante en el que se
+	 * tomó, y estima la distancia (Y opcionalmente la velocidad).
+	 * Las muestras pueden faltar (No llegó el eco)
+	 */
+	class Estimator
+	{
+	public:
+		virtual ~Estimator() {}
+
+		/**
+		 * @post Empieza un lote de muestras (Muestreo batch).
+		         Por defecto no hace nada: los estimadores de
+				 ventana lo redefinen para descartar las muestras
+				 de los lotes anteriores, los de seguimiento
+				 conservan su estado entre lotes
+		 */
+		virtual void startBatch();
+
+		/**
+		 * @post Agrega la muestra de distancia en metros tomada en
+		         el instante especificado, o vacía si falta
+		 */
+		virtual void update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) = 0;
+
+		/**
+		 * @post Devuelve la estimación, o vacío si no hay
+		         suficientes muestras
+		 */
+		virtual boost::optional<DistanceSensor::Estimate> getEstimate() const = 0;
+
+		/**
+		 * @post Crea el estimador de la configuración especificada,
+		         con la cantidad de muestras de la configuración (La
+				 máxima con muestreo adaptativo) como tamaño de ventana
+				 o límite de muestras faltantes
+		 */
+		static std::unique_ptr<DistanceSensor::Estimator> create(DistanceSensor::Configuration& configuration);
+	};
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorGroup.h"
+#include "CPSSched.h"
+
+#include <stdexcept>
+#include <iomanip>
+
+constexpr std::chrono::microseconds DistanceSensor::Group::defaultGuardTime;
+
+double DistanceSensor::Group::Snapshot::getUpdatesPerSecond(const Snapshot& previous, size_t sensorIndex) const {
+	const double elapsedTime = std::chrono::duration<double>(this->timestamp - previous.timestamp).count();
+	const uint64_t previousCount = (sensorIndex < previous.sensorCounts.size()) ? previous.sensorCounts[sensorIndex].numberOfUpdates : 0;
+
+	if (elapsedTime > 0.0) {
+		return (double)(this->sensorCounts[sensorIndex].numberOfUpdates - previousCount) / elapsedTime;
+	}
+	else {
+		return 0.0;
+	}
+}
+
+double DistanceSensor::Group::Snapshot::getValidUpdatesPerSecond(const Snapshot& previous, size_t sensorIndex) const {
+	const double elapsedTime = std::chrono::duration<double>(this->timestamp - previous.timestamp).count();
+	const uint64_t previousCount = (sensorIndex < previous.sensorCounts.size()) ? previous.sensorCounts[sensorIndex].numberOfValidUpdates : 0;
+
+	if (elapsedTime > 0.0) {
+		return (double)(this->sensorCounts[sensorIndex].numberOfValidUpdates - previousCount) / elapsedTime;
+	}
+	else {
+		return 0.0;
+	}
+}
+
+void DistanceSensor::Group::Snapshot::print(std::ostream& output, const Snapshot& previous) const {
+	double totalUpdatesPerSecond = 0.0;
+
+	for (size_t i = 0; i < this->sensorCounts.size(); i++) {
+		const double updatesPerSecond = this->getUpdatesPerSecond(previous, i);
+
+		output << "Sensor " << i << ": " << std::fixed << std::setprecision(1) << updatesPerSecond << " updates/s, " << this->getValidUpdatesPerSecond(previous, i) << " with distance" << std::endl;
+
+		totalUpdatesPerSecond += updatesPerSecond;
+	}
+
+	output << "Sensor group: " << std::fixed << std::setprecision(1) << totalUpdatesPerSecond << " updates/s" << std::endl;
+}
+
+DistanceSensor::Group::Group(std::chrono::steady_clock::duration guardTime) :
+	guardTime_m(guardTime),
+	timestamp_m(0)
+{
+	this->currentSlot_m = 0;
+	this->isRunning_m = false;
+}
+
+void DistanceSensor::Group::add(DistanceSensor::SynchronizedContext& context) {
+	if (this->isRunning_m) {
+		throw std::runtime_error("Cannot add sensors to a running sensor group");
+	}
+
+	this->slots_m.emplace_back();
+
+	Slot& slot = this->slots_m.back();
+	slot.context = &context;
+	slot.numberOfUpdates.store(0, std::memory_order_relaxed);
+	slot.numberOfValidUpdates.store(0, std::memory_order_relaxed);
+}
+
+size_t DistanceSensor::Group::getNumberOfSensors() const {
+	return this->slots_m.size();
+}
+
+Cont DistanceSensor::Group::run() {
+	if (this->slots_m.empty()) {
+		throw std::runtime_error("Cannot run an empty sensor group");
+	}
+
+	this->isRunning_m = true;
+	this->currentSlot_m = 0;
+
+	this->timestamp_m.store(CPSSched::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+	return Cont(DistanceSensor::Group::fireSlot, this);
+}
+
+DistanceSensor::Group::Snapshot DistanceSensor::Group::getSnapshot() const {
+	Snapshot snapshot;
+
+	snapshot.timestamp = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(this->timestamp_m.load(std::memory_order_acquire)));
+
+	for (const Slot& slot : this->slots_m) {
+		snapshot.sensorCounts.push_back(SensorCount {
+			slot.numberOfUpdates.load(std::memory_order_relaxed),
+			slot.numberOfValidUpdates.load(std::memory_order_relaxed)
+		});
+	}
+
+	return snapshot;
+}
+
+CPSHistogram::Snapshot DistanceSensor::Group::getLatencyStatistics(size_t sensorIndex) const {
+	return this->slots_m.at(sensorIndex).latencyHistogram.getSnapshot();
+}
+
+Cont DistanceSensor::Group::fireSlot(DistanceSensor::Group *group) {
+	Slot& slot = group->slots_m[group->currentSlot_m];
+
+	slot.fireTimestamp = CPSSched::now();
+
+	return slot.context->update(
+		Cont(DistanceSensor::Group::closeSlot, group)
+	);
+}
+
+Cont DistanceSensor::Group::closeSlot(DistanceSensor::Group *group) {
+	Slot& slot = group->slots_m[group->currentSlot_m];
+
+	const auto timestamp = CPSSched::now();
+
+	// La primera lectura inicializa los pines del sensor antes de emitir, con lo cual su latencia no es representativa
+	if (slot.numberOfUpdates.load(std::memory_order_relaxed) > 0) {
+		slot.latencyHistogram.record((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - slot.fireTimestamp).count());
+	}
+
+	// Sólo lo registra el thread de la lectura, sin operaciones de lectura-modificación-escritura
+	slot.numberOfUpdates.store(slot.numberOfUpdates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	if (slot.context->getDistance().is_initialized()) {
+		slot.numberOfValidUpdates.store(slot.numberOfValidUpdates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	group->timestamp_m.store(timestamp.time_since_epoch().count(), std::memory_order_release);
+
+	// El siguiente sensor emite cuando ya no pueden volver reflexiones del pulso anterior
+	const auto nextFireTimestamp = slot.context->getEchoWindowEnd() + group->guardTime_m;
+
+	group->currentSlot_m = (group->currentSlot_m + 1) % group->slots_m.size();
+
+	return CPSSched::waitUntil(nextFireTimestamp, Cont(DistanceSensor::Group::fireSlot, group));
+}
\ No newline at end of file
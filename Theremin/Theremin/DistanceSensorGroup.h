@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Cont.h"
+#include "DistanceSensorSynchronizedContext.h"
+#include "CPSHistogram.h"
+
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace DistanceSensor {
+	/*
+	 * Grupo de sensores de distancia que comparten el espacio.
+	 *
+	 * Lee los sensores por turnos (Multiplexación por división de tiempo),
+	 * para que el pulso de un sensor no llegue como eco a otro:
+	 * cada sensor emite recién cuando se cerró la ventana de eco de la
+	 * lectura anterior, que depende de la distancia máxima de su sensor,
+	 * más un tiempo de guarda para las reflexiones lejanas.
+	 * Así los turnos quedan lo más juntos posible sin interferencia.
+	 *
+	 * Se arma antes de empezar la lectura, y se puede obtener el
+	 * estado de la lectura desde cualquier thread
+	 */
+	class Group final
+	{
+	public:
+		// Lecturas de un sensor
+		struct SensorCount {
+			uint64_t numberOfUpdates; // Lecturas realizadas
+			uint64_t numberOfValidUpdates; // Lecturas con distancia
+		};
+
+		// Copia del estado de la lectura
+		struct Snapshot {
+			std::chrono::steady_clock::time_point timestamp; // Fin del último turno
+			std::vector<DistanceSensor::Group::SensorCount> sensorCounts;
+
+			/**
+			 * @post Devuelve las lecturas por segundo del sensor especificado
+			         desde la copia anterior especificada
+			 */
+			double getUpdatesPerSecond(const Snapshot& previous, size_t sensorIndex) const;
+
+			/**
+			 * @post Devuelve las lecturas con distancia por segundo del
+			         sensor especificado desde la copia anterior especificada
+			 */
+			double getValidUpdatesPerSecond(const Snapshot& previous, size_t sensorIndex) const;
+
+			/**
+			 * @post Imprime las lecturas por segundo de cada sensor
+			         desde la copia anterior especificada
+			 */
+			void print(std::ostream& output, const Snapshot& previous) const;
+		};
+
+		// Tiempo de guarda predeterminado entre turnos
+		static constexpr std::chrono::microseconds defaultGuardTime = std::chrono::microseconds(1000);
+
+		/**
+		 * @post Crea un grupo vacío con el tiempo de guarda especificado
+		 */
+		Group(std::chrono::steady_clock::duration guardTime = defaultGuardTime);
+
+		Group(const Group&) = delete;
+		Group& operator=(const Group&) = delete;
+
+		/**
+		 * @post Agrega el sensor especificado, con el siguiente turno.
+		         No se pueden agregar sensores después de empezar la lectura
+		 */
+		void add(DistanceSensor::SynchronizedContext& context);
+
+		/**
+		 * @post Devuelve la cantidad de sensores
+		 */
+		size_t getNumberOfSensors() const;
+
+		/**
+		 * @post Lee los sensores por turnos indefinidamente
+		 */
+		Cont run();
+
+		/**
+		 * @post Devuelve una copia del estado, desde cualquier thread
+		 */
+		Snapshot getSnapshot() const;
+
+		/**
+		 * @post Devuelve la estadística de la latencia de las lecturas del
+		         sensor especificado, desde que empieza su turno (Emite)
+				 hasta que publica la estimación, en nanosegundos (Sin la
+				 primera, que inicializa los pines), desde cualquier thread
+		 */
+		CPSHistogram::Snapshot getLatencyStatistics(size_t sensorIndex) const;
+
+	private:
+		// Turno de un sensor
+		struct Slot {
+			DistanceSensor::SynchronizedContext *context;
+			std::atomic<uint64_t> numberOfUpdates;
+			std::atomic<uint64_t> numberOfValidUpdates;
+
+			std::chrono::steady_clock::time_point fireTimestamp; // Comienzo del turno actual
+			CPSHistogram latencyHistogram; // Latencia de cada lectura
+		};
+
+		/**
+		 * @post Empieza el turno actual
+		 */
+		static Cont fireSlot(DistanceSensor::Group *group);
+
+		/**
+		 * @post Termina el turno actual, y espera el siguiente
+		 */
+		static Cont closeSlot(DistanceSensor::Group *group);
+
+		const std::chrono::steady_clock::duration guardTime_m;
+
+		std::deque<Slot> slots_m; // Con dirección estable, por los contadores atómicos
+		size_t currentSlot_m;
+		bool isRunning_m;
+
+		std::atomic<int64_t> timestamp_m; // Fin del último turno, en ticks de steady_clock
+	};
+}
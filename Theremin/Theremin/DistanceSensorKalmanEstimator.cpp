@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorKalmanEstimator.h"
+
+#include <stdexcept>
+
+constexpr double DistanceSensor::KalmanEstimator::defaultMeasurementNoise;
+constexpr double DistanceSensor::KalmanEstimator::defaultAccelerationNoise;
+constexpr double DistanceSensor::KalmanEstimator::defaultGate;
+
+// Varianza inicial de la velocidad, en (m/s)^2 (La mano puede estar moviéndose hasta unos metros por segundo)
+static const double initialVelocityVariance = 4.0;
+
+DistanceSensor::KalmanEstimator::KalmanEstimator(size_t maxMissingSamples, double measurementNoise, double accelerationNoise, double gate) :
+	maxMissingSamples_m(maxMissingSamples),
+	measurementVariance_m(measurementNoise * measurementNoise),
+	accelerationVariance_m(accelerationNoise * accelerationNoise),
+	gate_m(gate)
+{
+	if ((measurementNoise <= 0) || (accelerationNoise <= 0) || (gate <= 0)) {
+		throw std::runtime_error("Invalid Kalman estimator parameters");
+	}
+
+	this->isTracking_m = false;
+	this->missingSamples_m = 0;
+	this->consecutiveOutliers_m = 0;
+}
+
+void DistanceSensor::KalmanEstimator::update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) {
+	if (!this->isTracking_m) {
+		if (distance.is_initialized()) {
+			this->initialize(timestamp, *distance);
+		}
+
+		return;
+	}
+
+	this->predict(timestamp);
+
+	// Sin muestra sólo se predice, y si faltan demasiadas seguidas se pierde el seguimiento
+	if (!distance.is_initialized()) {
+		if (++this->missingSamples_m >= this->maxMissingSamples_m) {
+			this->isTracking_m = false;
+		}
+
+		return;
+	}
+
+	this->missingSamples_m = 0;
+
+	const double innovation = *distance - this->distance_m;
+	const double innovationVariance = this->distanceVariance_m + this->measurementVariance_m;
+
+	// Descartar las muestras atípicas, salvo que se repitan (La mano se movió de golpe)
+	if (innovation * innovation > this->gate_m * this->gate_m * innovationVariance) {
+		if (++this->consecutiveOutliers_m < maxConsecutiveOutliers) {
+			return;
+		}
+
+		this->initialize(timestamp, *distance);
+
+		return;
+	}
+
+	this->consecutiveOutliers_m = 0;
+
+	const double distanceGain = this->distanceVariance_m / innovationVariance;
+	const double velocityGain = this->covariance_m / innovationVariance;
+
+	this->distance_m += distanceGain * innovation;
+	this->velocity_m += velocityGain * innovation;
+
+	this->velocityVariance_m -= velocityGain * this->covariance_m;
+	this->covariance_m *= (1.0 - distanceGain);
+	this->distanceVariance_m *= (1.0 - distanceGain);
+}
+
+boost::optional<DistanceSensor::Estimate> DistanceSensor::KalmanEstimator::getEstimate() const {
+	if (this->isTracking_m) {
+		DistanceSensor::Estimate estimate;
+		estimate.timestamp = this->timestamp_m;
+		estimate.distance = this->distance_m;
+		estimate.velocity = this->velocity_m;
+
+		return estimate;
+	}
+	else {
+		return boost::optional<DistanceSensor::Estimate>();
+	}
+}
+
+void DistanceSensor::KalmanEstimator::initialize(std::chrono::steady_clock::time_point timestamp, double distance) {
+	this->isTracking_m = true;
+	this->timestamp_m = timestamp;
+
+	this->distance_m = distance;
+	this->velocity_m = 0;
+
+	this->distanceVariance_m = this->measurementVariance_m;
+	this->covariance_m = 0;
+	this->velocityVariance_m = initialVelocityVariance;
+
+	this->missingSamples_m = 0;
+	this->consecutiveOutliers_m = 0;
+}
+
+void DistanceSensor::KalmanEstimator::predict(std::chrono::steady_clock::time_point timestamp) {
+	double dt = std::chrono::duration<double>(timestamp - this->timestamp_m).count();
+
+	if (dt < 0) {
+		dt = 0;
+	}
+
+	this->timestamp_m = timestamp;
+
+	this->distance_m += this->velocity_m * dt;
+
+	// P = F P F' + Q, con F = [1 dt; 0 1] y Q la de aceleración blanca discreta
+	const double dt2 = dt * dt;
+
+	this->distanceVariance_m += 2 * dt * this->covariance_m + dt2 * this->velocityVariance_m + this->accelerationVariance_m * dt2 * dt2 / 4;
+	this->covariance_m += dt * this->velocityVariance_m + this->accelerationVariance_m * dt2 * dt / 2;
+	this->velocityVariance_m += this->accelerationVariance_m * dt2;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "DistanceSensorEstimator.h"
+
+namespace DistanceSensor {
+	/*
+	 * Estimador de Kalman de velocidad constante.
+	 *
+	 * El estado es la distancia y la velocidad, y la aceleración de
+	 * la mano se modela como ruido blanco. Entre muestras predice con
+	 * la velocidad, así no se atrasa con el movimiento, y pondera
+	 * cada muestra según la incertidumbre de la predicción.
+	 *
+	 * Las muestras demasiado lejos de la predicción (Más desvíos
+	 * estándar que la compuerta) se descartan como atípicas,
+	 * salvo que se repitan, en cuyo caso la mano se movió de golpe
+	 * y se reinicia el seguimiento desde la muestra
+	 */
+	class KalmanEstimator final : public DistanceSensor::Estimator
+	{
+	public:
+		// Desvío estándar del ruido de las muestras por defecto, en metros
+		static constexpr double defaultMeasurementNoise = 0.003;
+
+		// Desvío estándar de la aceleración de la mano por defecto, en m/s^2
+		static constexpr double defaultAccelerationNoise = 20.0;
+
+		// Compuerta de las muestras atípicas por defecto, en desvíos estándar
+		static constexpr double defaultGate = 4.0;
+
+		// Muestras atípicas seguidas que reinician el seguimiento
+		static const unsigned int maxConsecutiveOutliers = 3;
+
+		/**
+		 * @post Crea el estimador con la cantidad especificada de
+		         muestras faltantes seguidas con las que se pierde el
+				 seguimiento, el desvío estándar del ruido de las muestras
+				 y de la aceleración, y la compuerta de las muestras atípicas
+		 */
+		KalmanEstimator(size_t maxMissingSamples, double measurementNoise = defaultMeasurementNoise, double accelerationNoise = defaultAccelerationNoise, double gate = defaultGate);
+
+		void update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) override;
+
+		boost::optional<DistanceSensor::Estimate> getEstimate() const override;
+
+	private:
+		/**
+		 * @post Empieza el seguimiento en la distancia especificada,
+		         sin velocidad conocida
+		 */
+		void initialize(std::chrono::steady_clock::time_point timestamp, double distance);
+
+		/**
+		 * @post Predice el estado hasta el instante especificado
+		 */
+		void predict(std::chrono::steady_clock::time_point timestamp);
+
+		const size_t maxMissingSamples_m;
+		const double measurementVariance_m;
+		const double accelerationVariance_m;
+		const double gate_m;
+
+		bool isTracking_m; // Si hay seguimiento
+		std::chrono::steady_clock::time_point timestamp_m; // Instante del estado
+
+		double distance_m;
+		double velocity_m;
+
+		// Covarianza del estado (Simétrica)
+		double distanceVariance_m;
+		double covariance_m;
+		double velocityVariance_m;
+
+		size_t missingSamples_m; // Muestras faltantes seguidas
+		unsigned int consecutiveOutliers_m; // Muestras atípicas seguidas
+	};
+}
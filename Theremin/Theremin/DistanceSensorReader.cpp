@@ -34,11 +34,13 @@
 #include "CPSSched.h"
 
 #include <cmath>
+#include <stdexcept>
+#include <algorithm>
 
 DistanceSensor::Reader::Reader(DistanceSensor::Configuration configuration) :
-	echoGPIO_m(configuration.getEchoId()),
-	triggerGPIO_m(configuration.getTriggerId()),
-	speedOfSound_m(331.3 + sqrt(1 + (configuration.getExpectedTemperature() / 273.15))),
+	echoGPIO_m(*configuration.getGPIOBackend(), configuration.getEchoId()),
+	triggerGPIO_m(*configuration.getGPIOBackend(), configuration.getTriggerId()),
+	speedOfSound_m(331.3 * sqrt(1 + (configuration.getExpectedTemperature() / 273.15))),
 	maxWaveTravelTime_m(
 		std::chrono::duration_cast<std::chrono::steady_clock::duration>(
 			std::chrono::nanoseconds(
@@ -46,9 +48,22 @@ DistanceSensor::Reader::Reader(DistanceSensor::Configuration configuration) :
 			)
 		)
 	),
-	numberOfSamples_m(configuration.getNumberOfSamples())
+	numberOfSamples_m(configuration.getNumberOfSamples()),
+	echoDetection_m(DistanceSensor::Reader::selectEchoDetection(configuration, this->echoGPIO_m)),
+	sampling_m(configuration.getSampling()),
+	maxNumberOfSamples_m(configuration.getMaxNumberOfSamples()),
+	sampleTolerance_m(configuration.getSampleTolerance()),
+	echoBank_m(configuration.getEchoBank()),
+	echoFd_m(this->echoGPIO_m.getFileDescriptor()),
+	clock_m(this->echoGPIO_m.getBackend().getClock()),
+	estimator_m(DistanceSensor::Estimator::create(configuration)),
+	stateMachine_m(this)
 {
 	this->isInitialized_m = false;
+
+	if (this->echoBank_m != nullptr) {
+		this->echoBankIndex_m = this->echoBank_m->add(this->echoGPIO_m);
+	}
 }
 
 DistanceSensor::Reader::~Reader() {
@@ -56,173 +71,373 @@ DistanceSensor::Reader::~Reader() {
 }
 
 Cont DistanceSensor::Reader::read(PCont<boost::optional<double>> pcont) {
-	// Mquina de estados
-	struct States {
-		// Hace las preparaciones previas
-		static Cont prepare(DistanceSensor::Reader *reader) {
-			// Preparar el estado de las muestras
-			reader->accumulatedSamples_m.clear();
-			reader->pendingNumberOfSamples_m = reader->numberOfSamples_m;
-
-			// Si est inicializado pasa directamente al estado de poner en alto el pin de trigger
-			if (reader->isInitialized_m) {
-				return Cont(setTriggerHigh, reader);
-			}
-			else {
-				// Caso contrario primero pasa al estado de inicializacin
-				return Cont(startInitialization, reader);
-			}
+	this->distancePCont_m = pcont;
+
+	return this->stateMachine_m.start(State::start);
+}
+
+boost::optional<DistanceSensor::Estimate> DistanceSensor::Reader::getEstimate() const {
+	return this->estimator_m->getEstimate();
+}
+
+DistanceSensor::Reader::StateMachine::Transition DistanceSensor::Reader::step(State state) {
+	switch (state) {
+	case State::start:
+		// Preparar el estado de las muestras, con muestreo deslizante se conservan las de las lecturas anteriores
+		switch (this->sampling_m) {
+		case DistanceSensor::Sampling::batch:
+			this->estimator_m->startBatch();
+			this->pendingNumberOfSamples_m = this->numberOfSamples_m;
+			break;
+		case DistanceSensor::Sampling::sliding:
+			this->pendingNumberOfSamples_m = 1;
+			break;
+		case DistanceSensor::Sampling::adaptive:
+			this->estimator_m->startBatch();
+			this->pendingNumberOfSamples_m = this->maxNumberOfSamples_m;
+			this->agreeingSamples_m = 0;
+			break;
 		}
 
-		// Realiza la inicializacin de los pines, para que queden en un estado definido
-		static Cont startInitialization(DistanceSensor::Reader *reader) {
-			reader->echoGPIO_m.setDirection(GPIO::Direction::in);
-			reader->triggerGPIO_m.setDirection(GPIO::Direction::out);
-			reader->triggerGPIO_m.write(false);
+		this->takenNumberOfSamples_m = 0;
 
-			// Esperar 500 milisegundos y pasar al siguiente estado
-			return CPSSched::waitFor(
-				std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::milliseconds(500)),
-				Cont(endInitialization, reader)
-			);
+		// Si no está inicializado inicializar los pines, para que queden en un estado definido
+		if (!this->isInitialized_m) {
+			this->echoGPIO_m.setDirection(GPIO::Direction::in);
+			this->triggerGPIO_m.setDirection(GPIO::Direction::out);
+			this->triggerGPIO_m.write(false);
+
+			if (this->echoDetection_m == DistanceSensor::EchoDetection::edge) {
+				this->echoGPIO_m.setEdge(GPIO::Edge::both);
+			}
+
+			return StateMachine::waitFor(std::chrono::milliseconds(500), State::initialized);
 		}
 
-		// Finaliza la inicializacin
-		static Cont endInitialization(DistanceSensor::Reader *reader) {
-			reader->isInitialized_m = true;
+		return StateMachine::go(State::triggerHigh);
+
+	case State::initialized:
+		this->isInitialized_m = true;
+
+		return StateMachine::go(State::triggerHigh);
 
-			return Cont(setTriggerHigh, reader);
+	case State::triggerHigh:
+		if (this->pendingNumberOfSamples_m <= 0) {
+			return StateMachine::go(State::finish);
 		}
 
-		// Setea en alto el pin de trigger
-		static Cont setTriggerHigh(DistanceSensor::Reader *reader) {
-			reader->triggerGPIO_m.write(true);
+		// Descartar eventos de flanco de ecos anteriores
+		if (this->echoDetection_m == DistanceSensor::EchoDetection::edge) {
+			this->echoGPIO_m.discardEdgeEvents();
+		}
 
-			reader->triggerHighTimestamp_m = std::chrono::steady_clock::now();
+		this->echoLowTimestamp_m = boost::optional<std::chrono::steady_clock::time_point>();
+		this->echoHighTimestamp_m = boost::optional<std::chrono::steady_clock::time_point>();
 
-			// Esperar 10 microsegundos y pasar al siguiente estado
-			return CPSSched::waitFor(
-				std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(10)),
-				Cont(setTriggerLow, reader)
-			);
+		// Emitir el impulso, con el pin 'trigger' en alto durante 10 microsegundos
+		this->triggerGPIO_m.write(true);
+
+		this->triggerHighTimestamp_m = this->clock_m.now();
+
+		// Bajar el 'trigger' es crítico en tiempo, con plazo en el mismo instante en el que se cumple la espera
+		return StateMachine::waitFor(std::chrono::microseconds(10), std::chrono::microseconds(10), State::triggerLow);
+
+	case State::triggerLow:
+		this->triggerGPIO_m.write(false);
+
+		switch (this->echoDetection_m) {
+		case DistanceSensor::EchoDetection::edge:
+			return StateMachine::go(State::waitRisingEdge);
+		case DistanceSensor::EchoDetection::asyncPolling:
+			return StateMachine::asyncRead(this->echoFd_m, this->echoValueBuffer_m, sizeof(this->echoValueBuffer_m), 0, State::readRisingEcho);
+		default:
+			// La primera muestra del 'echo' se toma en seguida, sin pasar por el scheduler
+			return StateMachine::go(State::pollRisingEcho);
 		}
 
-		// Setear en bajo el pin de trigger
-		static Cont setTriggerLow(DistanceSensor::Reader *reader) {
-			reader->triggerGPIO_m.write(false);
-			return Cont(waitForHighEcho, reader);
+	case State::pollRisingEcho:
+		return this->onRisingEcho(this->sampleEcho());
+
+	case State::readRisingEcho:
+		return this->onRisingEcho(this->asyncEchoLevel(this->stateMachine_m.getResult()));
+
+	case State::pollFallingEcho:
+		return this->onFallingEcho(this->sampleEcho());
+
+	case State::readFallingEcho:
+		return this->onFallingEcho(this->asyncEchoLevel(this->stateMachine_m.getResult()));
+
+	/*
+	 * Esperar los flancos del pin 'echo' por evento.
+	 *
+	 * ATENCIÓN: Si el pin no tiene descriptor de eventos de flanco
+	 *           bloquea el thread durante la espera, con lo cual
+	 *           serializa las mediciones de los sensores que
+	 *           compartan el scheduler
+	 */
+	case State::waitRisingEdge:
+		return this->waitForEchoEdge(this->triggerHighTimestamp_m + this->maxWaveTravelTime_m, State::risingEdgeReady);
+
+	case State::risingEdgeReady:
+		// Si fue un aviso espurio seguir esperando
+		if (!this->takeEchoEdge()) {
+			return StateMachine::go(State::waitRisingEdge);
 		}
 
-		// Esperar a que el pin 'echo' se ponga en alto
-		static Cont waitForHighEcho(DistanceSensor::Reader *reader) {
-			std::chrono::steady_clock::time_point currentTimestamp = std::chrono::steady_clock::now();
-
-			// Si no super el tiempo mximo
-			if (currentTimestamp - reader->triggerHighTimestamp_m <= reader->maxWaveTravelTime_m) {
-				// Si lleg el flanco ascendente del 'echo'
-				if (reader->echoGPIO_m.read()) {
-					// Almacenar el timestamp del flanco ascendente
-					reader->echoHighTimestamp_m = currentTimestamp;
-
-					// Pasar a estado siguiente
-					return Cont(waitForLowEcho, reader);
-				}
-				else { // Si todava no lleg
-					// Almacenar el timestamp de la ltima vez que se detect el pin 'echo' en bajo
-					reader->echoLowTimestamp_m = currentTimestamp;
-
-					// Y volver al mismo estado, cediendo CPU antes a otros 'green threads'
-					return CPSSched::yield(
-						Cont(waitForHighEcho, reader)
-					);
-				}
-			}
-			else {
-				// Caso contrario dejar en vaco el timestamp del flanco ascendente de 'echo' , porque no se detect
-				reader->echoHighTimestamp_m = boost::optional<std::chrono::steady_clock::time_point>();
+		// Si no llegó el eco en el tiempo máximo descartar la muestra
+		if (!this->echoEdgeEvent_m.is_initialized()) {
+			return StateMachine::go(State::storeSample);
+		}
 
-				// Pasar a estado siguiente
-				return Cont(waitForLowEcho, reader);
-			}
+		// Si es el flanco ascendente almacenar su timestamp (Caso contrario es un flanco descendente de un eco anterior)
+		if (this->echoEdgeEvent_m->value()) {
+			this->echoLowTimestamp_m = this->echoEdgeEvent_m->timestamp();
+
+			return StateMachine::go(State::waitFallingEdge);
 		}
 
-		// Esperar a que el pin 'echo' se ponga en bajo
-		static Cont waitForLowEcho(DistanceSensor::Reader *reader) {
-			if (reader->echoGPIO_m.read()) {
-				reader->echoHighTimestamp_m = std::chrono::steady_clock::now();
+		return StateMachine::go(State::waitRisingEdge);
 
-				// Volver al mismo estado, cediendo CPU antes a otros 'green threads' 
-				return CPSSched::yield(
-					Cont(waitForLowEcho, reader)
-				);
-			}
-			else {
-				// Pasar a estado siguiente
-				return Cont(readSample, reader);
-			}
+	case State::waitFallingEdge:
+		return this->waitForEchoEdge(*this->echoLowTimestamp_m + this->maxWaveTravelTime_m, State::fallingEdgeReady);
+
+	case State::fallingEdgeReady:
+		if (!this->takeEchoEdge()) {
+			return StateMachine::go(State::waitFallingEdge);
 		}
 
-		// Leer muestra
-		static Cont readSample(DistanceSensor::Reader *reader) {
-			if (reader->echoHighTimestamp_m.is_initialized() && reader->echoLowTimestamp_m.is_initialized()) {
-				auto timeDelta = *reader->echoHighTimestamp_m - *reader->echoLowTimestamp_m; // Calcular delta de tiempo
+		// Si el pulso supera la distancia máxima descartar la muestra
+		if (!this->echoEdgeEvent_m.is_initialized()) {
+			return StateMachine::go(State::storeSample);
+		}
 
-				if (timeDelta <= reader->maxWaveTravelTime_m) {
-					// Guardar la muestra
-					reader->accumulatedSamples_m.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeDelta));
-				}
-			}
+		if (!this->echoEdgeEvent_m->value()) {
+			this->echoHighTimestamp_m = this->echoEdgeEvent_m->timestamp();
 
-			reader->pendingNumberOfSamples_m--;
+			return StateMachine::go(State::storeSample);
+		}
 
-			// Si hay muestras pendientes volver a repetir la secuencia de deteccin
-			if (reader->pendingNumberOfSamples_m > 0) {
-				return Cont(setTriggerHigh, reader);
-			}
-			else {
-				// Caso contrario pasar al estado siguiente
-				return Cont(calculateDistance, reader);
+		return StateMachine::go(State::waitFallingEdge);
+
+	case State::storeSample:
+	{
+		// Las muestras que faltan también se informan al estimador
+		boost::optional<double> sample;
+		std::chrono::steady_clock::time_point sampleTimestamp = this->triggerHighTimestamp_m;
+
+		if (this->echoHighTimestamp_m.is_initialized() && this->echoLowTimestamp_m.is_initialized()) {
+			auto timeDelta = *this->echoHighTimestamp_m - *this->echoLowTimestamp_m; // Calcular delta de tiempo
+
+			if (timeDelta <= this->maxWaveTravelTime_m) {
+				sample = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(timeDelta).count() * this->speedOfSound_m / 2.0 / 1000000000.0;
+
+				// La distancia corresponde al instante en que la onda llegó a la mano, a mitad del viaje
+				sampleTimestamp = *this->echoLowTimestamp_m + timeDelta / 2;
 			}
+		}
+
+		this->estimator_m->update(sampleTimestamp, sample);
 
+		this->takenNumberOfSamples_m++;
+		this->pendingNumberOfSamples_m--;
+
+		// Con muestreo adaptativo terminar antes si las últimas muestras coinciden
+		if ((this->sampling_m == DistanceSensor::Sampling::adaptive) && this->updateAgreement(sample)) {
+			this->pendingNumberOfSamples_m = 0;
 		}
+	}
 
-		// Calcular distancia
-		static Cont calculateDistance(DistanceSensor::Reader *reader) {
-			boost::optional<double> distance;
+		return StateMachine::go(State::triggerHigh);
 
-			/*
-			 * Si hay muestras calcula la mediana entre las muestras de distancia
-			 */
-			if (reader->accumulatedSamples_m.size() > 0) {
-				double timePassed;
+	case State::finish:
+		this->numberOfSamplesHistogram_m.record((uint64_t)this->takenNumberOfSamples_m);
+		break;
+	}
 
-				std::sort(reader->accumulatedSamples_m.begin(), reader->accumulatedSamples_m.end());
+	return StateMachine::exit(this->distancePCont_m.invoke(this->calculateDistance()));
+}
 
-				if (reader->accumulatedSamples_m.size() == 1) {
-					timePassed = (double)reader->accumulatedSamples_m[0].count();
-				}
-				else if (reader->accumulatedSamples_m.size() % 2 == 1) {
-					timePassed = (double)reader->accumulatedSamples_m[reader->accumulatedSamples_m.size() / 2].count();
-				}
-				else {
-					size_t index = reader->accumulatedSamples_m.size() / 2;
+DistanceSensor::Reader::StateMachine::Transition DistanceSensor::Reader::onRisingEcho(GPIO::Level echoLevel) {
+	const bool asyncPolling = (this->echoDetection_m == DistanceSensor::EchoDetection::asyncPolling);
 
-					timePassed = (double)(reader->accumulatedSamples_m[index - 1].count() + reader->accumulatedSamples_m[index].count()) / 2;
-				}
+	// Si superó el tiempo máximo no se detectó el flanco ascendente
+	if (echoLevel.timestamp() - this->triggerHighTimestamp_m > this->maxWaveTravelTime_m) {
+		return StateMachine::go(State::storeSample);
+	}
 
-				distance = timePassed * reader->speedOfSound_m / 2.0 / 1000000000.0;
-			}
+	// Si llegó el flanco ascendente del 'echo' almacenar su timestamp, y esperar el descendente
+	if (echoLevel.value()) {
+		this->echoHighTimestamp_m = echoLevel.timestamp();
 
-			// Pasar el control al invocador, indicando la distancia
-			return reader->distancePCont_m.invoke(distance);
+		if (asyncPolling) {
+			return StateMachine::asyncRead(this->echoFd_m, this->echoValueBuffer_m, sizeof(this->echoValueBuffer_m), 0, State::readFallingEcho);
+		}
+		else {
+			return StateMachine::go(State::pollFallingEcho);
 		}
-	};
+	}
 
-	// Setea la continuacin de notificacin de distancia
-	this->distancePCont_m = pcont;
+	// Si todavía no llegó almacenar el timestamp de la última vez que se detectó el pin 'echo' en bajo
+	this->echoLowTimestamp_m = echoLevel.timestamp();
+
+	if (asyncPolling) {
+		return StateMachine::asyncRead(this->echoFd_m, this->echoValueBuffer_m, sizeof(this->echoValueBuffer_m), 0, State::readRisingEcho);
+	}
+	else {
+		/*
+		 * Seguir muestreando sin plazo: con plazo se ejecutaría antes que todas las
+		 * continuaciones sin plazo durante toda la ventana de eco, y no dejaría
+		 * avanzar a otros lectores ni a la bandeja de entrada
+		 */
+		return StateMachine::yield(State::pollRisingEcho);
+	}
+}
+
+DistanceSensor::Reader::StateMachine::Transition DistanceSensor::Reader::onFallingEcho(GPIO::Level echoLevel) {
+	if (!echoLevel.value()) {
+		return StateMachine::go(State::storeSample);
+	}
+
+	this->echoHighTimestamp_m = echoLevel.timestamp();
+
+	if (this->echoDetection_m == DistanceSensor::EchoDetection::asyncPolling) {
+		return StateMachine::asyncRead(this->echoFd_m, this->echoValueBuffer_m, sizeof(this->echoValueBuffer_m), 0, State::readFallingEcho);
+	}
+	else {
+		return StateMachine::yield(State::pollFallingEcho);
+	}
+}
+
+DistanceSensor::Reader::StateMachine::Transition DistanceSensor::Reader::waitForEchoEdge(std::chrono::steady_clock::time_point deadline, State readyState) {
+	const int edgeFd = this->echoGPIO_m.getEdgeFileDescriptor();
+
+	if (edgeFd < 0) {
+		this->echoEdgeEvent_m = this->echoGPIO_m.waitForEdge(deadline - this->clock_m.now());
+
+		return StateMachine::go(readyState);
+	}
+
+	auto remainingTime = deadline - this->clock_m.now();
+
+	if (remainingTime < std::chrono::steady_clock::duration::zero()) {
+		remainingTime = std::chrono::steady_clock::duration::zero();
+	}
+
+	// Esperar a que haya un evento de flanco pendiente, sin bloquear a las demás continuaciones
+	return StateMachine::waitAny(edgeFd, this->echoGPIO_m.getEdgeFileDescriptorEvents(), remainingTime, readyState);
+}
+
+bool DistanceSensor::Reader::takeEchoEdge() {
+	// Sin descriptor la espera ya tomó el evento
+	if (this->echoGPIO_m.getEdgeFileDescriptor() < 0) {
+		return true;
+	}
+
+	// Se cumplió el tiempo
+	if (this->stateMachine_m.getResult() == 0) {
+		this->echoEdgeEvent_m = boost::optional<GPIO::EdgeEvent>();
+
+		return true;
+	}
+
+	this->echoEdgeEvent_m = this->echoGPIO_m.waitForEdge(std::chrono::steady_clock::duration::zero());
+
+	return this->echoEdgeEvent_m.is_initialized();
+}
+
+CPSHistogram::Snapshot DistanceSensor::Reader::getNumberOfSamplesStatistics() const {
+	return this->numberOfSamplesHistogram_m.getSnapshot();
+}
+
+std::chrono::steady_clock::time_point DistanceSensor::Reader::getEchoWindowEnd() const {
+	// El flanco ascendente del 'echo' marca el fin de la ráfaga, desde ahí vuelven los ecos
+	if (this->echoLowTimestamp_m.is_initialized()) {
+		return *this->echoLowTimestamp_m + this->maxWaveTravelTime_m;
+	}
+	else {
+		// Si no se detectó, el sensor pudo emitir hasta el tiempo máximo de espera del flanco ascendente
+		return this->triggerHighTimestamp_m + this->maxWaveTravelTime_m * 2;
+	}
+}
+
+bool DistanceSensor::Reader::updateAgreement(boost::optional<double> sample) {
+	// Una muestra faltante corta la racha
+	if (!sample.is_initialized()) {
+		this->agreeingSamples_m = 0;
+
+		return false;
+	}
+
+	if (this->agreeingSamples_m == 0) {
+		this->agreeingMinDistance_m = *sample;
+		this->agreeingMaxDistance_m = *sample;
+	}
+	else {
+		this->agreeingMinDistance_m = std::min(this->agreeingMinDistance_m, *sample);
+		this->agreeingMaxDistance_m = std::max(this->agreeingMaxDistance_m, *sample);
+	}
+
+	// Si la muestra se aleja de las anteriores empezar una racha nueva con ella
+	if (this->agreeingMaxDistance_m - this->agreeingMinDistance_m > this->sampleTolerance_m) {
+		this->agreeingSamples_m = 1;
+		this->agreeingMinDistance_m = *sample;
+		this->agreeingMaxDistance_m = *sample;
+	}
+	else {
+		this->agreeingSamples_m++;
+	}
+
+	return (this->agreeingSamples_m >= agreeingNumberOfSamples);
+}
+
+boost::optional<double> DistanceSensor::Reader::calculateDistance() {
+	boost::optional<double> distance;
+
+	boost::optional<DistanceSensor::Estimate> estimate = this->estimator_m->getEstimate();
+
+	if (estimate.is_initialized()) {
+		distance = estimate->distance;
+	}
+
+	return distance;
+}
+
+GPIO::Level DistanceSensor::Reader::sampleEcho() {
+	if (this->echoBank_m != nullptr) {
+		// La muestra tiene que ser posterior al disparo, sino podría corresponder al eco anterior
+		return this->echoBank_m->read(this->echoBankIndex_m, this->triggerHighTimestamp_m);
+	}
+	else {
+		std::chrono::steady_clock::time_point timestamp = this->clock_m.now();
+
+		return GPIO::Level(timestamp, this->echoGPIO_m.read());
+	}
+}
+
+GPIO::Level DistanceSensor::Reader::asyncEchoLevel(ssize_t result) {
+	std::chrono::steady_clock::time_point timestamp = this->clock_m.now();
+
+	if (result <= 0) {
+		throw std::runtime_error("Cannot read echo gpio value");
+	}
+
+	return GPIO::Level(timestamp, this->echoValueBuffer_m[0] == '1');
+}
+
+DistanceSensor::EchoDetection DistanceSensor::Reader::selectEchoDetection(DistanceSensor::Configuration& configuration, GPIO::Handler& echoGPIO) {
+	DistanceSensor::EchoDetection echoDetection = configuration.getEchoDetection();
+
+	// Si el backend no soporta eventos de flanco se usa polling
+	if ((echoDetection == DistanceSensor::EchoDetection::edge) && !echoGPIO.supportsEdgeEvents()) {
+		echoDetection = DistanceSensor::EchoDetection::polling;
+	}
+
+	// Si no se puede leer el pin directamente del archivo, o se comparte la lectura con otros pines, se usa polling
+	if ((echoDetection == DistanceSensor::EchoDetection::asyncPolling) && ((echoGPIO.getFileDescriptor() < 0) || (configuration.getEchoBank() != nullptr))) {
+		echoDetection = DistanceSensor::EchoDetection::polling;
+	}
 
-	// Salta al estado de preparacin
-	return States::prepare(this);
+	return echoDetection;
 }
 
 #if 0
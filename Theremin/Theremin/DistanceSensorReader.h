@@ -33,21 +33,27 @@
 #pragma once
 
 #include "Cont.h"
+#include "CPSStateMachine.h"
 #include "DistanceSensorConfiguration.h"
+#include "DistanceSensorEstimator.h"
+#include "CPSHistogram.h"
 #include "GPIO.h"
 
 #include <chrono>
 #include <vector>
+#include <memory>
 
 #include <boost/optional.hpp>
 
+#include <sys/types.h>
+
 namespace DistanceSensor {
 	class Reader final
 	{
 	public:
 		/**
 		 * @post Crea un lector de distancia con la
-		        configuracin especificada
+		        configuración especificada
 		 */
 		Reader(DistanceSensor::Configuration configuration);
 
@@ -57,31 +63,158 @@ namespace DistanceSensor {
 		~Reader();
 
 		/**
-		 * @post Lee el sensor con la continuacin
+		 * @post Lee el sensor con la continuación
 		         parametrizada, que indica la distancia
-		         detectada
+		         detectada.
+				 Con muestreo deslizante toma una sola muestra,
+				 y la distancia es la de las últimas muestras
 		 */
 		Cont read(PCont<boost::optional<double>> pcont);
 
+		/**
+		 * @post Devuelve la estimación de la última lectura,
+		         con la velocidad si el estimador la calcula
+		 */
+		boost::optional<DistanceSensor::Estimate> getEstimate() const;
+
+		/**
+		 * @post Devuelve el histograma de la cantidad de muestras tomadas
+		         en cada lectura, desde cualquier thread
+		 */
+		CPSHistogram::Snapshot getNumberOfSamplesStatistics() const;
+
+		/**
+		 * @post Devuelve el instante en que se cierra la ventana de eco
+		         de la última muestra: hasta entonces pueden volver
+				 reflexiones del pulso dentro de la distancia máxima,
+				 que otro sensor cercano tomaría como eco propio
+		 */
+		std::chrono::steady_clock::time_point getEchoWindowEnd() const;
+
+		// Muestras consecutivas que tienen que coincidir para terminar antes una lectura adaptativa
+		static const int agreeingNumberOfSamples = 3;
+
 	private:
+		// Estados de la lectura
+		enum class State {
+			start, // Empieza la lectura
+			initialized, // Terminó la inicialización de los pines
+			triggerHigh, // Emite el impulso de la siguiente muestra
+			triggerLow, // Termina el impulso
+			pollRisingEcho, // Lee el pin 'echo' esperando el flanco ascendente
+			readRisingEcho, // Terminó la lectura asíncrona del pin 'echo' esperando el flanco ascendente
+			pollFallingEcho, // Lee el pin 'echo' esperando el flanco descendente
+			readFallingEcho, // Terminó la lectura asíncrona del pin 'echo' esperando el flanco descendente
+			waitRisingEdge, // Espera el evento del flanco ascendente del pin 'echo'
+			risingEdgeReady, // Hay un evento de flanco pendiente (O se cumplió el tiempo) esperando el flanco ascendente
+			waitFallingEdge, // Espera el evento del flanco descendente del pin 'echo'
+			fallingEdgeReady, // Hay un evento de flanco pendiente (O se cumplió el tiempo) esperando el flanco descendente
+			storeSample, // Guarda la muestra
+			finish // Calcula la distancia y termina
+		};
+
+		typedef CPSStateMachine<DistanceSensor::Reader, State> StateMachine;
+
+		friend class CPSStateMachine<DistanceSensor::Reader, State>;
+
+		/**
+		 * @post Ejecuta el estado especificado, y devuelve la
+		         transición al siguiente
+		 */
+		StateMachine::Transition step(State state);
+
+		/**
+		 * @post Procesa el nivel del pin 'echo' esperando el flanco ascendente
+		 */
+		StateMachine::Transition onRisingEcho(GPIO::Level echoLevel);
+
+		/**
+		 * @post Procesa el nivel del pin 'echo' esperando el flanco descendente
+		 */
+		StateMachine::Transition onFallingEcho(GPIO::Level echoLevel);
+
+		/**
+		 * @post Espera un evento de flanco del pin 'echo' hasta el instante
+		         especificado, y sigue con el estado especificado. Si el pin
+				 no tiene descriptor de eventos de flanco bloquea el thread
+				 durante la espera
+		 */
+		StateMachine::Transition waitForEchoEdge(std::chrono::steady_clock::time_point deadline, State readyState);
+
+		/**
+		 * @post Toma el evento de flanco del pin 'echo' después de la espera,
+		         dejándolo en echoEdgeEvent_m (Vacío si se cumplió el tiempo).
+				 Devuelve falso si fue un aviso espurio y hay que seguir esperando
+		 */
+		bool takeEchoEdge();
+
+		/**
+		 * @post Actualiza las muestras consecutivas que coinciden dentro
+		         de la tolerancia con la muestra especificada (Vacía si
+				 falta), y devuelve si ya alcanzan para terminar la lectura
+		 */
+		bool updateAgreement(boost::optional<double> sample);
+
+		/**
+		 * @post Calcula la distancia con el estimador
+		 */
+		boost::optional<double> calculateDistance();
+
+		/**
+		 * @post Lee el pin 'echo', directamente o a través
+		         del conjunto de pines compartido
+		 */
+		GPIO::Level sampleEcho();
+
+		/**
+		 * @post Devuelve el nivel del pin 'echo' leído asincrónicamente,
+		         dado el resultado de la lectura
+		 */
+		GPIO::Level asyncEchoLevel(ssize_t result);
+
+		/**
+		 * @post Devuelve el modo de detección del pin 'echo' a usar,
+		         según lo que soporte el pin
+		 */
+		static DistanceSensor::EchoDetection selectEchoDetection(DistanceSensor::Configuration& configuration, GPIO::Handler& echoGPIO);
+
 		GPIO::Handler echoGPIO_m;
 		GPIO::Handler triggerGPIO_m;
 
 		bool isInitialized_m; // Indica si fue inicializado
 
 		const double speedOfSound_m; // Velocidad del sonido
-		const std::chrono::steady_clock::duration maxWaveTravelTime_m; // Mximo tiempo que tarda en volver el impulso emitido por el sensor en cada lectura
-		const int numberOfSamples_m; // Nmero de muestras a usar por cada lectura del sensor
+		const std::chrono::steady_clock::duration maxWaveTravelTime_m; // Máximo tiempo que tarda en volver el impulso emitido por el sensor en cada lectura
+		const int numberOfSamples_m; // Número de muestras a usar por cada lectura del sensor
+		const DistanceSensor::EchoDetection echoDetection_m; // Modo de detección del pin 'echo'
+		const DistanceSensor::Sampling sampling_m; // Muestreo de cada lectura
+		const int maxNumberOfSamples_m; // Máximo número de muestras de cada lectura adaptativa
+		const double sampleTolerance_m; // Tolerancia en metros con la que coinciden las muestras de una lectura adaptativa
 
-		std::vector<std::chrono::nanoseconds> accumulatedSamples_m; // Muestras acumuladas en el proceso de lectura de un nuevo valor del sensor
+		GPIO::Bank * const echoBank_m; // Conjunto de pines en el que se muestrea el pin 'echo' (Opcional)
+		size_t echoBankIndex_m; // Índice del pin 'echo' en el conjunto
+		int echoFd_m; // Descriptor del archivo de valor del pin 'echo', para la lectura asíncrona
+		char echoValueBuffer_m[2]; // Buffer de la lectura asíncrona del pin 'echo'
 
-		int pendingNumberOfSamples_m;
+		Clock& clock_m; // Base de tiempo de los timestamps (La del backend de GPIO)
 
-		std::chrono::steady_clock::time_point triggerHighTimestamp_m; // Timestamp del flanco ascendente del pin 'trigger'
-		boost::optional<std::chrono::steady_clock::time_point> echoLowTimestamp_m; // Timestamp de la ltima vez en que estuvo el pin 'echo' en bajo
-		boost::optional<std::chrono::steady_clock::time_point> echoHighTimestamp_m; // Timestamp de la ltima vez en que estuvo el pin 'echo' en alto
+		std::unique_ptr<DistanceSensor::Estimator> estimator_m; // Estimador de la distancia, con las muestras del lote de la lectura actual o las de la ventana deslizante
+
+		StateMachine stateMachine_m;
+		PCont<boost::optional<double>> distancePCont_m; // Continuación con la distancia detectada
+		int pendingNumberOfSamples_m; // Muestras que faltan tomar
+		int takenNumberOfSamples_m; // Muestras tomadas en la lectura actual
+
+		int agreeingSamples_m; // Últimas muestras consecutivas que coinciden dentro de la tolerancia
+		double agreeingMinDistance_m; // Mínima distancia de las muestras que coinciden
+		double agreeingMaxDistance_m; // Máxima distancia de las muestras que coinciden
 
-		PCont<boost::optional<double>> distancePCont_m; // Continuacin para notificar la distancia despus de terminar la deteccin
+		CPSHistogram numberOfSamplesHistogram_m; // Cantidad de muestras tomadas en cada lectura
+
+		std::chrono::steady_clock::time_point triggerHighTimestamp_m; // Timestamp del flanco ascendente del pin 'trigger'
+		boost::optional<std::chrono::steady_clock::time_point> echoLowTimestamp_m; // Timestamp de la última vez en que estuvo el pin 'echo' en bajo
+		boost::optional<std::chrono::steady_clock::time_point> echoHighTimestamp_m; // Timestamp de la última vez en que estuvo el pin 'echo' en alto
+		boost::optional<GPIO::EdgeEvent> echoEdgeEvent_m; // Evento de flanco del pin 'echo' tomado después de la espera
 	};
 }
 
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorSlidingMedian.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+DistanceSensor::SlidingMedian::SlidingMedian(size_t windowSize) :
+	window_m(windowSize),
+	sortedSamples_m(windowSize)
+{
+	if (windowSize == 0) {
+		throw std::runtime_error("Invalid window size");
+	}
+
+	this->nextIndex_m = 0;
+	this->numberOfSamples_m = 0;
+	this->numberOfValidSamples_m = 0;
+}
+
+void DistanceSensor::SlidingMedian::push(boost::optional<double> sample) {
+	boost::optional<double>& slot = this->window_m[this->nextIndex_m];
+
+	// Si la ventana está llena la posición tiene la muestra más vieja
+	if (this->numberOfSamples_m == this->window_m.size()) {
+		if (slot.is_initialized()) {
+			this->removeSorted(*slot);
+		}
+	}
+	else {
+		this->numberOfSamples_m++;
+	}
+
+	slot = sample;
+
+	if (sample.is_initialized()) {
+		this->insertSorted(*sample);
+	}
+
+	if (++this->nextIndex_m == this->window_m.size()) {
+		this->nextIndex_m = 0;
+	}
+}
+
+void DistanceSensor::SlidingMedian::clear() {
+	this->nextIndex_m = 0;
+	this->numberOfSamples_m = 0;
+	this->numberOfValidSamples_m = 0;
+}
+
+boost::optional<double> DistanceSensor::SlidingMedian::getMedian() const {
+	boost::optional<double> median;
+
+	const size_t size = this->numberOfValidSamples_m;
+
+	if (size > 0) {
+		if (size % 2 == 1) {
+			median = this->sortedSamples_m[size / 2];
+		}
+		else {
+			size_t index = size / 2;
+
+			median = (this->sortedSamples_m[index - 1] + this->sortedSamples_m[index]) / 2;
+		}
+	}
+
+	return median;
+}
+
+boost::optional<double> DistanceSensor::SlidingMedian::getTrimmedMean(double trimFraction) const {
+	boost::optional<double> mean;
+
+	const size_t size = this->numberOfValidSamples_m;
+
+	if (size > 0) {
+		const size_t trimmed = std::min((size_t)(size * std::max(trimFraction, 0.0)), (size - 1) / 2);
+
+		double sum = 0;
+
+		for (size_t i = trimmed; i < size - trimmed; i++) {
+			sum += this->sortedSamples_m[i];
+		}
+
+		mean = sum / (double)(size - 2 * trimmed);
+	}
+
+	return mean;
+}
+
+size_t DistanceSensor::SlidingMedian::getNumberOfValidSamples() const {
+	return this->numberOfValidSamples_m;
+}
+
+void DistanceSensor::SlidingMedian::removeSorted(double sample) {
+	auto begin = this->sortedSamples_m.begin();
+	auto end = begin + this->numberOfValidSamples_m;
+
+	auto position = std::lower_bound(begin, end, sample);
+
+	std::move(position + 1, end, position);
+
+	this->numberOfValidSamples_m--;
+}
+
+void DistanceSensor::SlidingMedian::insertSorted(double sample) {
+	auto begin = this->sortedSamples_m.begin();
+	auto end = begin + this->numberOfValidSamples_m;
+
+	auto position = std::upper_bound(begin, end, sample);
+
+	std::move_backward(position, end, end + 1);
+	*position = sample;
+
+	this->numberOfValidSamples_m++;
+}
\ No newline at end of file
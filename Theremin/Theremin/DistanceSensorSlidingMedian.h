@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/optional.hpp>
+
+namespace DistanceSensor {
+	/*
+	 * Mediana de las últimas muestras de distancia (Ventana deslizante).
+	 *
+	 * Cada muestra puede faltar (No llegó el eco, o llegó tarde), y ocupa
+	 * igual su lugar en la ventana, así la mediana es la de las muestras
+	 * válidas entre las últimas N, como si se hubieran tomado juntas.
+	 *
+	 * Mantiene las muestras válidas ordenadas: al agregar una se quita
+	 * la más vieja y se inserta la nueva con búsqueda binaria, sin
+	 * reservar memoria, y la mediana se obtiene sin ordenar
+	 */
+	class SlidingMedian final
+	{
+	public:
+		/**
+		 * @post Crea la mediana con el tamaño de ventana especificado,
+		         sin muestras
+		 */
+		SlidingMedian(size_t windowSize);
+
+		/**
+		 * @post Agrega la muestra especificada (Vacía si falta),
+		         quitando la más vieja si la ventana está llena
+		 */
+		void push(boost::optional<double> sample);
+
+		/**
+		 * @post Quita todas las muestras
+		 */
+		void clear();
+
+		/**
+		 * @post Devuelve la mediana de las muestras válidas, o vacío
+		         si no hay ninguna. Con una cantidad par devuelve
+				 el promedio de las dos centrales
+		 */
+		boost::optional<double> getMedian() const;
+
+		/**
+		 * @post Devuelve el promedio de las muestras válidas descartando
+		         la fracción especificada de cada extremo (Media recortada),
+				 o vacío si no hay ninguna.
+				 Siempre quedan la muestra central, o las dos centrales,
+				 así con 0.5 es la mediana
+		 */
+		boost::optional<double> getTrimmedMean(double trimFraction) const;
+
+		/**
+		 * @post Devuelve la cantidad de muestras válidas en la ventana
+		 */
+		size_t getNumberOfValidSamples() const;
+
+	private:
+		/**
+		 * @post Quita la muestra especificada de las muestras ordenadas
+		 */
+		void removeSorted(double sample);
+
+		/**
+		 * @post Inserta la muestra especificada en las muestras ordenadas
+		 */
+		void insertSorted(double sample);
+
+		std::vector<boost::optional<double>> window_m; // Muestras en orden de llegada (Buffer circular)
+		size_t nextIndex_m; // Posición de la próxima muestra en la ventana
+		size_t numberOfSamples_m; // Muestras en la ventana, válidas o no
+
+		std::vector<double> sortedSamples_m; // Muestras válidas de la ventana, ordenadas
+		size_t numberOfValidSamples_m;
+	};
+}
@@ -46,12 +46,38 @@ Cont DistanceSensor::SynchronizedContext::update(Cont cont) {
 	);
 }
 
-Cont DistanceSensor::SynchronizedContext::updateDistance(DistanceSensor::SynchronizedContext *context, boost::optional<double> distance) {
-	context->distance_m.set(distance);
+Cont DistanceSensor::SynchronizedContext::updateDistance(DistanceSensor::SynchronizedContext *context, boost::optional<double>) {
+	context->estimate_m.set(context->sensorReader_m.getEstimate());
 	
 	return context->updateNextCont_m;
 }
 
 boost::optional<double> DistanceSensor::SynchronizedContext::getDistance() {
-	return this->distance_m.get();
+	boost::optional<DistanceSensor::Estimate> estimate = this->estimate_m.get();
+
+	if (estimate.is_initialized()) {
+		return estimate->distance;
+	}
+	else {
+		return boost::optional<double>();
+	}
+}
+
+boost::optional<double> DistanceSensor::SynchronizedContext::getDistance(std::chrono::steady_clock::time_point timestamp) {
+	boost::optional<DistanceSensor::Estimate> estimate = this->estimate_m.get();
+
+	if (estimate.is_initialized()) {
+		return estimate->extrapolate(timestamp);
+	}
+	else {
+		return boost::optional<double>();
+	}
+}
+
+boost::optional<DistanceSensor::Estimate> DistanceSensor::SynchronizedContext::getEstimate() {
+	return this->estimate_m.get();
+}
+
+std::chrono::steady_clock::time_point DistanceSensor::SynchronizedContext::getEchoWindowEnd() const {
+	return this->sensorReader_m.getEchoWindowEnd();
 }
\ No newline at end of file
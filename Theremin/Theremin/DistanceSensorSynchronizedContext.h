@@ -40,7 +40,7 @@ namespace DistanceSensor {
 	/*
 	 * Contexto sincronizado de sensor de distancia.
 	   
-	 * til cuando el sensor se lee en un thread,
+	 * Útil cuando el sensor se lee en un thread,
 	 * y se lee el resultado de la lectura en otro thread.
 	 */
 	class SynchronizedContext final
@@ -48,7 +48,7 @@ namespace DistanceSensor {
 	public:
 		/**
 		 * @post Crea un contexto sincronizado de sensor de distancia
-		         con la configuracin especificada
+		         con la configuración especificada
 		 */
 		SynchronizedContext(DistanceSensor::Configuration configuration);
 
@@ -62,6 +62,23 @@ namespace DistanceSensor {
 		*/
 		boost::optional<double> getDistance();
 
+		/**
+		* @post Lee la distancia extrapolada al instante especificado,
+		        si el estimador calcula la velocidad
+		*/
+		boost::optional<double> getDistance(std::chrono::steady_clock::time_point timestamp);
+
+		/**
+		* @post Lee la estimación
+		*/
+		boost::optional<DistanceSensor::Estimate> getEstimate();
+
+		/**
+		* @post Devuelve el instante en que se cierra la ventana de eco
+		        de la última lectura (Desde el thread que actualiza)
+		*/
+		std::chrono::steady_clock::time_point getEchoWindowEnd() const;
+
 	private:
 		/**
 		 * @post Actualiza la distancia con el valor especificado
@@ -69,7 +86,7 @@ namespace DistanceSensor {
 		static Cont updateDistance(DistanceSensor::SynchronizedContext *context, boost::optional<double> distance);
 
 		DistanceSensor::Reader sensorReader_m;
-		SynchronizedVariable<boost::optional<double>> distance_m;
+		SynchronizedVariable<boost::optional<DistanceSensor::Estimate>> estimate_m;
 
 		Cont updateNextCont_m;
 	};
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DistanceSensorWindowEstimator.h"
+
+#include <stdexcept>
+
+constexpr double DistanceSensor::WindowEstimator::medianTrimFraction;
+constexpr double DistanceSensor::WindowEstimator::defaultTrimFraction;
+
+DistanceSensor::WindowEstimator::WindowEstimator(size_t windowSize, double trimFraction) :
+	trimFraction_m(trimFraction),
+	samples_m(windowSize)
+{
+	if ((trimFraction < 0) || (trimFraction > medianTrimFraction)) {
+		throw std::runtime_error("Invalid trim fraction");
+	}
+}
+
+void DistanceSensor::WindowEstimator::startBatch() {
+	this->samples_m.clear();
+}
+
+void DistanceSensor::WindowEstimator::update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) {
+	this->samples_m.push(distance);
+	this->lastTimestamp_m = timestamp;
+}
+
+boost::optional<DistanceSensor::Estimate> DistanceSensor::WindowEstimator::getEstimate() const {
+	boost::optional<double> distance;
+
+	if (this->trimFraction_m == medianTrimFraction) {
+		distance = this->samples_m.getMedian();
+	}
+	else {
+		distance = this->samples_m.getTrimmedMean(this->trimFraction_m);
+	}
+
+	if (distance.is_initialized()) {
+		DistanceSensor::Estimate estimate;
+		estimate.timestamp = this->lastTimestamp_m;
+		estimate.distance = *distance;
+
+		return estimate;
+	}
+	else {
+		return boost::optional<DistanceSensor::Estimate>();
+	}
+}
\ No newline at end of file
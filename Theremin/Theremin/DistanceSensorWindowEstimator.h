@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "DistanceSensorEstimator.h"
+#include "DistanceSensorSlidingMedian.h"
+
+namespace DistanceSensor {
+	/*
+	 * Estimador de ventana: media recortada de las últimas
+	 * muestras (Con la máxima fracción recortada es la mediana).
+	 *
+	 * Descarta los valores atípicos sin suponer nada del movimiento,
+	 * pero se atrasa media ventana respecto de la mano y no
+	 * estima la velocidad
+	 */
+	class WindowEstimator final : public DistanceSensor::Estimator
+	{
+	public:
+		// Fracción recortada de cada extremo para la mediana
+		static constexpr double medianTrimFraction = 0.5;
+
+		// Fracción recortada de cada extremo por defecto (Media intercuartil)
+		static constexpr double defaultTrimFraction = 0.25;
+
+		/**
+		 * @post Crea el estimador con el tamaño de ventana y la
+		         fracción de muestras recortada de cada extremo
+				 especificados
+		 */
+		WindowEstimator(size_t windowSize, double trimFraction);
+
+		void startBatch() override;
+
+		void update(std::chrono::steady_clock::time_point timestamp, boost::optional<double> distance) override;
+
+		boost::optional<DistanceSensor::Estimate> getEstimate() const override;
+
+	private:
+		const double trimFraction_m;
+
+		DistanceSensor::SlidingMedian samples_m;
+		std::chrono::steady_clock::time_point lastTimestamp_m; // Instante de la última muestra
+	};
+}
@@ -31,91 +31,111 @@
  */
 
 #include "GPIO.h"
-
-#include <iostream>
-#include <fstream>
+#include "GPIOSysfsBackend.h"
 
 #include <stdexcept>
 
-GPIO::Handler::Handler(int id)
-{
-	this->gpioName = std::to_string(id);
+int GPIO::Pin::getFileDescriptor() {
+	return -1;
+}
 
-	// Intentar exportar el GPIO
-	std::ofstream exportgpio("/sys/class/gpio/export");
+int GPIO::Pin::getEdgeFileDescriptor() {
+	return -1;
+}
+
+uint32_t GPIO::Pin::getEdgeFileDescriptorEvents() {
+	return 0;
+}
 
-	if (exportgpio.is_open()) {
-		exportgpio << this->gpioName;
+GPIO::Backend& GPIO::Backend::getDefault() {
+	static GPIO::SysfsBackend defaultBackend;
+
+	return defaultBackend;
+}
+
+GPIO::Snapshot GPIO::Backend::sample(GPIO::Pin * const *pins, size_t numberOfPins) {
+	if (numberOfPins > GPIO::maxSnapshotPins) {
+		throw std::runtime_error("Too many gpio pins for a snapshot");
 	}
-	else {
-		throw std::runtime_error("Cannot export gpio " + this->gpioName);
+
+	const auto timestamp = this->getClock().now();
+
+	uint64_t levels = 0;
+
+	for (size_t i = 0; i < numberOfPins; i++) {
+		if (pins[i]->read()) {
+			levels |= (uint64_t)1 << i;
+		}
 	}
 
-	this->directionFilename = "/sys/class/gpio/gpio" + this->gpioName + "/direction";
-	this->valueFilename = "/sys/class/gpio/gpio" + this->gpioName + "/value";
+	return GPIO::Snapshot(timestamp, levels);
 }
 
+Clock& GPIO::Backend::getClock() {
+	return Clock::getSteady();
+}
 
-GPIO::Handler::~Handler()
+GPIO::Handler::Handler(int id) : Handler(GPIO::Backend::getDefault(), id)
 {
-	// Intentar desexportar el GPIO
-	std::ofstream unexportgpio("/sys/class/gpio/unexport");
 
-	if (unexportgpio.is_open()) {
-		unexportgpio << this->gpioName;
-	}
-	else {
-		std::cerr  << "Cannot unexport gpio " + this->gpioName;
-	}
 }
 
-void GPIO::Handler::setDirection(GPIO::Direction direction) {
-	std::string fileName = this->directionFilename;
+GPIO::Handler::Handler(GPIO::Backend& backend, int id) :
+	backend_m(backend),
+	pin_m(backend.open(id))
+{
 
-	std::ofstream setdirGPIO;
+}
 
-	while (!setdirGPIO.is_open()) {
-		setdirGPIO.open(fileName);
-	}
+GPIO::Handler::~Handler()
+{
 
-	std::string value;
-
-	switch (direction)
-	{
-	case GPIO::Direction::in:
-		value = "in";
-		break;
-	case GPIO::Direction::out:
-		value = "out";
-		break;
-	default:
-		throw std::runtime_error("Invalid gpio's direction");
-		break;
-	}
+}
 
-	setdirGPIO << value;
+GPIO::Backend& GPIO::Handler::getBackend() {
+	return this->backend_m;
 }
 
-void GPIO::Handler::write(bool value) {
-	std::ofstream setvalGPIO;
+GPIO::Pin& GPIO::Handler::getPin() {
+	return *this->pin_m;
+}
 
-	while (!setvalGPIO.is_open()) {
-		setvalGPIO.open(this->valueFilename);
-	}
+void GPIO::Handler::setDirection(GPIO::Direction direction) {
+	this->pin_m->setDirection(direction);
+}
 
-	setvalGPIO << (value ? 1 : 0);
+void GPIO::Handler::write(bool value) {
+	this->pin_m->write(value);
 }
 
 bool GPIO::Handler::read() {
-	std::ifstream getvalGPIO;
+	return this->pin_m->read();
+}
 
-	while (!getvalGPIO.is_open()) {
-		getvalGPIO.open(this->valueFilename);
-	}
+bool GPIO::Handler::supportsEdgeEvents() {
+	return this->pin_m->supportsEdgeEvents();
+}
+
+void GPIO::Handler::setEdge(GPIO::Edge edge) {
+	this->pin_m->setEdge(edge);
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::Handler::waitForEdge(std::chrono::steady_clock::duration timeout) {
+	return this->pin_m->waitForEdge(timeout);
+}
 
-	std::string val_str;
+void GPIO::Handler::discardEdgeEvents() {
+	this->pin_m->discardEdgeEvents();
+}
 
-	getvalGPIO >> val_str;
+int GPIO::Handler::getFileDescriptor() {
+	return this->pin_m->getFileDescriptor();
+}
+
+int GPIO::Handler::getEdgeFileDescriptor() {
+	return this->pin_m->getEdgeFileDescriptor();
+}
 
-	return (val_str != "0");
+uint32_t GPIO::Handler::getEdgeFileDescriptorEvents() {
+	return this->pin_m->getEdgeFileDescriptorEvents();
 }
\ No newline at end of file
@@ -32,25 +32,44 @@
 
 #pragma once
 
-#include <string>
+#include "GPIOBackend.h"
 
-namespace GPIO {
-	enum class Direction { in, out };
+#include <memory>
 
+namespace GPIO {
 	class Handler final
 	{
 	public:
 		/**
 		* @post Crea un handler al pin de GPIO con el id
-		        especificado
+		        especificado, con el backend predeterminado
 		*/
 		Handler(int id);
 
+		/**
+		* @post Crea un handler al pin de GPIO con el id
+		        especificado, con el backend especificado
+		*/
+		Handler(GPIO::Backend& backend, int id);
+
+		Handler(const Handler&) = delete;
+		Handler& operator=(const Handler&) = delete;
+
 		/**
 		* @post Destruye el handler, liberando el pin de GPIO
 		*/
 		~Handler();
 
+		/**
+		 * @post Devuelve el backend que abrió el pin
+		 */
+		GPIO::Backend& getBackend();
+
+		/**
+		 * @post Devuelve el pin
+		 */
+		GPIO::Pin& getPin();
+
 		/**
 		* @post Especifica el sentido del pin
 		*/
@@ -66,11 +85,51 @@ namespace GPIO {
 		 */
 		bool read();
 
-	private:
-		std::string gpioName;
+		/**
+		 * @post Devuelve si el pin puede generar eventos de flanco
+		 */
+		bool supportsEdgeEvents();
 
-		std::string valueFilename;
-		std::string directionFilename;
+		/**
+		 * @pre El pin tiene que soportar eventos de flanco
+		 * @post Especifica los flancos que generan eventos
+		 */
+		void setEdge(GPIO::Edge edge);
+
+		/**
+		 * @pre Tienen que haberse especificado los flancos con setEdge
+		 * @post Espera un evento de flanco durante el tiempo máximo
+		         especificado, bloqueando el thread actual.
+				 Devuelve el evento, o vacío si se agotó el tiempo
+		 */
+		boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout);
+
+		/**
+		 * @post Descarta los eventos de flanco pendientes
+		 */
+		void discardEdgeEvents();
+
+		/**
+		 * @post Devuelve el descriptor del archivo del que se puede leer
+		         el valor con pread, o -1 si no lo hay
+		 */
+		int getFileDescriptor();
+
+		/**
+		 * @post Devuelve el descriptor de archivo que está listo cuando
+		         hay un evento de flanco pendiente, o -1 si no lo hay
+		 */
+		int getEdgeFileDescriptor();
+
+		/**
+		 * @post Devuelve los eventos (EPOLL*) del descriptor de archivo de
+		         eventos de flanco que indican un evento de flanco pendiente
+		 */
+		uint32_t getEdgeFileDescriptorEvents();
+
+	private:
+		GPIO::Backend& backend_m;
+		std::unique_ptr<GPIO::Pin> pin_m;
 	};
 
 }
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/optional.hpp>
+
+#include "Timestamped.h"
+#include "Clock.h"
+
+namespace GPIO {
+	enum class Direction { in, out };
+
+	// Flancos que generan eventos
+	enum class Edge { none, rising, falling, both };
+
+	// Evento de flanco: Valor del pin después del flanco, con el instante en que se detectó
+	typedef Timestamped<std::chrono::steady_clock::time_point, bool> EdgeEvent;
+
+	// Valor de un pin con el instante en que se leyó
+	typedef Timestamped<std::chrono::steady_clock::time_point, bool> Level;
+
+	// Muestra de un conjunto de pines: El bit i es el valor del pin i del conjunto
+	typedef Timestamped<std::chrono::steady_clock::time_point, uint64_t> Snapshot;
+
+	// Máximo número de pines de una muestra
+	constexpr size_t maxSnapshotPins = 64;
+
+	/*
+	 * Pin de GPIO abierto por un backend.
+	 *
+	 * Todos los timestamps están en la base de tiempo del
+	 * reloj del backend
+	 */
+	class Pin
+	{
+	public:
+		virtual ~Pin() {}
+
+		/**
+		 * @post Especifica el sentido del pin
+		 */
+		virtual void setDirection(GPIO::Direction direction) = 0;
+
+		/**
+		 * @post Escribe en el pin
+		 */
+		virtual void write(bool value) = 0;
+
+		/**
+		 * @post Lee del pin
+		 */
+		virtual bool read() = 0;
+
+		/**
+		 * @post Devuelve si el pin puede generar eventos de flanco
+		 */
+		virtual bool supportsEdgeEvents() = 0;
+
+		/**
+		 * @pre El pin tiene que soportar eventos de flanco
+		 * @post Especifica los flancos que generan eventos
+		 */
+		virtual void setEdge(GPIO::Edge edge) = 0;
+
+		/**
+		 * @pre Tienen que haberse especificado los flancos con setEdge
+		 * @post Espera un evento de flanco durante el tiempo máximo
+		         especificado, bloqueando el thread actual.
+				 Devuelve el evento, o vacío si se agotó el tiempo
+		 */
+		virtual boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout) = 0;
+
+		/**
+		 * @post Descarta los eventos de flanco pendientes
+		 */
+		virtual void discardEdgeEvents() = 0;
+
+		/**
+		 * @post Devuelve el descriptor del archivo del que se puede leer
+		         el valor con pread ('0' o '1'), o -1 si no lo hay
+		 */
+		virtual int getFileDescriptor();
+
+		/**
+		 * @post Devuelve el descriptor de archivo que está listo cuando
+		         hay un evento de flanco pendiente, o -1 si no lo hay
+		 */
+		virtual int getEdgeFileDescriptor();
+
+		/**
+		 * @post Devuelve los eventos (EPOLL*) del descriptor de archivo de
+		         eventos de flanco que indican un evento de flanco pendiente
+		 */
+		virtual uint32_t getEdgeFileDescriptorEvents();
+	};
+
+	/*
+	 * Backend de GPIO, que da acceso a los pines
+	 * a través de una interfaz del kernel (O de una simulación)
+	 */
+	class Backend
+	{
+	public:
+		virtual ~Backend() {}
+
+		/**
+		 * @post Abre el pin con el id especificado
+		 */
+		virtual std::unique_ptr<GPIO::Pin> open(int id) = 0;
+
+		/**
+		 * @pre Los pines tienen que haber sido abiertos por este backend,
+		        y no pueden ser más de maxSnapshotPins
+		 * @post Lee los pines especificados en una sola operación,
+		         con un único timestamp para todo el conjunto.
+
+				 Por defecto lee los pines uno por uno, los backends
+				 que puedan leer varios pines a la vez lo redefinen
+		 */
+		virtual GPIO::Snapshot sample(GPIO::Pin * const *pins, size_t numberOfPins);
+
+		/**
+		 * @post Devuelve la base de tiempo de los timestamps del backend
+		         (Por defecto std::chrono::steady_clock)
+		 */
+		virtual Clock& getClock();
+
+		/**
+		 * @post Devuelve el backend predeterminado (sysfs)
+		 */
+		static GPIO::Backend& getDefault();
+	};
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIOBank.h"
+
+#include <stdexcept>
+
+GPIO::Bank::Bank(GPIO::Backend& backend) :
+	backend_m(backend)
+{
+	this->consumedPins_m = 0;
+}
+
+size_t GPIO::Bank::add(GPIO::Handler& handler) {
+	if (&handler.getBackend() != &this->backend_m) {
+		throw std::runtime_error("Gpio pin belongs to another backend");
+	}
+
+	if (this->pins_m.size() == GPIO::maxSnapshotPins) {
+		throw std::runtime_error("Too many gpio pins for a bank");
+	}
+
+	this->pins_m.push_back(&handler.getPin());
+
+	// Invalidar la muestra actual, porque no incluye el pin nuevo
+	this->snapshot_m = boost::optional<GPIO::Snapshot>();
+
+	return this->pins_m.size() - 1;
+}
+
+GPIO::Level GPIO::Bank::read(size_t index, std::chrono::steady_clock::time_point notBefore) {
+	const uint64_t pinMask = (uint64_t)1 << index;
+
+	if (!this->snapshot_m.is_initialized() || ((this->consumedPins_m & pinMask) != 0) || (this->snapshot_m->timestamp() < notBefore)) {
+		this->sample();
+	}
+
+	this->consumedPins_m |= pinMask;
+
+	return GPIO::Level(this->snapshot_m->timestamp(), (this->snapshot_m->value() & pinMask) != 0);
+}
+
+GPIO::Snapshot GPIO::Bank::sample() {
+	this->snapshot_m = this->backend_m.sample(this->pins_m.data(), this->pins_m.size());
+	this->consumedPins_m = 0;
+
+	return *this->snapshot_m;
+}
\ No newline at end of file
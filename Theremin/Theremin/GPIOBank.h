@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "GPIO.h"
+
+#include <vector>
+
+namespace GPIO {
+	/*
+	 * Conjunto de pines que se muestrean juntos.
+	 *
+	 * Varios lectores que hacen polling de sus pines comparten
+	 * la misma muestra: Sólo se toma una nueva cuando un pin
+	 * ya consumió la actual, con lo cual en cada ronda del
+	 * scheduler se hace una sola lectura para todos los pines.
+	 *
+	 * No es thread-safe, tiene que usarse desde un solo thread
+	 */
+	class Bank final
+	{
+	public:
+		/**
+		 * @post Crea un conjunto vacío de pines del backend especificado
+		 */
+		Bank(GPIO::Backend& backend);
+
+		Bank(const Bank&) = delete;
+		Bank& operator=(const Bank&) = delete;
+
+		/**
+		 * @pre El pin tiene que ser del backend del conjunto,
+		        y no puede haber más de maxSnapshotPins
+		 * @post Agrega el pin del handler especificado, y devuelve
+		         su índice en el conjunto
+		 */
+		size_t add(GPIO::Handler& handler);
+
+		/**
+		 * @post Devuelve el valor del pin con el índice especificado,
+		         de una muestra tomada no antes del instante especificado.
+				 Reusa la última muestra si el pin todavía no la leyó
+		 */
+		GPIO::Level read(size_t index, std::chrono::steady_clock::time_point notBefore);
+
+		/**
+		 * @post Toma una nueva muestra de todos los pines
+		 */
+		GPIO::Snapshot sample();
+
+	private:
+		GPIO::Backend& backend_m;
+
+		std::vector<GPIO::Pin *> pins_m;
+
+		boost::optional<GPIO::Snapshot> snapshot_m; // Última muestra
+		uint64_t consumedPins_m; // Pines que ya leyeron la última muestra
+	};
+}
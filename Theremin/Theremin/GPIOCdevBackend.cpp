@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIOCdevBackend.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <linux/gpio.h>
+
+GPIO::CdevLineRequest::CdevLineRequest(int chipFd, const std::vector<uint32_t>& offsets) :
+	offsets_m(offsets),
+	flags_m(offsets.size(), GPIO_V2_LINE_FLAG_INPUT)
+{
+	if (offsets.empty() || (offsets.size() > GPIO_V2_LINES_MAX)) {
+		throw std::runtime_error("Invalid number of gpio lines");
+	}
+
+	struct gpio_v2_line_request request;
+	std::memset(&request, 0, sizeof(request));
+
+	for (size_t i = 0; i < offsets.size(); i++) {
+		request.offsets[i] = offsets[i];
+	}
+
+	request.num_lines = (uint32_t)offsets.size();
+	std::strncpy(request.consumer, "theremin", sizeof(request.consumer) - 1);
+	request.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+
+	if (::ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request) < 0) {
+		throw std::runtime_error("Cannot request gpio line " + std::to_string(offsets[0]));
+	}
+
+	this->fd_m = request.fd;
+}
+
+GPIO::CdevLineRequest::~CdevLineRequest()
+{
+	::close(this->fd_m);
+}
+
+int GPIO::CdevLineRequest::getFd() const {
+	return this->fd_m;
+}
+
+size_t GPIO::CdevLineRequest::getNumberOfLines() const {
+	return this->offsets_m.size();
+}
+
+uint32_t GPIO::CdevLineRequest::getOffset(size_t lineIndex) const {
+	return this->offsets_m.at(lineIndex);
+}
+
+void GPIO::CdevLineRequest::setFlags(size_t lineIndex, uint64_t flags) {
+	this->flags_m.at(lineIndex) = flags;
+
+	/*
+	 * Los flags de la primera línea son los predeterminados, y las líneas
+	 * con otros flags se agrupan en atributos con la máscara correspondiente
+	 */
+	struct gpio_v2_line_config config;
+	std::memset(&config, 0, sizeof(config));
+
+	config.flags = this->flags_m[0];
+
+	for (size_t i = 1; i < this->flags_m.size(); i++) {
+		if (this->flags_m[i] != config.flags) {
+			uint32_t attributeIndex = 0;
+
+			while ((attributeIndex < config.num_attrs) && (config.attrs[attributeIndex].attr.flags != this->flags_m[i])) {
+				attributeIndex++;
+			}
+
+			if (attributeIndex == config.num_attrs) {
+				if (config.num_attrs == GPIO_V2_LINE_NUM_ATTRS_MAX) {
+					throw std::runtime_error("Too many gpio line configurations");
+				}
+
+				config.attrs[attributeIndex].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+				config.attrs[attributeIndex].attr.flags = this->flags_m[i];
+				config.num_attrs++;
+			}
+
+			config.attrs[attributeIndex].mask |= (uint64_t)1 << i;
+		}
+	}
+
+	if (::ioctl(this->fd_m, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0) {
+		throw std::runtime_error("Cannot configure gpio line " + std::to_string(this->offsets_m[lineIndex]));
+	}
+}
+
+uint64_t GPIO::CdevLineRequest::getValues(uint64_t mask) {
+	struct gpio_v2_line_values values;
+	values.bits = 0;
+	values.mask = mask;
+
+	if (::ioctl(this->fd_m, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+		throw std::runtime_error("Cannot read gpio line " + std::to_string(this->offsets_m[0]));
+	}
+
+	return values.bits;
+}
+
+void GPIO::CdevLineRequest::setValues(uint64_t bits, uint64_t mask) {
+	struct gpio_v2_line_values values;
+	values.bits = bits;
+	values.mask = mask;
+
+	if (::ioctl(this->fd_m, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0) {
+		throw std::runtime_error("Cannot write gpio line " + std::to_string(this->offsets_m[0]));
+	}
+}
+
+GPIO::CdevBackend::CdevBackend(const std::string& chipPath)
+{
+	this->chipFd_m = ::open(chipPath.c_str(), O_RDWR | O_CLOEXEC);
+
+	if (this->chipFd_m < 0) {
+		throw std::runtime_error("Cannot open gpio chip " + chipPath);
+	}
+}
+
+GPIO::CdevBackend::~CdevBackend()
+{
+	::close(this->chipFd_m);
+}
+
+void GPIO::CdevBackend::groupLines(const std::vector<int>& ids) {
+	LineGroup lineGroup;
+
+	for (int id : ids) {
+		if (id < 0) {
+			throw std::runtime_error("Invalid gpio line " + std::to_string(id));
+		}
+
+		lineGroup.offsets.push_back((uint32_t)id);
+	}
+
+	this->lineGroups_m.push_back(lineGroup);
+}
+
+std::unique_ptr<GPIO::Pin> GPIO::CdevBackend::open(int id) {
+	if (id < 0) {
+		throw std::runtime_error("Invalid gpio line " + std::to_string(id));
+	}
+
+	const uint32_t offset = (uint32_t)id;
+
+	// Si la línea pertenece a un grupo compartir la petición del grupo
+	for (LineGroup& lineGroup : this->lineGroups_m) {
+		auto offsetIt = std::find(lineGroup.offsets.begin(), lineGroup.offsets.end(), offset);
+
+		if (offsetIt != lineGroup.offsets.end()) {
+			std::shared_ptr<GPIO::CdevLineRequest> request = lineGroup.request.lock();
+
+			if (request.get() == nullptr) {
+				request = std::make_shared<GPIO::CdevLineRequest>(this->chipFd_m, lineGroup.offsets);
+				lineGroup.request = request;
+			}
+
+			return std::unique_ptr<GPIO::Pin>(new GPIO::CdevPin(request, (size_t)(offsetIt - lineGroup.offsets.begin())));
+		}
+	}
+
+	return std::unique_ptr<GPIO::Pin>(new GPIO::CdevPin(
+		std::make_shared<GPIO::CdevLineRequest>(this->chipFd_m, std::vector<uint32_t>(1, offset)),
+		0
+	));
+}
+
+GPIO::Snapshot GPIO::CdevBackend::sample(GPIO::Pin * const *pins, size_t numberOfPins) {
+	if (numberOfPins > GPIO::maxSnapshotPins) {
+		throw std::runtime_error("Too many gpio pins for a snapshot");
+	}
+
+	const auto timestamp = std::chrono::steady_clock::now();
+
+	uint64_t levels = 0;
+	uint64_t pendingPins = (numberOfPins == GPIO::maxSnapshotPins) ? ~(uint64_t)0 : (((uint64_t)1 << numberOfPins) - 1);
+
+	// Por cada petición involucrada leer todas sus líneas del conjunto con un solo ioctl
+	for (size_t i = 0; i < numberOfPins; i++) {
+		if ((pendingPins & ((uint64_t)1 << i)) != 0) {
+			GPIO::CdevLineRequest& request = static_cast<GPIO::CdevPin *>(pins[i])->getRequest();
+
+			uint64_t lineMask = 0;
+
+			for (size_t j = i; j < numberOfPins; j++) {
+				GPIO::CdevPin *pin = static_cast<GPIO::CdevPin *>(pins[j]);
+
+				if (&pin->getRequest() == &request) {
+					lineMask |= (uint64_t)1 << pin->getLineIndex();
+				}
+			}
+
+			const uint64_t lineValues = request.getValues(lineMask);
+
+			for (size_t j = i; j < numberOfPins; j++) {
+				GPIO::CdevPin *pin = static_cast<GPIO::CdevPin *>(pins[j]);
+
+				if (&pin->getRequest() == &request) {
+					if ((lineValues & ((uint64_t)1 << pin->getLineIndex())) != 0) {
+						levels |= (uint64_t)1 << j;
+					}
+
+					pendingPins &= ~((uint64_t)1 << j);
+				}
+			}
+		}
+	}
+
+	return GPIO::Snapshot(timestamp, levels);
+}
+
+GPIO::CdevPin::CdevPin(std::shared_ptr<GPIO::CdevLineRequest> request, size_t lineIndex) :
+	request_m(request),
+	lineIndex_m(lineIndex)
+{
+	this->direction_m = GPIO::Direction::in;
+	this->edge_m = GPIO::Edge::none;
+}
+
+void GPIO::CdevPin::setDirection(GPIO::Direction direction) {
+	this->direction_m = direction;
+
+	// Los flancos sólo se pueden detectar en entradas
+	if (direction == GPIO::Direction::out) {
+		this->edge_m = GPIO::Edge::none;
+	}
+
+	this->applyFlags();
+}
+
+void GPIO::CdevPin::write(bool value) {
+	const uint64_t mask = (uint64_t)1 << this->lineIndex_m;
+
+	this->request_m->setValues(value ? mask : 0, mask);
+}
+
+bool GPIO::CdevPin::read() {
+	const uint64_t mask = (uint64_t)1 << this->lineIndex_m;
+
+	return ((this->request_m->getValues(mask) & mask) != 0);
+}
+
+GPIO::CdevLineRequest& GPIO::CdevPin::getRequest() {
+	return *this->request_m;
+}
+
+size_t GPIO::CdevPin::getLineIndex() const {
+	return this->lineIndex_m;
+}
+
+bool GPIO::CdevPin::supportsEdgeEvents() {
+	return (this->request_m->getNumberOfLines() == 1);
+}
+
+void GPIO::CdevPin::setEdge(GPIO::Edge edge) {
+	if (edge != GPIO::Edge::none) {
+		if (!this->supportsEdgeEvents()) {
+			throw std::runtime_error("Edge events not supported by grouped gpio lines");
+		}
+
+		if (this->direction_m != GPIO::Direction::in) {
+			throw std::runtime_error("Edge detection requires an input gpio line");
+		}
+	}
+
+	this->edge_m = edge;
+
+	this->applyFlags();
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::CdevPin::waitForEdge(std::chrono::steady_clock::duration timeout) {
+	if (timeout < std::chrono::steady_clock::duration::zero()) {
+		timeout = std::chrono::steady_clock::duration::zero();
+	}
+
+	const auto timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+
+	struct timespec timeoutSpec;
+	timeoutSpec.tv_sec = (time_t)(timeoutNs / 1000000000);
+	timeoutSpec.tv_nsec = (long)(timeoutNs % 1000000000);
+
+	struct pollfd pollFd;
+	pollFd.fd = this->request_m->getFd();
+	pollFd.events = POLLIN;
+	pollFd.revents = 0;
+
+	int result;
+
+	do {
+		result = ::ppoll(&pollFd, 1, &timeoutSpec, nullptr);
+	} while (result < 0 && errno == EINTR);
+
+	const std::string lineName = std::to_string(this->request_m->getOffset(this->lineIndex_m));
+
+	if (result < 0) {
+		throw std::runtime_error("Cannot poll gpio line " + lineName);
+	}
+	else if (result == 0) {
+		return boost::optional<GPIO::EdgeEvent>();
+	}
+
+	struct gpio_v2_line_event event;
+
+	if (::read(pollFd.fd, &event, sizeof(event)) != (ssize_t)sizeof(event)) {
+		throw std::runtime_error("Cannot read gpio line event " + lineName);
+	}
+
+	// El kernel marca los eventos con CLOCK_MONOTONIC, la misma base de tiempo que steady_clock
+	const std::chrono::steady_clock::time_point timestamp(
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(event.timestamp_ns))
+	);
+
+	return GPIO::EdgeEvent(timestamp, event.id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+}
+
+int GPIO::CdevPin::getEdgeFileDescriptor() {
+	if (this->supportsEdgeEvents()) {
+		return this->request_m->getFd();
+	}
+	else {
+		return -1;
+	}
+}
+
+uint32_t GPIO::CdevPin::getEdgeFileDescriptorEvents() {
+	return EPOLLIN;
+}
+
+void GPIO::CdevPin::discardEdgeEvents() {
+	if (this->edge_m != GPIO::Edge::none) {
+		while (this->waitForEdge(std::chrono::steady_clock::duration::zero()).is_initialized());
+	}
+}
+
+void GPIO::CdevPin::applyFlags() {
+	uint64_t flags;
+
+	switch (this->direction_m)
+	{
+	case GPIO::Direction::in:
+		flags = GPIO_V2_LINE_FLAG_INPUT;
+		break;
+	case GPIO::Direction::out:
+		flags = GPIO_V2_LINE_FLAG_OUTPUT;
+		break;
+	default:
+		throw std::runtime_error("Invalid gpio's direction");
+		break;
+	}
+
+	switch (this->edge_m)
+	{
+	case GPIO::Edge::none:
+		break;
+	case GPIO::Edge::rising:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+		break;
+	case GPIO::Edge::falling:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	case GPIO::Edge::both:
+		flags |= GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	default:
+		throw std::runtime_error("Invalid gpio's edge");
+		break;
+	}
+
+	this->request_m->setFlags(this->lineIndex_m, flags);
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "GPIOBackend.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GPIO {
+	/*
+	 * Petición de una o más líneas al dispositivo de caracteres
+	 * (/dev/gpiochipN, ABI v2).
+	 *
+	 * Todas las líneas de la petición se pueden leer o escribir
+	 * con un solo ioctl
+	 */
+	class CdevLineRequest final
+	{
+	public:
+		/**
+		 * @post Pide las líneas especificadas del chip, como entradas
+		 */
+		CdevLineRequest(int chipFd, const std::vector<uint32_t>& offsets);
+
+		CdevLineRequest(const CdevLineRequest&) = delete;
+		CdevLineRequest& operator=(const CdevLineRequest&) = delete;
+
+		/**
+		 * @post Libera las líneas
+		 */
+		~CdevLineRequest();
+
+		/**
+		 * @post Devuelve el descriptor de la petición
+		 */
+		int getFd() const;
+
+		/**
+		 * @post Devuelve la cantidad de líneas
+		 */
+		size_t getNumberOfLines() const;
+
+		/**
+		 * @post Devuelve el offset de la línea con el índice especificado
+		 */
+		uint32_t getOffset(size_t lineIndex) const;
+
+		/**
+		 * @post Especifica los flags (GPIO_V2_LINE_FLAG_*) de la línea
+		         con el índice especificado
+		 */
+		void setFlags(size_t lineIndex, uint64_t flags);
+
+		/**
+		 * @post Lee los valores de las líneas indicadas por la máscara
+		         (El bit i corresponde a la línea de índice i)
+		 */
+		uint64_t getValues(uint64_t mask);
+
+		/**
+		 * @post Escribe los valores de las líneas indicadas por la máscara
+		 */
+		void setValues(uint64_t bits, uint64_t mask);
+
+	private:
+		std::vector<uint32_t> offsets_m;
+		std::vector<uint64_t> flags_m; // Flags de cada línea
+
+		int fd_m;
+	};
+
+	/*
+	 * Línea de GPIO accedida por el dispositivo de caracteres
+	 */
+	class CdevPin final : public GPIO::Pin
+	{
+	public:
+		/**
+		 * @post Crea el pin para la línea con el índice especificado
+		         de la petición
+		 */
+		CdevPin(std::shared_ptr<GPIO::CdevLineRequest> request, size_t lineIndex);
+
+		void setDirection(GPIO::Direction direction) override;
+		void write(bool value) override;
+		bool read() override;
+
+		/**
+		 * @post Devuelve la petición de la línea
+		 */
+		GPIO::CdevLineRequest& getRequest();
+
+		/**
+		 * @post Devuelve el índice de la línea en la petición
+		 */
+		size_t getLineIndex() const;
+
+		/**
+		 * @post Devuelve si soporta eventos de flanco. Sólo los pines
+		         con una petición propia los soportan, porque los
+				 eventos se leen del descriptor de la petición
+		 */
+		bool supportsEdgeEvents() override;
+
+		void setEdge(GPIO::Edge edge) override;
+
+		/**
+		 * @post Espera un evento de flanco. El timestamp es el
+		         que registró el kernel al producirse el flanco,
+				 con lo cual no incluye la latencia de despertar
+				 el thread
+		 */
+		boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout) override;
+		void discardEdgeEvents() override;
+
+		/**
+		 * @post Devuelve el descriptor de la petición, si soporta
+		         eventos de flanco
+		 */
+		int getEdgeFileDescriptor() override;
+		uint32_t getEdgeFileDescriptorEvents() override;
+
+	private:
+		/**
+		 * @post Aplica los flags de configuración de la línea
+		 */
+		void applyFlags();
+
+		std::shared_ptr<GPIO::CdevLineRequest> request_m;
+		const size_t lineIndex_m;
+
+		GPIO::Direction direction_m;
+		GPIO::Edge edge_m;
+	};
+
+	/*
+	 * Backend de GPIO por dispositivo de caracteres.
+	 *
+	 * Los ids de pin son los offsets de línea en el chip
+	 * (En la Raspberry Pi coinciden con la numeración BCM)
+	 */
+	class CdevBackend final : public GPIO::Backend
+	{
+	public:
+		/**
+		 * @post Abre el chip de GPIO especificado
+		 */
+		CdevBackend(const std::string& chipPath = "/dev/gpiochip0");
+
+		CdevBackend(const CdevBackend&) = delete;
+		CdevBackend& operator=(const CdevBackend&) = delete;
+
+		/**
+		 * @post Cierra el chip
+		 */
+		~CdevBackend() override;
+
+		/**
+		 * @pre Ninguna de las líneas tiene que estar abierta
+		 * @post Indica que las líneas especificadas se pidan juntas
+		         al abrirlas, para poder muestrearlas con un solo ioctl.
+				 Las líneas agrupadas no soportan eventos de flanco
+		 */
+		void groupLines(const std::vector<int>& ids);
+
+		std::unique_ptr<GPIO::Pin> open(int id) override;
+
+		/**
+		 * @post Lee los pines con un GPIO_V2_LINE_GET_VALUES_IOCTL
+		         por cada petición de línea involucrada
+		 */
+		GPIO::Snapshot sample(GPIO::Pin * const *pins, size_t numberOfPins) override;
+
+	private:
+		// Grupo de líneas que se piden juntas
+		struct LineGroup {
+			std::vector<uint32_t> offsets;
+			std::weak_ptr<GPIO::CdevLineRequest> request;
+		};
+
+		int chipFd_m;
+
+		std::vector<LineGroup> lineGroups_m;
+	};
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIOMemoryMappedBackend.h"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+GPIO::MemoryMappedBackend::MemoryMappedBackend(const std::string& registerFilePath)
+{
+	int fd = ::open(registerFilePath.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
+
+	if (fd < 0) {
+		throw std::runtime_error("Cannot open gpio register file " + registerFilePath);
+	}
+
+	// Si es un archivo común tiene que cubrir todo el bloque, sino el acceso fuera del archivo genera SIGBUS
+	struct stat fileStat;
+
+	if ((::fstat(fd, &fileStat) < 0) || (S_ISREG(fileStat.st_mode) && ((size_t)fileStat.st_size < registerBlockSize))) {
+		::close(fd);
+		throw std::runtime_error("Invalid gpio register file " + registerFilePath);
+	}
+
+	void *mapping = ::mmap(nullptr, registerBlockSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	// El mapeo se mantiene después de cerrar el descriptor
+	::close(fd);
+
+	if (mapping == MAP_FAILED) {
+		throw std::runtime_error("Cannot map gpio register file " + registerFilePath);
+	}
+
+	this->registers_m = static_cast<volatile uint32_t *>(mapping);
+}
+
+GPIO::MemoryMappedBackend::~MemoryMappedBackend()
+{
+	::munmap(const_cast<uint32_t *>(this->registers_m), registerBlockSize);
+}
+
+std::unique_ptr<GPIO::Pin> GPIO::MemoryMappedBackend::open(int id) {
+	if ((id < 0) || (id >= numberOfPins)) {
+		throw std::runtime_error("Invalid gpio pin " + std::to_string(id));
+	}
+
+	return std::unique_ptr<GPIO::Pin>(new GPIO::MemoryMappedPin(this->registers_m, (uint32_t)id));
+}
+
+GPIO::Snapshot GPIO::MemoryMappedBackend::sample(GPIO::Pin * const *pins, size_t numberOfPins) {
+	if (numberOfPins > GPIO::maxSnapshotPins) {
+		throw std::runtime_error("Too many gpio pins for a snapshot");
+	}
+
+	// Leer una sola vez el registro de nivel de cada banco
+	const auto timestamp = std::chrono::steady_clock::now();
+
+	uint32_t bankLevels[numberOfBanks];
+
+	for (uint32_t i = 0; i < numberOfBanks; i++) {
+		bankLevels[i] = this->registers_m[levelRegister + i];
+	}
+
+	uint64_t levels = 0;
+
+	for (size_t i = 0; i < numberOfPins; i++) {
+		GPIO::MemoryMappedPin *pin = static_cast<GPIO::MemoryMappedPin *>(pins[i]);
+
+		if ((bankLevels[pin->getBankIndex()] & pin->getBankMask()) != 0) {
+			levels |= (uint64_t)1 << i;
+		}
+	}
+
+	return GPIO::Snapshot(timestamp, levels);
+}
+
+GPIO::MemoryMappedPin::MemoryMappedPin(volatile uint32_t *registers, uint32_t pinNumber) :
+	registers_m(registers),
+	pinNumber_m(pinNumber),
+	bankIndex_m(pinNumber / 32),
+	bankMask_m((uint32_t)1 << (pinNumber % 32))
+{
+
+}
+
+void GPIO::MemoryMappedPin::setDirection(GPIO::Direction direction) {
+	// Cada registro de función tiene 3 bits por pin, 10 pines por registro
+	volatile uint32_t *functionSelect = this->registers_m + GPIO::MemoryMappedBackend::functionSelectRegister + this->pinNumber_m / 10;
+	const uint32_t shift = (this->pinNumber_m % 10) * 3;
+
+	uint32_t function;
+
+	switch (direction)
+	{
+	case GPIO::Direction::in:
+		function = 0;
+		break;
+	case GPIO::Direction::out:
+		function = 1;
+		break;
+	default:
+		throw std::runtime_error("Invalid gpio's direction");
+		break;
+	}
+
+	*functionSelect = (*functionSelect & ~((uint32_t)7 << shift)) | (function << shift);
+}
+
+void GPIO::MemoryMappedPin::write(bool value) {
+	const uint32_t registerIndex = (value ? GPIO::MemoryMappedBackend::setRegister : GPIO::MemoryMappedBackend::clearRegister);
+
+	this->registers_m[registerIndex + this->bankIndex_m] = this->bankMask_m;
+}
+
+bool GPIO::MemoryMappedPin::read() {
+	return ((this->registers_m[GPIO::MemoryMappedBackend::levelRegister + this->bankIndex_m] & this->bankMask_m) != 0);
+}
+
+uint32_t GPIO::MemoryMappedPin::getBankIndex() const {
+	return this->bankIndex_m;
+}
+
+uint32_t GPIO::MemoryMappedPin::getBankMask() const {
+	return this->bankMask_m;
+}
+
+bool GPIO::MemoryMappedPin::supportsEdgeEvents() {
+	return false;
+}
+
+void GPIO::MemoryMappedPin::setEdge(GPIO::Edge edge) {
+	if (edge != GPIO::Edge::none) {
+		throw std::runtime_error("Edge events not supported by memory mapped gpio");
+	}
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::MemoryMappedPin::waitForEdge(std::chrono::steady_clock::duration) {
+	throw std::runtime_error("Edge events not supported by memory mapped gpio");
+}
+
+void GPIO::MemoryMappedPin::discardEdgeEvents() {
+
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "GPIOBackend.h"
+
+#include <string>
+#include <cstdint>
+
+namespace GPIO {
+	/*
+	 * Pin de GPIO accedido directamente por los registros
+	 * del controlador (BCM2835/BCM2837) mapeados en memoria
+	 */
+	class MemoryMappedPin final : public GPIO::Pin
+	{
+	public:
+		/**
+		 * @post Crea el pin con el bloque de registros
+		         y el número de pin especificados
+		 */
+		MemoryMappedPin(volatile uint32_t *registers, uint32_t pinNumber);
+
+		void setDirection(GPIO::Direction direction) override;
+		void write(bool value) override;
+		bool read() override;
+
+		/**
+		 * @post Devuelve el índice del banco de 32 pines
+		 */
+		uint32_t getBankIndex() const;
+
+		/**
+		 * @post Devuelve la máscara del pin dentro del banco
+		 */
+		uint32_t getBankMask() const;
+
+		/**
+		 * @post Devuelve falso: El acceso directo a los registros
+		         no permite recibir eventos de flanco
+		 */
+		bool supportsEdgeEvents() override;
+
+		void setEdge(GPIO::Edge edge) override;
+		boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout) override;
+		void discardEdgeEvents() override;
+
+	private:
+		volatile uint32_t * const registers_m;
+
+		const uint32_t pinNumber_m;
+		const uint32_t bankIndex_m; // Índice del banco de 32 pines
+		const uint32_t bankMask_m; // Máscara del pin dentro del banco
+	};
+
+	/*
+	 * Backend de GPIO por registros mapeados en memoria.
+	 *
+	 * Una lectura o escritura de pin cuesta un acceso a memoria,
+	 * sin pasar por el kernel.
+	 *
+	 * ATENCIÓN: El cambio de sentido de un pin hace lectura-modificación-escritura
+	 *           de los registros de función, con lo cual no es atómico respecto
+	 *           de otros procesos que configuren pines del mismo registro
+	 */
+	class MemoryMappedBackend final : public GPIO::Backend
+	{
+	public:
+		/**
+		 * @post Mapea el bloque de registros del archivo especificado.
+		         Puede ser un archivo común del tamaño del bloque,
+				 que haga las veces de registros
+		 */
+		MemoryMappedBackend(const std::string& registerFilePath = "/dev/gpiomem");
+
+		MemoryMappedBackend(const MemoryMappedBackend&) = delete;
+		MemoryMappedBackend& operator=(const MemoryMappedBackend&) = delete;
+
+		/**
+		 * @post Desmapea el bloque de registros
+		 */
+		~MemoryMappedBackend() override;
+
+		std::unique_ptr<GPIO::Pin> open(int id) override;
+
+		/**
+		 * @post Lee los pines con una lectura de registro
+		         de nivel por banco
+		 */
+		GPIO::Snapshot sample(GPIO::Pin * const *pins, size_t numberOfPins) override;
+
+		// Tamaño del bloque de registros mapeado
+		static constexpr size_t registerBlockSize = 4096;
+
+		// Índices de registros (En palabras de 32 bits)
+		static constexpr uint32_t functionSelectRegister = 0; // GPFSEL0
+		static constexpr uint32_t setRegister = 7; // GPSET0
+		static constexpr uint32_t clearRegister = 10; // GPCLR0
+		static constexpr uint32_t levelRegister = 13; // GPLEV0
+
+		// Cantidad de pines y de bancos del controlador
+		static constexpr int numberOfPins = 54;
+		static constexpr uint32_t numberOfBanks = 2;
+
+	private:
+		volatile uint32_t *registers_m;
+	};
+}
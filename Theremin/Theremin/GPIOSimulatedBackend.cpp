@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIOSimulatedBackend.h"
+
+#include <stdexcept>
+#include <thread>
+
+GPIO::SimulatedPin::SimulatedPin(GPIO::SimulatedBackend& backend, int id) :
+	backend_m(backend),
+	id_m(id)
+{
+
+}
+
+void GPIO::SimulatedPin::setDirection(GPIO::Direction direction) {
+	this->backend_m.setPinDirection(this->id_m, direction);
+}
+
+void GPIO::SimulatedPin::write(bool value) {
+	this->backend_m.writePin(this->id_m, value);
+}
+
+bool GPIO::SimulatedPin::read() {
+	return this->backend_m.readPin(this->id_m);
+}
+
+bool GPIO::SimulatedPin::supportsEdgeEvents() {
+	return true;
+}
+
+void GPIO::SimulatedPin::setEdge(GPIO::Edge edge) {
+	this->backend_m.setPinEdge(this->id_m, edge);
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::SimulatedPin::waitForEdge(std::chrono::steady_clock::duration timeout) {
+	return this->backend_m.waitForPinEdge(this->id_m, timeout);
+}
+
+void GPIO::SimulatedPin::discardEdgeEvents() {
+	this->backend_m.discardPinEdgeEvents(this->id_m);
+}
+
+GPIO::SimulatedBackend::SimulatedBackend(TimeMode timeMode, uint32_t seed, std::chrono::steady_clock::duration accessCost) :
+	timeMode_m(timeMode),
+	accessCost_m(accessCost),
+	startTime_m(this->getClock().now()),
+	random_m(seed)
+{
+
+}
+
+void GPIO::SimulatedBackend::addSensor(Simulation::UltrasonicSensor sensor) {
+	const int sensorIndex = (int)this->sensors_m.size();
+
+	PinState& triggerState = this->getPinState(sensor.getTriggerId());
+	PinState& echoState = this->getPinState(sensor.getEchoId());
+
+	if ((triggerState.sensorIndex != -1) || (echoState.sensorIndex != -1) || (sensor.getTriggerId() == sensor.getEchoId())) {
+		throw std::runtime_error("Simulated sensor pins already in use");
+	}
+
+	triggerState.sensorIndex = sensorIndex;
+	triggerState.isEcho = false;
+
+	echoState.sensorIndex = sensorIndex;
+	echoState.isEcho = true;
+
+	this->sensors_m.push_back(sensor);
+	this->numberOfPings_m.push_back(0);
+}
+
+std::unique_ptr<GPIO::Pin> GPIO::SimulatedBackend::open(int id) {
+	this->getPinState(id);
+
+	return std::unique_ptr<GPIO::Pin>(new GPIO::SimulatedPin(*this, id));
+}
+
+Clock& GPIO::SimulatedBackend::getClock() {
+	if (this->timeMode_m == TimeMode::virtualTime) {
+		return this->virtualClock_m;
+	}
+	else {
+		return Clock::getSteady();
+	}
+}
+
+VirtualClock& GPIO::SimulatedBackend::getVirtualClock() {
+	return this->virtualClock_m;
+}
+
+uint64_t GPIO::SimulatedBackend::getNumberOfPings(size_t sensorIndex) const {
+	return this->numberOfPings_m.at(sensorIndex);
+}
+
+double GPIO::SimulatedBackend::getTrueDistance(size_t sensorIndex) {
+	return this->sensors_m.at(sensorIndex).getTrajectory().distanceAt(this->getClock().now() - this->startTime_m);
+}
+
+GPIO::SimulatedBackend::PinState& GPIO::SimulatedBackend::getPinState(int id) {
+	auto pinIt = this->pins_m.find(id);
+
+	if (pinIt == this->pins_m.end()) {
+		PinState pinState;
+		pinState.direction = GPIO::Direction::in;
+		pinState.edge = GPIO::Edge::none;
+		pinState.level = false;
+		pinState.sensorIndex = -1;
+		pinState.isEcho = false;
+		pinState.lastEventTime = this->getClock().now();
+
+		pinIt = this->pins_m.insert(std::make_pair(id, pinState)).first;
+	}
+
+	return pinIt->second;
+}
+
+void GPIO::SimulatedBackend::chargeAccess() {
+	if (this->timeMode_m == TimeMode::virtualTime) {
+		this->virtualClock_m.advance(this->accessCost_m);
+	}
+}
+
+void GPIO::SimulatedBackend::waitUntil(std::chrono::steady_clock::time_point timePoint) {
+	if (this->timeMode_m == TimeMode::virtualTime) {
+		this->virtualClock_m.advanceTo(timePoint);
+	}
+	else {
+		std::this_thread::sleep_until(timePoint);
+	}
+}
+
+void GPIO::SimulatedBackend::setPinDirection(int id, GPIO::Direction direction) {
+	this->getPinState(id).direction = direction;
+}
+
+void GPIO::SimulatedBackend::writePin(int id, bool value) {
+	PinState& pinState = this->getPinState(id);
+
+	if (pinState.direction != GPIO::Direction::out) {
+		throw std::runtime_error("Cannot write input gpio " + std::to_string(id));
+	}
+
+	const auto currentTime = this->getClock().now();
+
+	// El sensor emite el pulso con el flanco descendente del pin 'trigger'
+	if ((pinState.sensorIndex != -1) && !pinState.isEcho && pinState.level && !value) {
+		const int sensorIndex = pinState.sensorIndex;
+
+		boost::optional<std::chrono::steady_clock::duration> travelTime = this->sensors_m[sensorIndex].trigger(currentTime, this->startTime_m, this->random_m);
+
+		this->numberOfPings_m[sensorIndex]++;
+
+		// Si el pulso vuelve puede llegar a los otros sensores
+		if (travelTime.is_initialized()) {
+			const auto arrivalTime = currentTime + Simulation::UltrasonicSensor::burstDuration + *travelTime;
+
+			for (size_t i = 0; i < this->sensors_m.size(); i++) {
+				if ((int)i != sensorIndex) {
+					this->sensors_m[i].crosstalk(arrivalTime, this->random_m);
+				}
+			}
+		}
+	}
+
+	pinState.level = value;
+
+	this->chargeAccess();
+}
+
+bool GPIO::SimulatedBackend::readPin(int id) {
+	PinState& pinState = this->getPinState(id);
+
+	bool value;
+
+	if (pinState.isEcho) {
+		value = this->sensors_m[pinState.sensorIndex].echoLevelAt(this->getClock().now());
+	}
+	else {
+		value = pinState.level;
+	}
+
+	this->chargeAccess();
+
+	return value;
+}
+
+void GPIO::SimulatedBackend::setPinEdge(int id, GPIO::Edge edge) {
+	PinState& pinState = this->getPinState(id);
+
+	pinState.edge = edge;
+	pinState.lastEventTime = this->getClock().now();
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::SimulatedBackend::waitForPinEdge(int id, std::chrono::steady_clock::duration timeout) {
+	PinState& pinState = this->getPinState(id);
+
+	const auto deadline = this->getClock().now() + std::max(timeout, std::chrono::steady_clock::duration::zero());
+
+	// Sólo los pines 'echo' cambian solos
+	if (pinState.isEcho && (pinState.edge != GPIO::Edge::none)) {
+		const Simulation::UltrasonicSensor& sensor = this->sensors_m[pinState.sensorIndex];
+
+		boost::optional<std::chrono::steady_clock::time_point> edgeTime = sensor.nextEchoEdge(pinState.lastEventTime);
+
+		while (edgeTime.is_initialized() && (*edgeTime <= deadline)) {
+			const bool level = sensor.echoLevelAt(*edgeTime);
+
+			if ((pinState.edge == GPIO::Edge::both) || (level == (pinState.edge == GPIO::Edge::rising))) {
+				this->waitUntil(*edgeTime);
+
+				pinState.lastEventTime = *edgeTime;
+
+				return GPIO::EdgeEvent(*edgeTime, level);
+			}
+
+			edgeTime = sensor.nextEchoEdge(*edgeTime);
+		}
+	}
+
+	this->waitUntil(deadline);
+
+	return boost::optional<GPIO::EdgeEvent>();
+}
+
+void GPIO::SimulatedBackend::discardPinEdgeEvents(int id) {
+	this->getPinState(id).lastEventTime = this->getClock().now();
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "GPIOBackend.h"
+#include "SimulationUltrasonicSensor.h"
+#include "VirtualClock.h"
+
+#include <map>
+#include <vector>
+#include <random>
+
+namespace GPIO {
+	class SimulatedBackend;
+
+	/*
+	 * Pin de GPIO simulado
+	 */
+	class SimulatedPin final : public GPIO::Pin
+	{
+	public:
+		/**
+		 * @post Crea el pin con el id especificado del backend simulado
+		 */
+		SimulatedPin(GPIO::SimulatedBackend& backend, int id);
+
+		void setDirection(GPIO::Direction direction) override;
+		void write(bool value) override;
+		bool read() override;
+		bool supportsEdgeEvents() override;
+		void setEdge(GPIO::Edge edge) override;
+		boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout) override;
+		void discardEdgeEvents() override;
+
+	private:
+		GPIO::SimulatedBackend& backend_m;
+		const int id_m;
+	};
+
+	/*
+	 * Backend de GPIO simulado, con sensores ultrasónicos modelados.
+	 *
+	 * En tiempo real los ecos ocurren en tiempo de std::chrono::steady_clock.
+	 * En tiempo virtual el tiempo lo lleva un reloj virtual, que avanza un
+	 * costo fijo por cada acceso a un pin y salta al próximo flanco al
+	 * esperar eventos, con lo cual la simulación es determinística y no
+	 * depende de la velocidad de la máquina.
+	 *
+	 * No es thread-safe, tiene que usarse desde un solo thread
+	 */
+	class SimulatedBackend final : public GPIO::Backend
+	{
+	public:
+		enum class TimeMode { realTime, virtualTime };
+
+		/**
+		 * @post Crea el backend con el modo de tiempo, la semilla
+		         de números aleatorios y el costo de acceso a un pin
+				 (Sólo en tiempo virtual) especificados
+		 */
+		SimulatedBackend(TimeMode timeMode, uint32_t seed = 0, std::chrono::steady_clock::duration accessCost = std::chrono::microseconds(1));
+
+		SimulatedBackend(const SimulatedBackend&) = delete;
+		SimulatedBackend& operator=(const SimulatedBackend&) = delete;
+
+		/**
+		 * @pre Los pines del sensor no tienen que estar usados por otro sensor
+		 * @post Agrega el sensor especificado
+		 */
+		void addSensor(Simulation::UltrasonicSensor sensor);
+
+		std::unique_ptr<GPIO::Pin> open(int id) override;
+
+		Clock& getClock() override;
+
+		/**
+		 * @post Devuelve el reloj virtual
+		 */
+		VirtualClock& getVirtualClock();
+
+		/**
+		 * @post Devuelve la cantidad de pulsos emitidos por el sensor
+		         con el índice especificado
+		 */
+		uint64_t getNumberOfPings(size_t sensorIndex) const;
+
+		/**
+		 * @post Devuelve la distancia real de la mano al sensor
+		         con el índice especificado, en el instante actual
+		 */
+		double getTrueDistance(size_t sensorIndex);
+
+	private:
+		friend class GPIO::SimulatedPin;
+
+		// Estado de un pin
+		struct PinState {
+			GPIO::Direction direction;
+			GPIO::Edge edge;
+			bool level; // Valor escrito (Pines que no son 'echo')
+
+			int sensorIndex; // Índice del sensor al que pertenece (-1 si ninguno)
+			bool isEcho; // Indica si es el pin 'echo' del sensor
+
+			std::chrono::steady_clock::time_point lastEventTime; // Instante del último evento de flanco consumido
+		};
+
+		/**
+		 * @post Devuelve el estado del pin, creándolo si no existe
+		 */
+		PinState& getPinState(int id);
+
+		/**
+		 * @post Cobra el costo de un acceso a un pin
+		 */
+		void chargeAccess();
+
+		/**
+		 * @post Espera hasta el instante especificado
+		 */
+		void waitUntil(std::chrono::steady_clock::time_point timePoint);
+
+		void setPinDirection(int id, GPIO::Direction direction);
+		void writePin(int id, bool value);
+		bool readPin(int id);
+		void setPinEdge(int id, GPIO::Edge edge);
+		boost::optional<GPIO::EdgeEvent> waitForPinEdge(int id, std::chrono::steady_clock::duration timeout);
+		void discardPinEdgeEvents(int id);
+
+		const TimeMode timeMode_m;
+		const std::chrono::steady_clock::duration accessCost_m;
+
+		VirtualClock virtualClock_m;
+		const std::chrono::steady_clock::time_point startTime_m; // Comienzo de la simulación
+
+		std::mt19937 random_m;
+
+		std::vector<Simulation::UltrasonicSensor> sensors_m;
+		std::vector<uint64_t> numberOfPings_m;
+
+		std::map<int, PinState> pins_m;
+	};
+}
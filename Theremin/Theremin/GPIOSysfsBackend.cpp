@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIOSysfsBackend.h"
+
+#include <iostream>
+#include <fstream>
+
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+constexpr std::chrono::seconds GPIO::SysfsPin::exportTimeout;
+
+GPIO::SysfsBackend::SysfsBackend(const std::string& sysfsPath) :
+	sysfsPath_m(sysfsPath)
+{
+
+}
+
+std::unique_ptr<GPIO::Pin> GPIO::SysfsBackend::open(int id) {
+	return std::unique_ptr<GPIO::Pin>(new GPIO::SysfsPin(this->sysfsPath_m, id));
+}
+
+GPIO::SysfsPin::SysfsPin(const std::string& sysfsPath, int id)
+{
+	this->sysfsPath = sysfsPath;
+	this->gpioName = std::to_string(id);
+
+	// Intentar exportar el GPIO
+	std::ofstream exportgpio(this->sysfsPath + "/export");
+
+	if (exportgpio.is_open()) {
+		exportgpio << this->gpioName;
+	}
+	else {
+		throw std::runtime_error("Cannot export gpio " + this->gpioName);
+	}
+
+	exportgpio.close();
+
+	this->directionFilename = this->sysfsPath + "/gpio" + this->gpioName + "/direction";
+	this->valueFilename = this->sysfsPath + "/gpio" + this->gpioName + "/value";
+	this->edgeFilename = this->sysfsPath + "/gpio" + this->gpioName + "/edge";
+
+	// Si no se puede abrir el archivo de valor no queda exportado
+	try {
+		this->openValueFile();
+	}
+	catch (...) {
+		this->unexport();
+
+		throw;
+	}
+}
+
+
+GPIO::SysfsPin::~SysfsPin()
+{
+	::close(this->valueFd);
+
+	this->unexport();
+}
+
+void GPIO::SysfsPin::unexport() {
+	// Intentar desexportar el GPIO
+	std::ofstream unexportgpio(this->sysfsPath + "/unexport");
+
+	if (unexportgpio.is_open()) {
+		unexportgpio << this->gpioName;
+	}
+	else {
+		std::cerr  << "Cannot unexport gpio " + this->gpioName;
+	}
+}
+
+void GPIO::SysfsPin::setDirection(GPIO::Direction direction) {
+	const auto deadline = std::chrono::steady_clock::now() + exportTimeout;
+
+	std::ofstream setdirGPIO(this->directionFilename);
+
+	// Al exportar el pin el kernel crea el archivo de forma asíncrona
+	while (!setdirGPIO.is_open()) {
+		if (std::chrono::steady_clock::now() >= deadline) {
+			throw std::runtime_error("Cannot set direction of gpio " + this->gpioName);
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		setdirGPIO.open(this->directionFilename);
+	}
+
+	std::string value;
+
+	switch (direction)
+	{
+	case GPIO::Direction::in:
+		value = "in";
+		break;
+	case GPIO::Direction::out:
+		value = "out";
+		break;
+	default:
+		throw std::runtime_error("Invalid gpio's direction");
+		break;
+	}
+
+	setdirGPIO << value;
+}
+
+void GPIO::SysfsPin::write(bool value) {
+	const char data = (value ? '1' : '0');
+
+	if (::pwrite(this->valueFd, &data, 1, 0) != 1) {
+		throw std::runtime_error("Cannot write gpio " + this->gpioName);
+	}
+}
+
+bool GPIO::SysfsPin::read() {
+	char data;
+
+	if (::pread(this->valueFd, &data, 1, 0) != 1) {
+		throw std::runtime_error("Cannot read gpio " + this->gpioName);
+	}
+
+	return (data != '0');
+}
+
+bool GPIO::SysfsPin::supportsEdgeEvents() {
+	return true;
+}
+
+void GPIO::SysfsPin::setEdge(GPIO::Edge edge) {
+	std::ofstream setedgeGPIO(this->edgeFilename);
+
+	if (!setedgeGPIO.is_open()) {
+		throw std::runtime_error("Cannot set edge of gpio " + this->gpioName);
+	}
+
+	std::string value;
+
+	switch (edge)
+	{
+	case GPIO::Edge::none:
+		value = "none";
+		break;
+	case GPIO::Edge::rising:
+		value = "rising";
+		break;
+	case GPIO::Edge::falling:
+		value = "falling";
+		break;
+	case GPIO::Edge::both:
+		value = "both";
+		break;
+	default:
+		throw std::runtime_error("Invalid gpio's edge");
+		break;
+	}
+
+	setedgeGPIO << value;
+	setedgeGPIO.close();
+
+	// Descartar el evento pendiente que el kernel reporta hasta la primera lectura
+	this->discardEdgeEvents();
+}
+
+void GPIO::SysfsPin::discardEdgeEvents() {
+	// El evento se descarta leyendo el valor
+	this->read();
+}
+
+int GPIO::SysfsPin::getFileDescriptor() {
+	return this->valueFd;
+}
+
+int GPIO::SysfsPin::getEdgeFileDescriptor() {
+	return this->valueFd;
+}
+
+uint32_t GPIO::SysfsPin::getEdgeFileDescriptorEvents() {
+	// Los mismos eventos que espera waitForEdge
+	return EPOLLPRI | EPOLLERR;
+}
+
+boost::optional<GPIO::EdgeEvent> GPIO::SysfsPin::waitForEdge(std::chrono::steady_clock::duration timeout) {
+	if (timeout < std::chrono::steady_clock::duration::zero()) {
+		timeout = std::chrono::steady_clock::duration::zero();
+	}
+
+	const auto timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+
+	struct timespec timeoutSpec;
+	timeoutSpec.tv_sec = (time_t)(timeoutNs / 1000000000);
+	timeoutSpec.tv_nsec = (long)(timeoutNs % 1000000000);
+
+	struct pollfd pollFd;
+	pollFd.fd = this->valueFd;
+	pollFd.events = POLLPRI | POLLERR;
+	pollFd.revents = 0;
+
+	int result;
+
+	do {
+		result = ::ppoll(&pollFd, 1, &timeoutSpec, nullptr);
+	} while (result < 0 && errno == EINTR);
+
+	if (result < 0) {
+		throw std::runtime_error("Cannot poll gpio " + this->gpioName);
+	}
+	else if (result == 0) {
+		return boost::optional<GPIO::EdgeEvent>();
+	}
+	else {
+		// Tomar el timestamp lo antes posible, y después leer el valor (Que además descarta el evento)
+		const auto timestamp = std::chrono::steady_clock::now();
+
+		return GPIO::EdgeEvent(timestamp, this->read());
+	}
+}
+
+void GPIO::SysfsPin::openValueFile() {
+	const auto deadline = std::chrono::steady_clock::now() + exportTimeout;
+
+	do {
+		this->valueFd = ::open(this->valueFilename.c_str(), O_RDWR | O_CLOEXEC);
+
+		if (this->valueFd >= 0) {
+			return;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	} while (std::chrono::steady_clock::now() < deadline);
+
+	throw std::runtime_error("Cannot open gpio value " + this->gpioName);
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "GPIOBackend.h"
+
+#include <string>
+
+namespace GPIO {
+	/*
+	 * Pin de GPIO accedido por sysfs (/sys/class/gpio)
+	 */
+	class SysfsPin final : public GPIO::Pin
+	{
+	public:
+		/**
+		* @post Exporta el pin de GPIO con el id especificado,
+		        en el directorio de sysfs especificado
+		*/
+		SysfsPin(const std::string& sysfsPath, int id);
+
+		SysfsPin(const SysfsPin&) = delete;
+		SysfsPin& operator=(const SysfsPin&) = delete;
+
+		/**
+		* @post Destruye el pin, desexportándolo
+		*/
+		~SysfsPin() override;
+
+		void setDirection(GPIO::Direction direction) override;
+		void write(bool value) override;
+		bool read() override;
+		bool supportsEdgeEvents() override;
+		void setEdge(GPIO::Edge edge) override;
+		boost::optional<GPIO::EdgeEvent> waitForEdge(std::chrono::steady_clock::duration timeout) override;
+		void discardEdgeEvents() override;
+		int getFileDescriptor() override;
+		int getEdgeFileDescriptor() override;
+		uint32_t getEdgeFileDescriptorEvents() override;
+
+	private:
+		/**
+		 * @post Abre el archivo de valor, reintentando hasta que
+		         esté disponible (Al exportar el pin el kernel lo
+				 crea de forma asíncrona)
+		 */
+		void openValueFile();
+
+		/**
+		 * @post Desexporta el pin
+		 */
+		void unexport();
+
+		// Tiempo máximo de espera a que el kernel (O udev) deje disponibles los archivos del pin al exportarlo
+		static constexpr std::chrono::seconds exportTimeout = std::chrono::seconds(1);
+
+		std::string sysfsPath;
+		std::string gpioName;
+
+		std::string valueFilename;
+		std::string directionFilename;
+		std::string edgeFilename;
+
+		int valueFd; // Descriptor del archivo de valor, abierto durante toda la vida del pin
+	};
+
+	/*
+	 * Backend de GPIO por sysfs.
+	 *
+	 * La interfaz está deprecada en el kernel, y no provee
+	 * timestamps de los flancos (Se toman al despertar)
+	 */
+	class SysfsBackend final : public GPIO::Backend
+	{
+	public:
+		/**
+		 * @post Crea el backend con el directorio de sysfs
+		         especificado (Útil para apuntar a un árbol falso)
+		 */
+		SysfsBackend(const std::string& sysfsPath = "/sys/class/gpio");
+
+		std::unique_ptr<GPIO::Pin> open(int id) override;
+
+	private:
+		const std::string sysfsPath_m;
+	};
+}
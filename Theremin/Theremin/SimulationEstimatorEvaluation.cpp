@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SimulationEstimatorEvaluation.h"
+#include "Timestamped.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// Paso de la búsqueda de la latencia
+static const std::chrono::microseconds latencyStep = std::chrono::microseconds(250);
+
+Simulation::EstimatorEvaluation::Score Simulation::EstimatorEvaluation::evaluate(const Simulation::Trace& trace, DistanceSensor::Estimator& estimator, std::chrono::steady_clock::duration horizon, std::chrono::steady_clock::duration maxLatency) {
+	// Estimaciones extrapoladas al horizonte, con su instante
+	std::vector<Timestamped<std::chrono::steady_clock::duration, double>> estimates;
+
+	const std::chrono::steady_clock::time_point startTime;
+
+	Score score;
+	score.numberOfSamples = trace.getSamples().size();
+	score.numberOfEstimates = 0;
+
+	for (const Simulation::Trace::Sample& sample : trace.getSamples()) {
+		estimator.update(startTime + sample.time, sample.measuredDistance);
+
+		boost::optional<DistanceSensor::Estimate> estimate = estimator.getEstimate();
+
+		if (estimate.is_initialized()) {
+			const std::chrono::steady_clock::duration time = sample.time + horizon;
+
+			estimates.push_back(Timestamped<std::chrono::steady_clock::duration, double>(time, estimate->extrapolate(startTime + time)));
+			score.numberOfEstimates++;
+		}
+	}
+
+	/*
+	 * Error cuadrático medio respecto de la distancia real retrasada
+	 * la latencia especificada, sólo con las estimaciones que tienen
+	 * distancia real con todas las latencias, para que sean comparables
+	 */
+	auto errorAt = [&](std::chrono::steady_clock::duration latency, double *maxError) {
+		double sum = 0;
+		size_t count = 0;
+
+		for (auto& estimate : estimates) {
+			boost::optional<double> trueDistance = trace.trueDistanceAt(estimate.timestamp() - latency);
+
+			if (trueDistance.is_initialized() && trace.trueDistanceAt(estimate.timestamp() - maxLatency).is_initialized()) {
+				const double error = estimate.value() - *trueDistance;
+
+				sum += error * error;
+				count++;
+
+				if (maxError != nullptr) {
+					*maxError = std::max(*maxError, std::fabs(error));
+				}
+			}
+		}
+
+		return (count > 0) ? std::sqrt(sum / count) : 0.0;
+	};
+
+	score.maxError = 0;
+	score.rmsError = errorAt(std::chrono::steady_clock::duration::zero(), &score.maxError);
+
+	score.latency = std::chrono::steady_clock::duration::zero();
+	score.rmsErrorAtLatency = score.rmsError;
+
+	for (std::chrono::steady_clock::duration latency = latencyStep; latency <= maxLatency; latency += latencyStep) {
+		const double error = errorAt(latency, nullptr);
+
+		if (error < score.rmsErrorAtLatency) {
+			score.latency = latency;
+			score.rmsErrorAtLatency = error;
+		}
+	}
+
+	return score;
+}
\ No newline at end of file
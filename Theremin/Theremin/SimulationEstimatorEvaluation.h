@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "SimulationTrace.h"
+#include "DistanceSensorEstimator.h"
+
+namespace Simulation {
+	/*
+	 * Evaluación de un estimador de distancia sobre un registro
+	 * de muestras con distancia real: error y latencia
+	 */
+	class EstimatorEvaluation final
+	{
+	public:
+		// Resultado de la evaluación
+		struct Score {
+			size_t numberOfSamples; // Muestras del registro
+			size_t numberOfEstimates; // Muestras después de las que hubo estimación
+			double rmsError; // Error cuadrático medio en metros
+			double maxError; // Error máximo en metros
+			std::chrono::steady_clock::duration latency; // Retraso respecto de la distancia real que minimiza el error cuadrático medio
+			double rmsErrorAtLatency; // Error cuadrático medio en metros, compensando la latencia
+		};
+
+		/**
+		 * @post Evalúa el estimador especificado con el registro especificado.
+		         Después de cada muestra compara la estimación extrapolada al
+				 horizonte especificado (Por ejemplo la latencia del audio) con
+				 la distancia real en ese instante.
+				 La latencia se busca hasta el máximo especificado
+		 */
+		static Score evaluate(const Simulation::Trace& trace, DistanceSensor::Estimator& estimator, std::chrono::steady_clock::duration horizon, std::chrono::steady_clock::duration maxLatency);
+	};
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SimulationTrace.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <iomanip>
+
+Simulation::Trace::Trace() {
+
+}
+
+void Simulation::Trace::add(Sample sample) {
+	if (!this->samples_m.empty() && (sample.time < this->samples_m.back().time)) {
+		throw std::runtime_error("Trace samples must be in temporal order");
+	}
+
+	this->samples_m.push_back(sample);
+}
+
+const std::vector<Simulation::Trace::Sample>& Simulation::Trace::getSamples() const {
+	return this->samples_m;
+}
+
+boost::optional<double> Simulation::Trace::trueDistanceAt(std::chrono::steady_clock::duration time) const {
+	// Primer muestra posterior al instante
+	auto next = std::upper_bound(this->samples_m.begin(), this->samples_m.end(), time,
+		[](std::chrono::steady_clock::duration time, const Sample& sample) { return time < sample.time; }
+	);
+
+	auto previous = next;
+
+	// Muestras con distancia real más próximas antes y después
+	while ((previous != this->samples_m.begin()) && !(previous - 1)->trueDistance.is_initialized()) {
+		--previous;
+	}
+
+	while ((next != this->samples_m.end()) && !next->trueDistance.is_initialized()) {
+		++next;
+	}
+
+	if (previous == this->samples_m.begin()) {
+		return boost::optional<double>();
+	}
+
+	const Sample& before = *(previous - 1);
+
+	if (before.time == time) {
+		return before.trueDistance;
+	}
+
+	if (next == this->samples_m.end()) {
+		return boost::optional<double>();
+	}
+
+	const double fraction = std::chrono::duration<double>(time - before.time).count() / std::chrono::duration<double>(next->time - before.time).count();
+
+	return *before.trueDistance + (*next->trueDistance - *before.trueDistance) * fraction;
+}
+
+void Simulation::Trace::save(std::ostream& stream) const {
+	stream << std::setprecision(9);
+
+	for (const Sample& sample : this->samples_m) {
+		stream << std::chrono::duration<double>(sample.time).count() << ",";
+
+		if (sample.measuredDistance.is_initialized()) {
+			stream << *sample.measuredDistance;
+		}
+
+		stream << ",";
+
+		if (sample.trueDistance.is_initialized()) {
+			stream << *sample.trueDistance;
+		}
+
+		stream << "\n";
+	}
+}
+
+Simulation::Trace Simulation::Trace::load(std::istream& stream) {
+	Simulation::Trace trace;
+
+	std::string line;
+
+	while (std::getline(stream, line)) {
+		if (line.empty()) {
+			continue;
+		}
+
+		std::istringstream lineStream(line);
+		std::string field;
+
+		Sample sample;
+		double seconds;
+
+		if (!std::getline(lineStream, field, ',') || !(std::istringstream(field) >> seconds)) {
+			throw std::runtime_error("Invalid trace line");
+		}
+
+		sample.time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+		double distance;
+
+		if (std::getline(lineStream, field, ',') && (std::istringstream(field) >> distance)) {
+			sample.measuredDistance = distance;
+		}
+
+		if (std::getline(lineStream, field, ',') && (std::istringstream(field) >> distance)) {
+			sample.trueDistance = distance;
+		}
+
+		trace.add(sample);
+	}
+
+	return trace;
+}
+
+Simulation::Trace Simulation::Trace::record(Simulation::UltrasonicSensor sensor, std::chrono::steady_clock::duration length, std::chrono::steady_clock::duration pingPeriod, double maxDistance, unsigned int seed) {
+	Simulation::Trace trace;
+
+	std::mt19937 random(seed);
+
+	const double speedOfSound = sensor.getSpeedOfSound();
+	const std::chrono::steady_clock::duration maxTravelTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(maxDistance * 2.0 / speedOfSound)
+	);
+
+	const std::chrono::steady_clock::time_point startTime;
+	std::chrono::steady_clock::time_point triggerTime = startTime;
+
+	while (triggerTime - startTime < length) {
+		sensor.trigger(triggerTime, startTime, random);
+
+		const std::chrono::steady_clock::time_point echoRise = *sensor.nextEchoEdge(triggerTime);
+
+		// Pulso ajeno en un instante al azar del eco máximo
+		sensor.crosstalk(echoRise + std::chrono::duration_cast<std::chrono::steady_clock::duration>(maxTravelTime * std::uniform_real_distribution<double>(0.0, 1.0)(random)), random);
+
+		const std::chrono::steady_clock::time_point echoFall = *sensor.nextEchoEdge(echoRise);
+		const std::chrono::steady_clock::duration travelTime = echoFall - echoRise;
+
+		Sample sample;
+		sample.time = triggerTime - startTime;
+
+		if (travelTime <= maxTravelTime) {
+			sample.measuredDistance = std::chrono::duration<double>(travelTime).count() * speedOfSound / 2.0;
+
+			// La distancia corresponde al instante en que la onda llegó a la mano, a mitad del viaje
+			sample.time = echoRise + travelTime / 2 - startTime;
+		}
+
+		sample.trueDistance = sensor.getTrajectory().distanceAt(sample.time);
+
+		trace.add(sample);
+
+		triggerTime = std::max(triggerTime + pingPeriod, echoFall);
+	}
+
+	return trace;
+}
\ No newline at end of file
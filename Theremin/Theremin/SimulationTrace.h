@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <istream>
+#include <ostream>
+
+#include <boost/optional.hpp>
+
+#include "SimulationUltrasonicSensor.h"
+
+namespace Simulation {
+	/*
+	 * Registro de las muestras de un sensor de distancia: una por
+	 * impulso, con la distancia medida (Si llegó el eco) y la
+	 * distancia real (Si se conoce), para evaluar estimadores.
+	 *
+	 * Se puede generar con el modelo del sensor, o guardar y
+	 * cargar como CSV (Tiempo en segundos, distancia medida y
+	 * distancia real en metros, vacías si faltan)
+	 */
+	class Trace final
+	{
+	public:
+		// Muestra del registro
+		struct Sample {
+			std::chrono::steady_clock::duration time; // Instante desde el comienzo del registro
+			boost::optional<double> measuredDistance; // Distancia medida (Vacía si no llegó el eco)
+			boost::optional<double> trueDistance; // Distancia real (Vacía si no se conoce)
+		};
+
+		/**
+		 * @post Crea un registro vacío
+		 */
+		Trace();
+
+		/**
+		 * @pre Las muestras se tienen que agregar en orden temporal
+		 * @post Agrega la muestra especificada
+		 */
+		void add(Sample sample);
+
+		/**
+		 * @post Devuelve las muestras
+		 */
+		const std::vector<Sample>& getSamples() const;
+
+		/**
+		 * @post Devuelve la distancia real en el instante especificado,
+		         interpolando linealmente entre las muestras que la tienen,
+				 o vacío si está fuera de ellas
+		 */
+		boost::optional<double> trueDistanceAt(std::chrono::steady_clock::duration time) const;
+
+		/**
+		 * @post Guarda el registro como CSV en el stream especificado
+		 */
+		void save(std::ostream& stream) const;
+
+		/**
+		 * @post Carga un registro como CSV del stream especificado
+		 */
+		static Simulation::Trace load(std::istream& stream);
+
+		/**
+		 * @post Genera el registro de la duración especificada con el
+		         sensor especificado, disparándolo con el período
+				 especificado (O al terminar el eco anterior, si dura más),
+				 y descartando los ecos de distancias mayores a la máxima
+				 como el lector. La interferencia de otros sensores se
+				 simula con un pulso ajeno en un instante al azar de cada eco
+		 */
+		static Simulation::Trace record(Simulation::UltrasonicSensor sensor, std::chrono::steady_clock::duration length, std::chrono::steady_clock::duration pingPeriod, double maxDistance, unsigned int seed);
+
+	private:
+		std::vector<Sample> samples_m;
+	};
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SimulationTrajectory.h"
+
+#include <stdexcept>
+#include <limits>
+
+Simulation::Trajectory::Trajectory() {
+
+}
+
+Simulation::Trajectory Simulation::Trajectory::withPoint(std::chrono::steady_clock::duration time, double distance) {
+	if (!this->points_m.empty() && (time < this->points_m.back().timestamp())) {
+		throw std::runtime_error("Trajectory points must be in temporal order");
+	}
+
+	Simulation::Trajectory newTrajectory = *this;
+
+	newTrajectory.points_m.push_back(Timestamped<std::chrono::steady_clock::duration, double>(time, distance));
+
+	return newTrajectory;
+}
+
+double Simulation::Trajectory::distanceAt(std::chrono::steady_clock::duration time) const {
+	if (this->points_m.empty()) {
+		return std::numeric_limits<double>::infinity();
+	}
+
+	if (time <= this->points_m.front().timestamp()) {
+		return this->points_m.front().value();
+	}
+
+	for (size_t i = 1; i < this->points_m.size(); i++) {
+		const auto& previousPoint = this->points_m[i - 1];
+		const auto& nextPoint = this->points_m[i];
+
+		if (time < nextPoint.timestamp()) {
+			const double fraction = std::chrono::duration<double>(time - previousPoint.timestamp()).count() / std::chrono::duration<double>(nextPoint.timestamp() - previousPoint.timestamp()).count();
+
+			return previousPoint.value() + (nextPoint.value() - previousPoint.value()) * fraction;
+		}
+	}
+
+	return this->points_m.back().value();
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "Timestamped.h"
+
+namespace Simulation {
+	/*
+	 * Trayectoria de la mano: Distancia al sensor en función
+	 * del tiempo, interpolando linealmente entre puntos
+	 */
+	class Trajectory final
+	{
+	public:
+		/**
+		 * @post Crea una trayectoria vacía (Sin mano)
+		 */
+		Trajectory();
+
+		/**
+		 * @pre Los puntos se tienen que especificar en orden temporal
+		 * @post Agrega un punto con la distancia en metros en el
+		         instante especificado, desde el comienzo de la simulación
+		 */
+		Trajectory withPoint(std::chrono::steady_clock::duration time, double distance);
+
+		/**
+		 * @post Devuelve la distancia en el instante especificado.
+		         Antes del primer punto y después del último se mantiene
+				 la distancia del punto más cercano.
+				 Si no hay puntos devuelve infinito
+		 */
+		double distanceAt(std::chrono::steady_clock::duration time) const;
+
+	private:
+		std::vector<Timestamped<std::chrono::steady_clock::duration, double>> points_m;
+	};
+}
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SimulationUltrasonicSensor.h"
+
+#include <cmath>
+
+constexpr std::chrono::microseconds Simulation::UltrasonicSensor::burstDuration;
+constexpr std::chrono::milliseconds Simulation::UltrasonicSensor::noEchoPulseDuration;
+constexpr double Simulation::UltrasonicSensor::maxRange;
+
+Simulation::UltrasonicSensor::UltrasonicSensor() {
+	this->triggerId_m = -1;
+	this->echoId_m = -1;
+
+	this->temperature_m = 20.0;
+	this->noise_m = 0.0;
+	this->dropoutProbability_m = 0.0;
+	this->crosstalkProbability_m = 0.0;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withTriggerId(int id) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.triggerId_m = id;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withEchoId(int id) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.echoId_m = id;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withTrajectory(Simulation::Trajectory trajectory) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.trajectory_m = trajectory;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withTemperature(double temperature) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.temperature_m = temperature;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withNoise(double noise) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.noise_m = noise;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withDropoutProbability(double probability) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.dropoutProbability_m = probability;
+
+	return newSensor;
+}
+
+Simulation::UltrasonicSensor Simulation::UltrasonicSensor::withCrosstalkProbability(double probability) {
+	Simulation::UltrasonicSensor newSensor = *this;
+
+	newSensor.crosstalkProbability_m = probability;
+
+	return newSensor;
+}
+
+int Simulation::UltrasonicSensor::getTriggerId() const {
+	return this->triggerId_m;
+}
+
+int Simulation::UltrasonicSensor::getEchoId() const {
+	return this->echoId_m;
+}
+
+const Simulation::Trajectory& Simulation::UltrasonicSensor::getTrajectory() const {
+	return this->trajectory_m;
+}
+
+double Simulation::UltrasonicSensor::getSpeedOfSound() const {
+	return 331.3 * std::sqrt(1.0 + this->temperature_m / 273.15);
+}
+
+boost::optional<std::chrono::steady_clock::duration> Simulation::UltrasonicSensor::trigger(std::chrono::steady_clock::time_point triggerTime, std::chrono::steady_clock::time_point startTime, std::mt19937& random) {
+	// Mientras el eco anterior no terminó el sensor ignora el disparo
+	if (this->echoFall_m.is_initialized() && (triggerTime < *this->echoFall_m)) {
+		return boost::optional<std::chrono::steady_clock::duration>();
+	}
+
+	double distance = this->trajectory_m.distanceAt(triggerTime - startTime);
+
+	if (this->noise_m > 0.0) {
+		distance += std::normal_distribution<double>(0.0, this->noise_m)(random);
+	}
+
+	const bool isDropout = (this->dropoutProbability_m > 0.0) && std::bernoulli_distribution(this->dropoutProbability_m)(random);
+
+	this->echoRise_m = triggerTime + burstDuration;
+
+	if (isDropout || !(distance <= maxRange) || (distance < 0.0)) {
+		this->echoFall_m = *this->echoRise_m + noEchoPulseDuration;
+
+		return boost::optional<std::chrono::steady_clock::duration>();
+	}
+	else {
+		const std::chrono::steady_clock::duration travelTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(distance * 2.0 / this->getSpeedOfSound())
+		);
+
+		this->echoFall_m = *this->echoRise_m + travelTime;
+
+		return travelTime;
+	}
+}
+
+void Simulation::UltrasonicSensor::crosstalk(std::chrono::steady_clock::time_point arrivalTime, std::mt19937& random) {
+	// Sólo afecta si el sensor está esperando su eco
+	if (this->echoRise_m.is_initialized() && (*this->echoRise_m <= arrivalTime) && (arrivalTime < *this->echoFall_m)) {
+		if ((this->crosstalkProbability_m > 0.0) && std::bernoulli_distribution(this->crosstalkProbability_m)(random)) {
+			this->echoFall_m = arrivalTime;
+		}
+	}
+}
+
+bool Simulation::UltrasonicSensor::echoLevelAt(std::chrono::steady_clock::time_point timePoint) const {
+	return this->echoRise_m.is_initialized() && (*this->echoRise_m <= timePoint) && (timePoint < *this->echoFall_m);
+}
+
+boost::optional<std::chrono::steady_clock::time_point> Simulation::UltrasonicSensor::nextEchoEdge(std::chrono::steady_clock::time_point timePoint) const {
+	if (this->echoRise_m.is_initialized()) {
+		if (timePoint < *this->echoRise_m) {
+			return *this->echoRise_m;
+		}
+		else if (timePoint < *this->echoFall_m) {
+			return *this->echoFall_m;
+		}
+	}
+
+	return boost::optional<std::chrono::steady_clock::time_point>();
+}
\ No newline at end of file
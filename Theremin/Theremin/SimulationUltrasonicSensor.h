@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <random>
+
+#include <boost/optional.hpp>
+
+#include "SimulationTrajectory.h"
+
+namespace Simulation {
+	/*
+	 * Modelo de sensor ultrasónico (HC-SR04).
+	 *
+	 * Al bajar el pin 'trigger' emite un pulso de ultrasonido, y
+	 * el pin 'echo' queda en alto durante el tiempo de ida y vuelta
+	 * de la onda hasta la mano, con ruido, pérdidas de eco e
+	 * interferencia de los pulsos de otros sensores
+	 */
+	class UltrasonicSensor final
+	{
+	public:
+		/**
+		 * @post Crea un sensor sin mano, a 20 grados, sin ruido,
+		         pérdidas ni interferencia
+		 */
+		UltrasonicSensor();
+
+		/**
+		 * @post Especifica el id del pin 'trigger'
+		 */
+		UltrasonicSensor withTriggerId(int id);
+
+		/**
+		 * @post Especifica el id del pin 'echo'
+		 */
+		UltrasonicSensor withEchoId(int id);
+
+		/**
+		 * @post Especifica la trayectoria de la mano
+		 */
+		UltrasonicSensor withTrajectory(Simulation::Trajectory trajectory);
+
+		/**
+		 * @post Especifica la temperatura del aire en celsius
+		 */
+		UltrasonicSensor withTemperature(double temperature);
+
+		/**
+		 * @post Especifica el desvío estándar del ruido de la distancia en metros
+		 */
+		UltrasonicSensor withNoise(double noise);
+
+		/**
+		 * @post Especifica la probabilidad de perder el eco
+		 */
+		UltrasonicSensor withDropoutProbability(double probability);
+
+		/**
+		 * @post Especifica la probabilidad de que el pulso de otro sensor
+		         termine el eco antes de tiempo
+		 */
+		UltrasonicSensor withCrosstalkProbability(double probability);
+
+		/**
+		 * @post Devuelve el id del pin 'trigger'
+		 */
+		int getTriggerId() const;
+
+		/**
+		 * @post Devuelve el id del pin 'echo'
+		 */
+		int getEchoId() const;
+
+		/**
+		 * @post Devuelve la trayectoria de la mano
+		 */
+		const Simulation::Trajectory& getTrajectory() const;
+
+		/**
+		 * @post Devuelve la velocidad del sonido en m/s
+		 */
+		double getSpeedOfSound() const;
+
+		/**
+		 * @post Emite un pulso con el flanco descendente del pin 'trigger'
+		         en el instante especificado, siendo startTime el comienzo
+				 de la simulación. Si el sensor está ocupado lo ignora.
+				 Devuelve el tiempo de vuelo del pulso, o vacío si no
+				 se emitió o no vuelve
+		 */
+		boost::optional<std::chrono::steady_clock::duration> trigger(std::chrono::steady_clock::time_point triggerTime, std::chrono::steady_clock::time_point startTime, std::mt19937& random);
+
+		/**
+		 * @post Aplica la llegada de un pulso ajeno en el instante especificado
+		 */
+		void crosstalk(std::chrono::steady_clock::time_point arrivalTime, std::mt19937& random);
+
+		/**
+		 * @post Devuelve el valor del pin 'echo' en el instante especificado
+		 */
+		bool echoLevelAt(std::chrono::steady_clock::time_point timePoint) const;
+
+		/**
+		 * @post Devuelve el primer flanco del pin 'echo' estrictamente posterior
+		         al instante especificado, o vacío si no hay
+		 */
+		boost::optional<std::chrono::steady_clock::time_point> nextEchoEdge(std::chrono::steady_clock::time_point timePoint) const;
+
+		// Duración de la ráfaga de ultrasonido (8 ciclos a 40 kHz)
+		static constexpr std::chrono::microseconds burstDuration = std::chrono::microseconds(200);
+
+		// Duración del pulso de 'echo' cuando no vuelve la onda
+		static constexpr std::chrono::milliseconds noEchoPulseDuration = std::chrono::milliseconds(38);
+
+		// Alcance máximo en metros
+		static constexpr double maxRange = 4.0;
+
+	private:
+		int triggerId_m;
+		int echoId_m;
+
+		Simulation::Trajectory trajectory_m;
+
+		double temperature_m;
+		double noise_m;
+		double dropoutProbability_m;
+		double crosstalkProbability_m;
+
+		boost::optional<std::chrono::steady_clock::time_point> echoRise_m; // Flanco ascendente del último eco
+		boost::optional<std::chrono::steady_clock::time_point> echoFall_m; // Flanco descendente del último eco
+	};
+}
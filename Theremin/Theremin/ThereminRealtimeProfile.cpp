@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ThereminRealtimeProfile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+constexpr int Theremin::RealtimeProfile::noPriority;
+constexpr int Theremin::RealtimeProfile::noCPU;
+constexpr size_t Theremin::RealtimeProfile::stackPrefaultSize;
+
+Theremin::RealtimeProfile::RealtimeProfile(int priority, int cpu) {
+	this->priority_m = priority;
+	this->cpu_m = cpu;
+}
+
+Theremin::RealtimeProfile::Report Theremin::RealtimeProfile::applyToCurrentThread() const {
+	Theremin::RealtimeProfile::prefaultStack();
+
+	return this->applyToThread(::pthread_self());
+}
+
+Theremin::RealtimeProfile::Report Theremin::RealtimeProfile::applyToThread(pthread_t thread) const {
+	Theremin::RealtimeProfile::Report report;
+
+	report.priorityError = 0;
+	report.affinityError = 0;
+
+	if (this->priority_m != noPriority) {
+		struct sched_param param = {};
+		param.sched_priority = this->priority_m;
+
+		report.priorityError = ::pthread_setschedparam(thread, SCHED_FIFO, &param);
+	}
+
+	if ((this->cpu_m < noCPU) || (this->cpu_m >= CPU_SETSIZE)) {
+		report.affinityError = EINVAL;
+	}
+	else if (this->cpu_m != noCPU) {
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(this->cpu_m, &cpuSet);
+
+		report.affinityError = ::pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet);
+	}
+
+	return report;
+}
+
+int Theremin::RealtimeProfile::getPriority() const {
+	return this->priority_m;
+}
+
+void Theremin::RealtimeProfile::print(std::ostream& output, const std::string& threadName, const Report& report) const {
+	output << threadName << " thread: ";
+
+	if (this->priority_m != noPriority) {
+		output << "SCHED_FIFO priority " << this->priority_m << " " << Theremin::RealtimeProfile::describe(report.priorityError);
+	}
+	else {
+		output << "default scheduling";
+	}
+
+	output << ", ";
+
+	if (this->cpu_m != noCPU) {
+		output << "CPU " << this->cpu_m << " " << Theremin::RealtimeProfile::describe(report.affinityError);
+	}
+	else {
+		output << "any CPU";
+	}
+
+	output << std::endl;
+}
+
+int Theremin::RealtimeProfile::lockMemory() {
+	if (::mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+		return errno;
+	}
+	else {
+		return 0;
+	}
+}
+
+void Theremin::RealtimeProfile::printMemoryLock(std::ostream& output, int error) {
+	output << "Memory lock: " << Theremin::RealtimeProfile::describe(error) << std::endl;
+}
+
+void Theremin::RealtimeProfile::prefaultStack() {
+	// Volátil para que el compilador no elimine las escrituras
+	volatile unsigned char stack[stackPrefaultSize];
+
+	for (size_t i = 0; i < stackPrefaultSize; i += 4096) {
+		stack[i] = 0;
+	}
+
+	(void)stack;
+}
+
+std::string Theremin::RealtimeProfile::describe(int error) {
+	if (error == 0) {
+		return "ok";
+	}
+	else {
+		return std::string("failed (") + std::strerror(error) + ")";
+	}
+}
\ No newline at end of file
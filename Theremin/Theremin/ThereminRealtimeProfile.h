@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <cstddef>
+
+#include <pthread.h>
+
+namespace Theremin {
+	/*
+	 * Perfil de tiempo real de un thread: prioridad de SCHED_FIFO
+	 * y CPU al que se fija.
+	 *
+	 * Aplicarlo requiere privilegios (CAP_SYS_NICE), con lo cual
+	 * puede no tener efecto. En ese caso el thread sigue con la
+	 * planificación predeterminada, y se informa el motivo
+	 */
+	class RealtimeProfile final
+	{
+	public:
+		// Resultado de aplicar el perfil (errno de cada configuración, cero si tuvo efecto)
+		struct Report {
+			int priorityError;
+			int affinityError;
+		};
+
+		static constexpr int noPriority = 0; // No cambiar la política de planificación
+		static constexpr int noCPU = -1; // No fijar el thread a un CPU
+
+		// Cantidad de bytes de la pila que se tocan para que ya estén en memoria
+		static constexpr size_t stackPrefaultSize = 256 * 1024;
+
+		/**
+		 * @post Crea el perfil con la prioridad de SCHED_FIFO (1 a 99)
+		         y el CPU especificados
+		 */
+		RealtimeProfile(int priority, int cpu);
+
+		/**
+		 * @post Aplica el perfil al thread actual, tocando antes su pila
+		         para que no haya fallos de página después, y devuelve
+				 el resultado
+		 */
+		Report applyToCurrentThread() const;
+
+		/**
+		 * @post Aplica la prioridad y el CPU del perfil al thread especificado,
+		         desde cualquier thread (Sin tocar su pila), y devuelve el
+				 resultado
+		 */
+		Report applyToThread(pthread_t thread) const;
+
+		/**
+		 * @post Devuelve la prioridad de SCHED_FIFO
+		 */
+		int getPriority() const;
+
+		/**
+		 * @post Imprime el resultado especificado de aplicar el perfil
+		         al thread con el nombre especificado
+		 */
+		void print(std::ostream& output, const std::string& threadName, const Report& report) const;
+
+		/**
+		 * @post Bloquea en memoria las páginas actuales y futuras del
+		         proceso (mlockall), y devuelve el errno (Cero si tuvo efecto)
+		 */
+		static int lockMemory();
+
+		/**
+		 * @post Imprime el resultado especificado de bloquear la memoria
+		 */
+		static void printMemoryLock(std::ostream& output, int error);
+
+	private:
+		/**
+		 * @post Toca la pila del thread actual hasta stackPrefaultSize bytes
+		 */
+		static void prefaultStack();
+
+		/**
+		 * @post Devuelve la descripción del resultado especificado
+		 */
+		static std::string describe(int error);
+
+		int priority_m;
+		int cpu_m;
+	};
+}
@@ -42,7 +42,7 @@ namespace Theremin {
 	public:
 		/**
 		 * @post Crea un sintetizador de Theremin
-		         con el sampleRate y el tamao de wavetable
+		         con el sampleRate y el tamaño de wavetable
 				 especificado
 		 */
 		Synthesizer(int sampleRate, size_t waveTableSize);
@@ -63,7 +63,7 @@ namespace Theremin {
 		void setFrequency(boost::optional<double> frequency);
 
 		/**
-		 * @post Realiza un tick con el buffer de datos y el nmero de frames especificados
+		 * @post Realiza un tick con el buffer de datos y el número de frames especificados
 		 */
 		void tick(int16_t *data, size_t nFrames);
 
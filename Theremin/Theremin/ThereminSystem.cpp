@@ -33,10 +33,15 @@
 #include "ThereminSystem.h"
 
 #include <cmath>
+#include <chrono>
+#include <thread>
+#include <iostream>
 
 Theremin::System::System() :
 	userInput_m(false),
-	synthesizer_m(sampleRate_m, waveTableSize_m)
+	synthesizer_m(sampleRate_m, waveTableSize_m),
+	audioProfile_m(audioPriority_m, audioCPU_m),
+	isAudioThreadKnown_m(false)
 {
 
 }
@@ -46,6 +51,9 @@ Theremin::System::~System() {
 }
 
 void Theremin::System::run() {
+	// Bloquear la memoria antes de crear los threads, para que sus pilas también queden bloqueadas
+	Theremin::RealtimeProfile::printMemoryLock(std::cout, Theremin::RealtimeProfile::lockMemory());
+
 	stk::Stk::setSampleRate(sampleRate_m);
 
 	Theremin::System system;
@@ -64,28 +72,56 @@ void Theremin::System::run() {
 
 	RtAudio::StreamOptions *options = &(system.streamOptions);
 
-	options->flags = RTAUDIO_ALSA_USE_DEFAULT;
+	// RtAudio crea el thread de audio con planificación de tiempo real, sin hacerlo en el callback
+	options->flags = RTAUDIO_ALSA_USE_DEFAULT | RTAUDIO_SCHEDULE_REALTIME;
 	options->numberOfBuffers = 2;
 	options->streamName = "Theremin";
-	options->priority = 0; // No se usa
+	options->priority = system.audioProfile_m.getPriority();
 
 	RtAudioErrorCallback errorCallback = NULL; // No se usa un callback de error
 
 	/*
 	 * Abre el stream de audio.
 	 */
-	rtAudio.openStream(&outputParameters, nullptr, format, sampleRate_m, &system.bufferFrames, &Theremin::System::rtAudioCallback, userData, nullptr, errorCallback);
+	rtAudio.openStream(&outputParameters, nullptr, format, sampleRate_m, &system.bufferFrames, &Theremin::System::rtAudioCallback, userData, options, errorCallback);
 
 	/* 
 	 * Comienza el stream de audio
-     * Despus de sta operacin la biblioteca invocar el callback en un thread creado por ella.
+     * Después de ésta operación la biblioteca invocará el callback en un thread creado por ella.
 	 */
 	rtAudio.startStream();
 
+	system.reportAudioThreadProfile(std::chrono::seconds(1));
+
+	// La lectura de los sensores se realiza en este thread
+	Theremin::RealtimeProfile sensorProfile(sensorPriority_m, sensorCPU_m);
+
+	sensorProfile.print(std::cout, "Sensor", sensorProfile.applyToCurrentThread());
+
 	// Realiza la lectura de los sensores de entrada (Bloqueante)
 	system.userInput_m.doReading();
 }
 
+void Theremin::System::reportAudioThreadProfile(std::chrono::steady_clock::duration timeout) {
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	while (!this->isAudioThreadKnown_m.load(std::memory_order_acquire)) {
+		if (std::chrono::steady_clock::now() >= deadline) {
+			std::cout << "Audio thread: not started, realtime profile not applied" << std::endl;
+
+			return;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	/*
+	 * Pasarlo a SCHED_FIFO (RtAudio usa SCHED_RR) y fijarlo al CPU desde este thread.
+	 * Su pila ya quedó en memoria por el bloqueo de memoria (MCL_FUTURE), que es anterior a su creación
+	 */
+	this->audioProfile_m.print(std::cout, "Audio", this->audioProfile_m.applyToThread(this->audioThread_m));
+}
+
 double Theremin::System::pitchToFrequency(double pitch) {
 	return std::pow(2.0, 1.0 / 12.0 * (pitch - 49.0)) * 440.0;
 }
@@ -93,6 +129,13 @@ double Theremin::System::pitchToFrequency(double pitch) {
 int Theremin::System::rtAudioCallback(void *outputBuffer, void *inputBuffer, unsigned int nFrames, double streamTime, RtAudioStreamStatus status, void *userData) {
 	Theremin::System *self = static_cast<Theremin::System *>(userData);
 
+	// La primera vez informar el thread de audio, que crea RtAudio, para aplicarle el perfil de tiempo real desde afuera
+	if (!self->isAudioThreadKnown_m.load(std::memory_order_relaxed)) {
+		self->audioThread_m = ::pthread_self();
+
+		self->isAudioThreadKnown_m.store(true, std::memory_order_release);
+	}
+
 	// Setear volumen
 	self->synthesizer_m.setVolume(self->userInput_m.getVolume());
 
@@ -117,6 +160,6 @@ int Theremin::System::rtAudioCallback(void *outputBuffer, void *inputBuffer, uns
 	// Sintetizar
 	self->synthesizer_m.tick( static_cast<int16_t *>(outputBuffer), (size_t)nFrames);
 
-	// Para continuar la operacin del stream
+	// Para continuar la operación del stream
 	return 0;
 }
\ No newline at end of file
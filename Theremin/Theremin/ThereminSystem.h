@@ -33,6 +33,9 @@
 #pragma once 
 #include "ThereminUserInput.h"
 #include "ThereminSynthesizer.h"
+#include "ThereminRealtimeProfile.h"
+
+#include <atomic>
 
 #include <stk/RtAudio.h>
 #include <stk/Stk.h>
@@ -42,7 +45,7 @@ namespace Theremin {
 	{
 	public:
 		/**
-		 * @post Realiza la ejecucin del sistema de Theremin
+		 * @post Realiza la ejecución del sistema de Theremin
 		 */
 		static void run();
 
@@ -63,9 +66,9 @@ namespace Theremin {
 		static double pitchToFrequency(double pitch);
 
 		/**
-		 * @post Realiza la operacin de sntesis de audio.
+		 * @post Realiza la operación de síntesis de audio.
 		         Es un callback de STK, que es invocado
-				 cuando la biblioteca necesita la sntesis
+				 cuando la biblioteca necesita la síntesis
 				 de nuevas muestras.
 
 				 userData: Es un puntero al sistema de Theremin
@@ -81,8 +84,25 @@ namespace Theremin {
 		static constexpr unsigned int sampleRate_m = 44100;
 		static constexpr unsigned int waveTableSize_m = 4096;
 
+		// Perfiles de tiempo real, con los threads en CPUs distintos para que no compitan
+		static constexpr int audioPriority_m = 80;
+		static constexpr int audioCPU_m = 3;
+		static constexpr int sensorPriority_m = 70;
+		static constexpr int sensorCPU_m = 2;
+
+		/**
+		 * @post Espera a que arranque el thread de audio, durante el tiempo
+		         máximo especificado, le aplica el perfil de tiempo real desde
+				 este thread (Fuera del camino del audio) e imprime el resultado
+		 */
+		void reportAudioThreadProfile(std::chrono::steady_clock::duration timeout);
+
 		unsigned int bufferFrames; // Longitud del buffer de audio que le llega al callback
 
 		RtAudio::StreamOptions streamOptions;
+
+		Theremin::RealtimeProfile audioProfile_m;
+		pthread_t audioThread_m; // Thread de audio, que crea RtAudio
+		std::atomic<bool> isAudioThreadKnown_m; // Indica si el callback ya informó el thread de audio
 	};
 }
@@ -37,26 +37,44 @@
 #include <cmath>
 
 Theremin::UserInput::UserInput(bool backgroundThread) :
+	UserInput(backgroundThread, GPIO::Backend::getDefault())
+{
+
+}
+
+Theremin::UserInput::UserInput(bool backgroundThread, GPIO::Backend& backend) :
+   echoBank_m(backend),
    volumeSensorContext_m(
 		DistanceSensor::Configuration()
-		.withEchoId(26)
-		.withTriggerId(19)
+		.withEchoId(volumeEchoId)
+		.withTriggerId(volumeTriggerId)
 		.withNumberOfSamples(10)
+		.withSampling(DistanceSensor::Sampling::sliding)
+		.withEstimation(DistanceSensor::Estimation::kalman)
 		.withExpectedTemperature(20)
 		.withMaxDistance(volumeMaxDistance_m)
+		.withGPIOBackend(&backend)
+		.withEchoBank(&this->echoBank_m)
 	),
     pitchSensorContext_m(
 	   DistanceSensor::Configuration()
-	      .withEchoId(13)
-		  .withTriggerId(6)
+	      .withEchoId(pitchEchoId)
+		  .withTriggerId(pitchTriggerId)
 	      .withNumberOfSamples(10)
+	      .withSampling(DistanceSensor::Sampling::sliding)
+	      .withEstimation(DistanceSensor::Estimation::kalman)
 	      .withExpectedTemperature(20)
 	      .withMaxDistance(pitchMaxDistance_m)
-    )
+	      .withGPIOBackend(&backend)
+	      .withEchoBank(&this->echoBank_m)
+    ),
+	inbox_m(CPSSched::defaultInboxCapacity),
+	clock_m(backend.getClock())
 {
-	this->stop_m = false;
+	this->sensorGroup_m.add(this->volumeSensorContext_m);
+	this->sensorGroup_m.add(this->pitchSensorContext_m);
 
-	if (this->backgroundThread_m) {
+	if (backgroundThread) {
 		this->backgroundThread_m = std::unique_ptr<std::thread>(
 				new std::thread(
 					[this]() { this->doReading_internal(); }
@@ -67,9 +85,10 @@ Theremin::UserInput::UserInput(bool backgroundThread) :
 
 Theremin::UserInput::~UserInput()
 {
-	this->stop_m = true;
-	
 	if (this->backgroundThread_m.get() != nullptr) {
+		// Si todavía no empezó la lectura, se ejecuta al empezar
+		this->inbox_m.post(Cont(Theremin::UserInput::stopState, this));
+
 		this->backgroundThread_m->join();
 	}
 }
@@ -116,28 +135,28 @@ boost::optional<double> Theremin::UserInput::getRelativePitch() {
 	}
 }
 
+DistanceSensor::Group::Snapshot Theremin::UserInput::getSensorGroupSnapshot() const {
+	return this->sensorGroup_m.getSnapshot();
+}
+
+CPSHistogram::Snapshot Theremin::UserInput::getSensorLatencyStatistics(size_t sensorIndex) const {
+	return this->sensorGroup_m.getLatencyStatistics(sensorIndex);
+}
+
 void Theremin::UserInput::doReading_internal() {
 	runCPS(Cont(Theremin::UserInput::initialState, this));
 }
 
 Cont Theremin::UserInput::initialState(Theremin::UserInput *userInput) {
-	return CPSSched::fork(
-		Cont(Theremin::UserInput::readSensor, &(userInput->volumeSensorContext_m)),
-		Cont(Theremin::UserInput::readSensor, &(userInput->pitchSensorContext_m))
-	);
-}
+	CPSSched::setInbox(&userInput->inbox_m);
+
+	// Con el backend simulado en tiempo virtual las esperas se saltan en lugar de dormirse
+	CPSSched::setClock(userInput->clock_m);
 
-Cont Theremin::UserInput::readSensor(DistanceSensor::SynchronizedContext *context) {
-	return context->update(
-		Cont(Theremin::UserInput::readSensor, context)
-	);
+	// Los sensores comparten el espacio, si emiten a la vez uno puede tomar el pulso del otro como eco
+	return userInput->sensorGroup_m.run();
 }
 
-Cont Theremin::UserInput::checkStopCondition(Theremin::UserInput *userInput) {
-	if (userInput->stop_m) {
-		return CPS_EXIT;
-	}
-	else {
-		return CPSSched::waitFor(std::chrono::milliseconds(100), Cont(Theremin::UserInput::checkStopCondition, userInput));
-	}
+Cont Theremin::UserInput::stopState(Theremin::UserInput *) {
+	return CPS_EXIT;
 }
\ No newline at end of file
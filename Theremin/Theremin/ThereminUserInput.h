@@ -33,9 +33,11 @@
 #pragma once
 #include "Cont.h"
 #include "DistanceSensorSynchronizedContext.h"
+#include "DistanceSensorGroup.h"
+#include "GPIOBank.h"
+#include "CPSInbox.h"
 
 #include <thread>
-#include <atomic>
 #include <memory>
 
 namespace Theremin {
@@ -48,13 +50,20 @@ namespace Theremin {
 		 */
 		UserInput(bool backgroundThread);
 
+		/**
+		 * @post Crea el lector de sensores con el backend de GPIO
+		         especificado, indicando si tiene que arrancar
+		         en segundo plano
+		 */
+		UserInput(bool backgroundThread, GPIO::Backend& backend);
+
 		/**
 		 * @post Destruye el lector de sensores
 		 */
 		~UserInput();
 
 		/**
-		 * @post Realiza la lectura de los sensores si no est en segundo plano.
+		 * @post Realiza la lectura de los sensores si no está en segundo plano.
 		 */
 		void doReading();
 
@@ -68,6 +77,26 @@ namespace Theremin {
 		 */
 		boost::optional<double> getRelativePitch();
 
+		/**
+		 * @post Devuelve el estado de la lectura por turnos de los
+		         sensores (Volumen y pitch), desde cualquier thread
+		 */
+		DistanceSensor::Group::Snapshot getSensorGroupSnapshot() const;
+
+		/**
+		 * @post Devuelve la estadística de la latencia de las lecturas del
+		         sensor especificado (0 volumen, 1 pitch), desde que emite
+				 hasta que publica la estimación, en nanosegundos,
+				 desde cualquier thread
+		 */
+		CPSHistogram::Snapshot getSensorLatencyStatistics(size_t sensorIndex) const;
+
+		// Pines de los sensores
+		static constexpr int volumeEchoId = 26;
+		static constexpr int volumeTriggerId = 19;
+		static constexpr int pitchEchoId = 13;
+		static constexpr int pitchTriggerId = 6;
+
 	private:
 		/**
 		 * @post Realiza la lectura de los sensores en el thread
@@ -81,14 +110,9 @@ namespace Theremin {
 		static Cont initialState(Theremin::UserInput *userInput);
 
 		/**
-		 * @post Lee el sensor
-		 */
-		static Cont readSensor(DistanceSensor::SynchronizedContext *context);
-
-		/**
-		 * @post Revisa si hay peticin de cierre
+		 * @post Termina la lectura (Encolada desde otro thread)
 		 */
-		static Cont checkStopCondition(Theremin::UserInput *userInput);
+		static Cont stopState(Theremin::UserInput *userInput);
 
 		static constexpr double volumeMinDistance_m = 0.06;
 		static constexpr double volumeMaxDistance_m = 0.4;
@@ -98,10 +122,15 @@ namespace Theremin {
 
 		std::unique_ptr<std::thread> backgroundThread_m;
 
+		GPIO::Bank echoBank_m; // Conjunto de los pines 'echo', para muestrearlos juntos
+
 		DistanceSensor::SynchronizedContext volumeSensorContext_m;
 		DistanceSensor::SynchronizedContext pitchSensorContext_m;
 
-		std::atomic<bool> stop_m;
+		DistanceSensor::Group sensorGroup_m; // Lee los sensores por turnos, para que no se interfieran
+
+		CPSInbox inbox_m; // Bandeja de entrada del scheduler de la lectura, para pedir el cierre sin que tenga que revisarlo periódicamente
+		Clock& clock_m; // Reloj del scheduler de la lectura (El del backend de GPIO, virtual en simulaciones)
 	};
 
 }
@@ -59,7 +59,7 @@ public:
 		return this->value_m;
 	}
 
-	// Clase de comparacin temporal
+	// Clase de comparación temporal
 	class TimeCompare : std::less<Timestamped>
 	{
 	public:
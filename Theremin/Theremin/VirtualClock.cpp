@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "VirtualClock.h"
+
+VirtualClock::VirtualClock() :
+	// Empezar en un segundo entero, para que las esperas caigan siempre en los mismos instantes relativos
+	ticks_m(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+	).count())
+{
+
+}
+
+std::chrono::steady_clock::time_point VirtualClock::now() {
+	return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(this->ticks_m.load()));
+}
+
+void VirtualClock::advance(std::chrono::steady_clock::duration duration) {
+	if (duration > std::chrono::steady_clock::duration::zero()) {
+		this->ticks_m += duration.count();
+	}
+}
+
+void VirtualClock::advanceTo(std::chrono::steady_clock::time_point timePoint) {
+	std::chrono::steady_clock::rep ticks = timePoint.time_since_epoch().count();
+	std::chrono::steady_clock::rep currentTicks = this->ticks_m.load();
+
+	while ((currentTicks < ticks) && !this->ticks_m.compare_exchange_weak(currentTicks, ticks));
+}
+
+bool VirtualClock::skipTo(std::chrono::steady_clock::time_point timePoint) {
+	this->advanceTo(timePoint);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Clock.h"
+
+#include <atomic>
+
+/*
+ * Reloj virtual: El tiempo sólo avanza cuando se lo indica explícitamente.
+ *
+ * Empieza en el instante actual de std::chrono::steady_clock truncado
+ * al segundo, para que sus timestamps sean comparables con los reales
+ * y las esperas caigan siempre en los mismos instantes relativos
+ */
+class VirtualClock final : public Clock
+{
+public:
+	/**
+	 * @post Crea el reloj virtual
+	 */
+	VirtualClock();
+
+	std::chrono::steady_clock::time_point now() override;
+
+	/**
+	 * @post Avanza el tiempo la duración especificada
+	 */
+	void advance(std::chrono::steady_clock::duration duration);
+
+	/**
+	 * @post Avanza el tiempo hasta el instante especificado,
+	         si es posterior al actual
+	 */
+	void advanceTo(std::chrono::steady_clock::time_point timePoint);
+
+	bool skipTo(std::chrono::steady_clock::time_point timePoint) override;
+
+private:
+	std::atomic<std::chrono::steady_clock::rep> ticks_m; // Tiempo actual desde la época de steady_clock
+};
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/*
+ * Benchmarks y pruebas del Theremin.
+ *
+ * Cada caso es una función que recibe los argumentos que siguen a su
+ * nombre en la línea de comandos, imprime sus resultados y devuelve el
+ * código de salida del programa (Distinto de cero si la prueba falla)
+ */
+namespace Benchmark
+{
+	typedef int (*Function)(int argc, char **argv);
+
+	struct Case {
+		const char *name;
+		const char *description;
+		Benchmark::Function function;
+	};
+
+	/**
+	 * @post Prueba que yield, fork, waitFor y las lecturas del sensor
+	         no reservan memoria después del calentamiento
+	 */
+	int allocations(int argc, char **argv);
+
+	/**
+	 * @post Mide el retraso de un timer periódico con y sin plazo,
+	         compitiendo con hilos de ejecución que hacen yield.
+			 Argumento opcional: cantidad de esos hilos
+	 */
+	int dispatchLatency(int argc, char **argv);
+
+	/**
+	 * @post Mide el costo de leer un pin por sysfs, sobre un árbol falso.
+	         Argumento opcional: directorio del árbol (En tmpfs)
+	 */
+	int sysfsRead(int argc, char **argv);
+
+	/**
+	 * @post Mide el error de medición del tiempo del 'echo' por polling
+	         y por flancos, con un sensor simulado.
+			 Argumento opcional: "realtime" para correr en tiempo real
+	 */
+	int echoTiming(int argc, char **argv);
+
+	/**
+	 * @post Cuenta las syscalls por lectura con asyncRead y con pread.
+	         Argumentos opcionales: cantidad de hilos de ejecución
+			 leyendo y archivo leído (En tmpfs)
+	 */
+	int asyncIOSyscalls(int argc, char **argv);
+
+	/**
+	 * @post Mide el costo de agregar y vencer esperas de tiempo en la
+	         rueda de tiempo, con 10, 1000 y 100000 esperas pendientes
+	 */
+	int timingWheel(int argc, char **argv);
+
+	/**
+	 * @post Mide las continuaciones por segundo del conjunto de workers
+	         con 1, 2, 4... workers.
+			 Argumento opcional: cantidad máxima de workers
+	 */
+	int workerScaling(int argc, char **argv);
+
+	/**
+	 * @post Mide el costo de yield y de esperar una corrutina hija
+	         en las corrutinas, respecto de yield en continuaciones
+	 */
+	int coroutineTransitions(int argc, char **argv);
+
+	/**
+	 * @post Mide las transiciones por segundo de CPSStateMachine,
+	         respecto de las continuaciones
+	 */
+	int stateMachineTransitions(int argc, char **argv);
+
+	/**
+	 * @post Imprime la evaluación de cada estimador de distancia con
+	         los registros CSV especificados, o con uno de ejemplo.
+			 Argumentos: [--horizon <ms>] [--save <archivo>] [<registro.csv>...]
+	 */
+	int estimators(int argc, char **argv);
+
+	/**
+	 * @post Mide las lecturas por segundo, la latencia y el tiempo de
+	         CPU de la lectura de la entrada, con los sensores simulados
+			 en tiempo virtual y en tiempo real
+	 */
+	int pipeline(int argc, char **argv);
+
+	/**
+	 * @post Mide las lecturas por segundo de cada sensor de grupos de
+	         2, 4 y 8 sensores simulados, por turnos y libremente
+	 */
+	int sensorGroup(int argc, char **argv);
+
+	/**
+	 * @post Mide las lecturas por segundo y la respuesta a un salto
+	         de la mano, con muestreo por lotes y con ventana deslizante
+	 */
+	int sampling(int argc, char **argv);
+
+	/**
+	 * @post Mide las lecturas por segundo, las muestras por lectura
+	         y el error del muestreo por lotes y del adaptativo, con
+			 distintos niveles de ruido
+	 */
+	int adaptiveSampling(int argc, char **argv);
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "DistanceSensorReader.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+/*
+ * Lecturas por segundo, muestras por lectura y error, leyendo un
+ * sensor simulado por lotes de 10 muestras y con muestreo adaptativo
+ * (Hasta que 3 muestras consecutivas coinciden dentro de 5 mm, o hasta
+ * 20 muestras), con la mano quieta a 0.2 m y distintos niveles de ruido,
+ * ecos perdidos e interferencia. Se mide durante 5 s después de la
+ * inicialización del sensor (Que tarda 0.5 s). Corre en tiempo virtual
+ */
+
+// Distancia de la mano
+static const double handDistance = 0.2;
+
+// Intervalo medido (Después de la inicialización)
+static const std::chrono::milliseconds measurementStartTime = std::chrono::milliseconds(500);
+static const std::chrono::milliseconds measurementEndTime = std::chrono::milliseconds(5500);
+
+// Condición del sensor
+struct SensorCondition {
+	const char *name;
+	double noise;
+	double dropoutProbability; // También la probabilidad de interferencia
+};
+
+struct AdaptiveSamplingTest {
+	DistanceSensor::Reader *reader;
+	std::chrono::steady_clock::time_point startTime;
+
+	uint64_t numberOfUpdates;
+	double sumOfSquaredErrors;
+	double maxError;
+};
+
+static Cont readDistance(AdaptiveSamplingTest *test);
+
+static Cont onDistance(AdaptiveSamplingTest *test, boost::optional<double> distance) {
+	const auto time = CPSSched::now() - test->startTime;
+
+	if ((time >= measurementStartTime) && distance.is_initialized()) {
+		const double error = *distance - handDistance;
+
+		test->numberOfUpdates++;
+		test->sumOfSquaredErrors += error * error;
+		test->maxError = std::max(test->maxError, std::fabs(error));
+	}
+
+	if (time >= measurementEndTime) {
+		return CPS_EXIT;
+	}
+
+	return Cont(readDistance, test);
+}
+
+static Cont readDistance(AdaptiveSamplingTest *test) {
+	return test->reader->read(PCont<boost::optional<double>>(onDistance, test));
+}
+
+int Benchmark::adaptiveSampling(int, char **) {
+	static const SensorCondition conditions[] = {
+		{ "1 mm noise", 0.001, 0 },
+		{ "1 mm noise, 5% dropout", 0.001, 0.05 },
+		{ "4 mm noise, 5% dropout", 0.004, 0.05 },
+		{ "10 mm noise, 10% dropout", 0.01, 0.1 }
+	};
+
+	std::cout << "Hand still at " << handDistance << " m, batch of 10 vs adaptive (3 samples within 5 mm, at most 20), dropout also as crosstalk" << std::endl;
+
+	for (const SensorCondition& condition : conditions) {
+		std::cout << condition.name << ":" << std::endl;
+
+		for (DistanceSensor::Sampling sampling : { DistanceSensor::Sampling::batch, DistanceSensor::Sampling::adaptive }) {
+			GPIO::SimulatedBackend backend(GPIO::SimulatedBackend::TimeMode::virtualTime, 1);
+
+			backend.addSensor(
+				Simulation::UltrasonicSensor()
+				.withTriggerId(19)
+				.withEchoId(26)
+				.withTemperature(20)
+				.withNoise(condition.noise)
+				.withDropoutProbability(condition.dropoutProbability)
+				.withCrosstalkProbability(condition.dropoutProbability)
+				.withTrajectory(Simulation::Trajectory().withPoint(std::chrono::seconds(0), handDistance))
+			);
+
+			DistanceSensor::Reader reader(
+				DistanceSensor::Configuration()
+				.withEchoId(26)
+				.withTriggerId(19)
+				.withNumberOfSamples(10)
+				.withSampling(sampling)
+				.withSampleTolerance(0.005)
+				.withMaxNumberOfSamples(20)
+				.withEstimation(DistanceSensor::Estimation::median)
+				.withExpectedTemperature(20)
+				.withMaxDistance(0.4)
+				.withGPIOBackend(&backend)
+			);
+
+			AdaptiveSamplingTest test;
+			test.reader = &reader;
+			test.startTime = backend.getClock().now();
+			test.numberOfUpdates = 0;
+			test.sumOfSquaredErrors = 0;
+			test.maxError = 0;
+
+			CPSSched::create();
+			CPSSched::setClock(backend.getClock());
+			runCPS(Cont(readDistance, &test));
+			CPSSched::destroy();
+
+			const CPSHistogram::Snapshot numberOfSamples = reader.getNumberOfSamplesStatistics();
+			const double measurementTime = std::chrono::duration<double>(measurementEndTime - measurementStartTime).count();
+
+			std::cout << "  " << std::left << std::setw(9) << ((sampling == DistanceSensor::Sampling::batch) ? "batch" : "adaptive") << std::right
+				<< std::fixed << std::setprecision(1) << std::setw(6) << test.numberOfUpdates / measurementTime << " updates/s"
+				<< ", samples/read mean " << std::setw(4) << numberOfSamples.getMean()
+				<< " p50 " << std::setw(2) << numberOfSamples.getPercentile(50)
+				<< " max " << std::setw(2) << numberOfSamples.getMax()
+				<< ", error rms " << std::setw(4) << std::sqrt(test.sumOfSquaredErrors / std::max<uint64_t>(test.numberOfUpdates, 1)) * 1000 << " mm"
+				<< " max " << std::setw(5) << test.maxError * 1000 << " mm" << std::endl;
+
+			std::cout.unsetf(std::ios::floatfield);
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
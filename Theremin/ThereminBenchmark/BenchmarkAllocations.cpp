@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+#include "BenchmarkAllocationCounter.h"
+
+#include "CPSSched.h"
+#include "DistanceSensorReader.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+
+/*
+ * Un hilo de ejecución que alterna yield, fork y waitFor, con un hijo
+ * que espera y termina en cada fork, junto con un Reader leyendo un
+ * sensor simulado. Todo corre con el reloj virtual, así que la prueba
+ * es determinística.
+ * Cuenta las reservas de memoria después de las primeras lecturas,
+ * cuando ya se crearon todas las estructuras del scheduler y del Reader
+ */
+
+// Lecturas de calentamiento
+static const uint64_t numberOfWarmUpReadings = 10;
+
+// Lecturas medidas
+static const uint64_t numberOfMeasuredReadings = 100;
+
+struct AllocationsTest {
+	GPIO::SimulatedBackend *backend;
+	DistanceSensor::Reader *reader;
+
+	uint64_t numberOfReadings;
+	uint64_t numberOfSteps;
+	uint64_t numberOfSchedulerCalls;
+
+	uint64_t allocationsAfterWarmUp;
+	uint64_t numberOfAllocations;
+};
+
+static Cont loopStep(AllocationsTest *test);
+
+static Cont childEnd(AllocationsTest *test) {
+	test->numberOfSchedulerCalls++;
+
+	return CPSSched::finish();
+}
+
+static Cont childStart(AllocationsTest *test) {
+	test->numberOfSchedulerCalls++;
+
+	return CPSSched::waitFor(std::chrono::microseconds(5), Cont(childEnd, test));
+}
+
+static Cont loopStep(AllocationsTest *test) {
+	test->numberOfSteps++;
+	test->numberOfSchedulerCalls++;
+
+	switch (test->numberOfSteps % 3) {
+	case 0:
+		return CPSSched::waitFor(std::chrono::microseconds(1), Cont(loopStep, test));
+
+	case 1:
+		return CPSSched::yield(Cont(loopStep, test));
+
+	default:
+		return CPSSched::fork(Cont(loopStep, test), Cont(childStart, test));
+	}
+}
+
+static Cont readDistance(AllocationsTest *test);
+
+static Cont onDistance(AllocationsTest *test, boost::optional<double>) {
+	test->numberOfReadings++;
+
+	if (test->numberOfReadings == numberOfWarmUpReadings) {
+		test->allocationsAfterWarmUp = Benchmark::AllocationCounter::getNumberOfAllocations();
+		test->numberOfSchedulerCalls = 0;
+	}
+	else if (test->numberOfReadings == numberOfWarmUpReadings + numberOfMeasuredReadings) {
+		test->numberOfAllocations = Benchmark::AllocationCounter::getNumberOfAllocations() - test->allocationsAfterWarmUp;
+
+		return CPS_EXIT;
+	}
+
+	return Cont(readDistance, test);
+}
+
+static Cont readDistance(AllocationsTest *test) {
+	return test->reader->read(PCont<boost::optional<double>>(onDistance, test));
+}
+
+static Cont startTest(AllocationsTest *test) {
+	CPSSched::setClock(test->backend->getClock());
+
+	return CPSSched::fork(Cont(readDistance, test), Cont(loopStep, test));
+}
+
+int Benchmark::allocations(int, char **) {
+	GPIO::SimulatedBackend backend(GPIO::SimulatedBackend::TimeMode::virtualTime, 1);
+
+	backend.addSensor(
+		Simulation::UltrasonicSensor()
+		.withTriggerId(19)
+		.withEchoId(26)
+		.withTrajectory(
+			Simulation::Trajectory()
+			.withPoint(std::chrono::seconds(0), 0.1)
+			.withPoint(std::chrono::seconds(2), 0.3)
+		)
+		.withNoise(0.002)
+		.withDropoutProbability(0.05)
+	);
+
+	DistanceSensor::Reader reader(
+		DistanceSensor::Configuration()
+		.withEchoId(26)
+		.withTriggerId(19)
+		.withNumberOfSamples(10)
+		.withExpectedTemperature(20)
+		.withMaxDistance(0.4)
+		.withGPIOBackend(&backend)
+	);
+
+	AllocationsTest test = { &backend, &reader, 0, 0, 0, 0, 0 };
+
+	CPSSched::create();
+	runCPS(Cont(startTest, &test));
+	CPSSched::destroy();
+
+	std::cout << test.numberOfSchedulerCalls << " yield/fork/waitFor calls and " << numberOfMeasuredReadings << " readings after warm-up: " << test.numberOfAllocations << " allocations" << std::endl;
+
+	return (test.numberOfAllocations == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Cantidad de syscalls para leer un archivo (Como el archivo de valor de
+ * un pin por sysfs) desde varios hilos de ejecución a la vez, con
+ * asyncRead (io_uring, las lecturas pendientes se envían juntas) y con
+ * pread seguido de yield (Como el polling síncrono: una syscall por
+ * lectura).
+ * Con asyncRead sólo cuenta los io_uring_enter: las esperas del
+ * scheduler en epoll cuando no tiene nada para ejecutar son aparte
+ */
+
+// Archivo leído por defecto
+static const char *defaultFilename = "/dev/shm/theremin-asyncio";
+
+// Cantidad de hilos de ejecución leyendo por defecto
+static const long defaultNumberOfStrands = 8;
+
+// Cantidad total de lecturas de cada medición
+static const uint64_t numberOfReads = 200000;
+
+struct AsyncIOStrand;
+
+struct AsyncIOTest {
+	int fd;
+	bool useAsyncIO;
+	AsyncIOStrand *strands;
+	long numberOfStrandsToStart;
+	uint64_t numberOfReads;
+	uint64_t numberOfFailedReads;
+};
+
+struct AsyncIOStrand {
+	AsyncIOTest *test;
+	char buffer[2];
+};
+
+static Cont asyncReadValue(AsyncIOStrand *strand);
+
+static Cont onAsyncRead(AsyncIOStrand *strand, ssize_t result) {
+	if (result <= 0) {
+		strand->test->numberOfFailedReads++;
+	}
+
+	if (++strand->test->numberOfReads == numberOfReads) {
+		return CPS_EXIT;
+	}
+
+	return Cont(asyncReadValue, strand);
+}
+
+static Cont asyncReadValue(AsyncIOStrand *strand) {
+	return CPSSched::asyncRead(strand->test->fd, strand->buffer, sizeof(strand->buffer), 0, PCont<ssize_t>(onAsyncRead, strand));
+}
+
+static Cont syncReadValue(AsyncIOStrand *strand) {
+	if (::pread(strand->test->fd, strand->buffer, sizeof(strand->buffer), 0) <= 0) {
+		strand->test->numberOfFailedReads++;
+	}
+
+	if (++strand->test->numberOfReads == numberOfReads) {
+		return CPS_EXIT;
+	}
+
+	return CPSSched::yield(Cont(syncReadValue, strand));
+}
+
+static Cont startStrands(AsyncIOTest *test) {
+	AsyncIOStrand *strand = &test->strands[--test->numberOfStrandsToStart];
+	const Cont strandCont = test->useAsyncIO ? Cont(asyncReadValue, strand) : Cont(syncReadValue, strand);
+
+	if (test->numberOfStrandsToStart == 0) {
+		return strandCont;
+	}
+
+	return CPSSched::fork(strandCont, Cont(startStrands, test));
+}
+
+/**
+ * @post Lee con la cantidad de hilos de ejecución especificada, e
+         imprime la cantidad de syscalls por lectura y el tiempo
+ */
+static void measure(int fd, long numberOfStrands, bool useAsyncIO) {
+	AsyncIOStrand *strands = new AsyncIOStrand[numberOfStrands];
+	AsyncIOTest test = { fd, useAsyncIO, strands, numberOfStrands, 0, 0 };
+
+	for (long i = 0; i < numberOfStrands; i++) {
+		strands[i].test = &test;
+	}
+
+	CPSSched::create();
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	runCPS(Cont(startStrands, &test));
+
+	const double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+	const uint64_t numberOfSyscalls = useAsyncIO ? CPSSched::getNumberOfAsyncIOSyscalls() : test.numberOfReads;
+
+	CPSSched::destroy();
+
+	delete[] strands;
+
+	std::cout << std::left << std::setw(10) << (useAsyncIO ? "asyncRead" : "pread") << std::right << std::setw(3) << numberOfStrands << " strands: "
+		<< test.numberOfReads << " reads (" << test.numberOfFailedReads << " failed), "
+		<< numberOfSyscalls << (useAsyncIO ? " io_uring_enter, " : " pread, ") << std::fixed << std::setprecision(2)
+		<< (double)test.numberOfReads / std::max<uint64_t>(numberOfSyscalls, 1) << " reads per syscall, "
+		<< std::setprecision(1) << time / test.numberOfReads << " ns/read" << std::endl;
+}
+
+int Benchmark::asyncIOSyscalls(int argc, char **argv) {
+	const long numberOfStrands = (argc > 0) ? std::atol(argv[0]) : defaultNumberOfStrands;
+	const std::string filename = (argc > 1) ? argv[1] : defaultFilename;
+
+	{
+		std::ofstream file(filename);
+
+		file << "1" << std::endl;
+	}
+
+	const int fd = ::open(filename.c_str(), O_RDONLY);
+
+	if (fd < 0) {
+		std::cerr << "Cannot open " << filename << std::endl;
+
+		return 1;
+	}
+
+	for (long strands : { 1L, numberOfStrands }) {
+		measure(fd, strands, true);
+		measure(fd, strands, false);
+	}
+
+	::close(fd);
+	::unlink(filename.c_str());
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+#include "BenchmarkAllocationCounter.h"
+
+#include "CPSSched.h"
+#include "CPSTask.h"
+
+#include <iostream>
+#include <iomanip>
+
+/*
+ * Costo de las transiciones de las corrutinas (CPSTask) respecto de
+ * las continuaciones: ceder el CPU con yield y esperar una corrutina
+ * hija, cuyo marco sale del arena del scheduler.
+ * También cuenta las reservas de memoria de cada medición
+ */
+
+// Cantidad de transiciones de cada medición
+static const long numberOfTransitions = 20000000;
+
+struct CoroutineTest {
+	long numberOfTransitions;
+};
+
+static Cont cpsYield(CoroutineTest *test) {
+	if (++test->numberOfTransitions == numberOfTransitions) {
+		return CPS_EXIT;
+	}
+
+	return CPSSched::yield(Cont(cpsYield, test));
+}
+
+static CPSTask<long> coroutineYield() {
+	long transitions = 0;
+
+	while (++transitions < numberOfTransitions) {
+		co_await CPSSched::yield();
+	}
+
+	co_return transitions;
+}
+
+static CPSTask<long> child(long transitions) {
+	co_return transitions + 1;
+}
+
+static CPSTask<long> coroutineCall() {
+	long transitions = 0;
+
+	while (transitions < numberOfTransitions / 4) {
+		transitions = co_await child(transitions);
+	}
+
+	co_return transitions;
+}
+
+static Cont onCoroutineEnd(CoroutineTest *test, long transitions) {
+	test->numberOfTransitions = transitions;
+
+	return CPS_EXIT;
+}
+
+static Cont startCoroutineYield(CoroutineTest *test) {
+	return coroutineYield().start(PCont<long>(onCoroutineEnd, test));
+}
+
+static Cont startCoroutineCall(CoroutineTest *test) {
+	return coroutineCall().start(PCont<long>(onCoroutineEnd, test));
+}
+
+/**
+ * @post Ejecuta la continuación especificada hasta que termine,
+         e imprime el costo de cada transición y las reservas de memoria
+ */
+static void measure(const char *name, Cont (*start)(CoroutineTest *)) {
+	CoroutineTest test = { 0 };
+
+	const uint64_t allocations = Benchmark::AllocationCounter::getNumberOfAllocations();
+	const auto startTime = std::chrono::steady_clock::now();
+
+	runCPS(Cont(start, &test));
+
+	const double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(6) << time / test.numberOfTransitions << " ns each, "
+		<< Benchmark::AllocationCounter::getNumberOfAllocations() - allocations << " allocations" << std::endl;
+}
+
+int Benchmark::coroutineTransitions(int, char **) {
+	CPSSched::create();
+
+	// Calentamiento del arena de marcos
+	{
+		CoroutineTest test = { 0 };
+
+		runCPS(Cont(startCoroutineCall, &test));
+	}
+
+	measure("CPS yield", cpsYield);
+	measure("co_await yield", startCoroutineYield);
+	measure("co_await child task", startCoroutineCall);
+
+	CPSSched::destroy();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "CPSHistogram.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+/*
+ * Un timer periódico comparte el thread con muchos hilos de ejecución
+ * de baja prioridad, que hacen un paso corto y ceden el CPU con yield.
+ * Mide cuánto después de su instante se ejecuta el timer, sin plazo
+ * (Espera detrás de todos en la cola FIFO) y con plazo (EDF)
+ */
+
+// Período del timer
+static const std::chrono::microseconds timerPeriod = std::chrono::microseconds(500);
+
+// Cantidad de ejecuciones del timer medidas
+static const uint64_t numberOfTicks = 2000;
+
+// Cantidad de hilos de ejecución de baja prioridad por defecto
+static const long defaultNumberOfYielders = 2000;
+
+struct DispatchLatencyTest {
+	long numberOfYieldersToStart;
+	bool useDeadline;
+	uint64_t numberOfTicks;
+	std::chrono::steady_clock::time_point dueTime;
+	CPSHistogram lateness; // En nanosegundos
+};
+
+static volatile long housekeepingSink;
+
+static Cont housekeeping(DispatchLatencyTest *test) {
+	for (long i = 0; i < 50; i++) {
+		housekeepingSink = housekeepingSink + i;
+	}
+
+	return CPSSched::yield(Cont(housekeeping, test));
+}
+
+static Cont tick(DispatchLatencyTest *test);
+
+static Cont armTimer(DispatchLatencyTest *test) {
+	test->dueTime = CPSSched::now() + timerPeriod;
+
+	if (test->useDeadline) {
+		return CPSSched::waitFor(timerPeriod, timerPeriod, Cont(tick, test));
+	}
+	else {
+		return CPSSched::waitFor(timerPeriod, Cont(tick, test));
+	}
+}
+
+static Cont tick(DispatchLatencyTest *test) {
+	const std::chrono::steady_clock::duration lateness = CPSSched::now() - test->dueTime;
+
+	test->lateness.record((lateness.count() > 0) ? std::chrono::duration_cast<std::chrono::nanoseconds>(lateness).count() : 0);
+
+	if (++test->numberOfTicks == numberOfTicks) {
+		return CPS_EXIT;
+	}
+
+	return armTimer(test);
+}
+
+static Cont startYielders(DispatchLatencyTest *test) {
+	if (test->numberOfYieldersToStart == 0) {
+		return Cont(armTimer, test);
+	}
+
+	test->numberOfYieldersToStart--;
+
+	return CPSSched::fork(Cont(housekeeping, test), Cont(startYielders, test));
+}
+
+static void printLateness(const char *name, const CPSHistogram& lateness) {
+	const CPSHistogram::Snapshot snapshot = lateness.getSnapshot();
+
+	std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+		<< "timer lateness p50 " << std::setw(7) << snapshot.getPercentile(50) / 1000.0 << " us"
+		<< "  p99 " << std::setw(7) << snapshot.getPercentile(99) / 1000.0 << " us"
+		<< "  max " << std::setw(7) << snapshot.getMax() / 1000.0 << " us" << std::endl;
+}
+
+int Benchmark::dispatchLatency(int argc, char **argv) {
+	const long numberOfYielders = (argc > 0) ? std::atol(argv[0]) : defaultNumberOfYielders;
+
+	std::cout << "Periodic " << timerPeriod.count() << " us timer with " << numberOfYielders << " low-priority yielders" << std::endl;
+
+	for (bool useDeadline : { false, true }) {
+		DispatchLatencyTest test;
+		test.numberOfYieldersToStart = numberOfYielders;
+		test.useDeadline = useDeadline;
+		test.numberOfTicks = 0;
+
+		CPSSched::create(numberOfYielders + CPSSched::defaultRunQueueCapacity);
+		runCPS(Cont(startYielders, &test));
+		CPSSched::destroy();
+
+		printLateness(useDeadline ? "deadline" : "fifo", test.lateness);
+	}
+
+	return 0;
+}
\ No newline at end of file
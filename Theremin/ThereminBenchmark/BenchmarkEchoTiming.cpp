@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "DistanceSensorReader.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+/*
+ * Error de medición del tiempo del 'echo', detectándolo por polling
+ * y por flancos, con un sensor simulado sin ruido y la mano quieta.
+ * Cada lectura es una sola muestra, así que el error de la distancia
+ * es el error de medición del tiempo (Convertido con la velocidad del
+ * sonido).
+ * Por defecto corre con el reloj virtual, en el que leer un pin cuesta
+ * 1 us. Con el argumento "realtime" corre en tiempo real, con lo cual
+ * también se mide el retraso del scheduler
+ */
+
+// Distancia de la mano
+static const double handDistance = 0.25;
+
+// Duración de cada medición
+static const std::chrono::seconds measurementDuration = std::chrono::seconds(2);
+
+struct EchoTimingTest {
+	GPIO::SimulatedBackend *backend;
+	DistanceSensor::Reader *reader;
+	std::chrono::steady_clock::time_point endTime;
+
+	uint64_t numberOfReadings;
+	double sumOfErrors;
+	double sumOfSquaredErrors;
+	double maxError;
+};
+
+static Cont readDistance(EchoTimingTest *test);
+
+static Cont onDistance(EchoTimingTest *test, boost::optional<double> distance) {
+	if (distance.is_initialized()) {
+		const double error = *distance - test->backend->getTrueDistance(0);
+
+		test->numberOfReadings++;
+		test->sumOfErrors += error;
+		test->sumOfSquaredErrors += error * error;
+		test->maxError = std::max(test->maxError, std::fabs(error));
+	}
+
+	if (CPSSched::now() >= test->endTime) {
+		return CPS_EXIT;
+	}
+
+	return Cont(readDistance, test);
+}
+
+static Cont readDistance(EchoTimingTest *test) {
+	return test->reader->read(PCont<boost::optional<double>>(onDistance, test));
+}
+
+static Cont startTest(EchoTimingTest *test) {
+	CPSSched::setClock(test->backend->getClock());
+
+	test->endTime = CPSSched::now() + measurementDuration;
+
+	return Cont(readDistance, test);
+}
+
+int Benchmark::echoTiming(int argc, char **argv) {
+	const bool realTime = (argc > 0) && (std::strcmp(argv[0], "realtime") == 0);
+
+	const Simulation::UltrasonicSensor sensor = Simulation::UltrasonicSensor()
+		.withTriggerId(19)
+		.withEchoId(26)
+		.withTemperature(20)
+		.withTrajectory(Simulation::Trajectory().withPoint(std::chrono::seconds(0), handDistance));
+
+	// Segundos de ida y vuelta del sonido por metro de distancia
+	const double secondsPerMeter = 2.0 / sensor.getSpeedOfSound();
+
+	std::cout << "Hand at " << handDistance << " m, " << (realTime ? "real time" : "virtual time, 1 us per pin access") << std::endl;
+
+	for (DistanceSensor::EchoDetection echoDetection : { DistanceSensor::EchoDetection::polling, DistanceSensor::EchoDetection::edge }) {
+		GPIO::SimulatedBackend backend(realTime ? GPIO::SimulatedBackend::TimeMode::realTime : GPIO::SimulatedBackend::TimeMode::virtualTime, 1);
+
+		backend.addSensor(sensor);
+
+		DistanceSensor::Reader reader(
+			DistanceSensor::Configuration()
+			.withEchoId(26)
+			.withTriggerId(19)
+			.withNumberOfSamples(1)
+			.withSampling(DistanceSensor::Sampling::sliding)
+			.withExpectedTemperature(20)
+			.withMaxDistance(0.4)
+			.withGPIOBackend(&backend)
+			.withEchoDetection(echoDetection)
+		);
+
+		EchoTimingTest test = { &backend, &reader, std::chrono::steady_clock::time_point(), 0, 0, 0, 0 };
+
+		CPSSched::create();
+		runCPS(Cont(startTest, &test));
+		CPSSched::destroy();
+
+		const uint64_t numberOfReadings = std::max<uint64_t>(test.numberOfReadings, 1);
+
+		std::cout << std::left << std::setw(8) << ((echoDetection == DistanceSensor::EchoDetection::edge) ? "edge" : "polling") << std::right << std::fixed << std::setprecision(2)
+			<< test.numberOfReadings << " readings, timing error"
+			<< " mean " << std::setw(6) << test.sumOfErrors / numberOfReadings * secondsPerMeter * 1e6 << " us"
+			<< "  rms " << std::setw(6) << std::sqrt(test.sumOfSquaredErrors / numberOfReadings) * secondsPerMeter * 1e6 << " us"
+			<< "  max " << std::setw(6) << test.maxError * secondsPerMeter * 1e6 << " us"
+			<< "  (rms " << std::sqrt(test.sumOfSquaredErrors / numberOfReadings) * 1000 << " mm)" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "SimulationTrace.h"
+#include "SimulationEstimatorEvaluation.h"
+#include "DistanceSensorEstimator.h"
+#include "DistanceSensorConfiguration.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+/*
+ * Evalúa los estimadores de distancia con registros de un sensor:
+ * los registros CSV especificados (Por ejemplo grabados con el sensor
+ * real) o, si no se especifica ninguno, uno generado con el modelo del
+ * sensor, que se puede guardar para usarlo como ejemplo del formato.
+ *
+ * Argumentos: [--horizon <ms>] [--save <archivo>] [<registro.csv>...]
+ */
+
+// Cantidad de muestras de la ventana de los estimadores
+static const int numberOfSamples = 10;
+
+// Latencia máxima buscada
+static const std::chrono::milliseconds maxLatency = std::chrono::milliseconds(100);
+
+/**
+ * @post Genera el registro de ejemplo: la mano quieta, movimientos
+         lentos y rápidos, un salto de 0.2 m y un vaivén, con ruido de
+		 2 mm, 5% de ecos perdidos y 5% de interferencia de otro sensor
+ */
+static Simulation::Trace recordExampleTrace() {
+	Simulation::Trajectory trajectory = Simulation::Trajectory().withPoint(std::chrono::seconds(0), 0.2);
+
+	auto addPoint = [&](double seconds, double distance) {
+		trajectory = trajectory.withPoint(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds)), distance);
+	};
+
+	addPoint(0.5, 0.2);
+	addPoint(1.5, 0.35);
+	addPoint(2.0, 0.1);
+	addPoint(2.3, 0.35);
+	addPoint(2.6, 0.1);
+	addPoint(3.0, 0.1);
+	addPoint(3.001, 0.3);
+	addPoint(3.5, 0.3);
+
+	for (int i = 1; i <= 40; i++) {
+		addPoint(3.5 + 0.05 * i, 0.2 + 0.08 * std::sin((i - 1) * 0.9));
+	}
+
+	addPoint(6, 0.25);
+
+	const Simulation::UltrasonicSensor sensor = Simulation::UltrasonicSensor()
+		.withTriggerId(1)
+		.withEchoId(2)
+		.withTrajectory(trajectory)
+		.withNoise(0.002)
+		.withDropoutProbability(0.05)
+		.withCrosstalkProbability(0.05);
+
+	return Simulation::Trace::record(sensor, std::chrono::seconds(6), std::chrono::microseconds(3000), 0.4, 11);
+}
+
+/**
+ * @post Imprime la evaluación de cada estimador con el registro especificado
+ */
+static void evaluate(const std::string& name, const Simulation::Trace& trace, std::chrono::steady_clock::duration horizon) {
+	static const std::pair<const char *, DistanceSensor::Estimation> estimations[] = {
+		{ "median", DistanceSensor::Estimation::median },
+		{ "trimmedMean", DistanceSensor::Estimation::trimmedMean },
+		{ "kalman", DistanceSensor::Estimation::kalman },
+		{ "alphaBeta", DistanceSensor::Estimation::alphaBeta }
+	};
+
+	std::cout << name << ": " << trace.getSamples().size() << " pings, horizon "
+		<< std::chrono::duration<double, std::milli>(horizon).count() << " ms" << std::endl;
+
+	for (const auto& estimation : estimations) {
+		DistanceSensor::Configuration configuration = DistanceSensor::Configuration()
+			.withNumberOfSamples(numberOfSamples)
+			.withEstimation(estimation.second);
+
+		std::unique_ptr<DistanceSensor::Estimator> estimator = DistanceSensor::Estimator::create(configuration);
+
+		const Simulation::EstimatorEvaluation::Score score = Simulation::EstimatorEvaluation::evaluate(trace, *estimator, horizon, maxLatency);
+
+		std::cout << "  " << std::left << std::setw(12) << estimation.first << std::right << std::fixed << std::setprecision(1)
+			<< "rms " << std::setw(5) << score.rmsError * 1000 << " mm"
+			<< "  max " << std::setw(6) << score.maxError * 1000 << " mm"
+			<< "  latency " << std::setw(5) << std::setprecision(2) << std::chrono::duration<double, std::milli>(score.latency).count() << " ms"
+			<< "  rms at latency " << std::setw(5) << std::setprecision(1) << score.rmsErrorAtLatency * 1000 << " mm"
+			<< "  coverage " << std::setprecision(3) << (double)score.numberOfEstimates / std::max<size_t>(score.numberOfSamples, 1) << std::endl;
+
+		std::cout.unsetf(std::ios::floatfield);
+	}
+}
+
+int Benchmark::estimators(int argc, char **argv) {
+	std::chrono::steady_clock::duration horizon = std::chrono::steady_clock::duration::zero();
+	const char *saveFilename = nullptr;
+	std::vector<const char *> traceFilenames;
+
+	for (int i = 0; i < argc; i++) {
+		if ((std::strcmp(argv[i], "--horizon") == 0) && (i + 1 < argc)) {
+			horizon = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(std::atof(argv[++i])));
+		}
+		else if ((std::strcmp(argv[i], "--save") == 0) && (i + 1 < argc)) {
+			saveFilename = argv[++i];
+		}
+		else {
+			traceFilenames.push_back(argv[i]);
+		}
+	}
+
+	if (traceFilenames.empty()) {
+		const Simulation::Trace trace = recordExampleTrace();
+
+		if (saveFilename != nullptr) {
+			std::ofstream file(saveFilename);
+
+			if (!file.is_open()) {
+				std::cerr << "Cannot write " << saveFilename << std::endl;
+
+				return 1;
+			}
+
+			trace.save(file);
+		}
+
+		evaluate("Example trace", trace, horizon);
+	}
+
+	for (const char *traceFilename : traceFilenames) {
+		std::ifstream file(traceFilename);
+
+		if (!file.is_open()) {
+			std::cerr << "Cannot read " << traceFilename << std::endl;
+
+			return 1;
+		}
+
+		evaluate(traceFilename, Simulation::Trace::load(file), horizon);
+	}
+
+	return 0;
+}
\ No newline at end of file
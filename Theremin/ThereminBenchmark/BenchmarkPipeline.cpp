@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "ThereminUserInput.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <cmath>
+#include <sys/resource.h>
+
+/*
+ * Rendimiento de toda la lectura de la entrada (Theremin::UserInput,
+ * con sus dos sensores leídos por turnos en su thread) sobre el backend
+ * de GPIO simulado, con las manos moviéndose.
+ * Mide las lecturas por segundo de cada sensor, la latencia desde que
+ * emite hasta que publica la estimación, y el tiempo de CPU del proceso.
+ * Corre en tiempo virtual (Leer un pin cuesta 1 us, y las esperas se
+ * saltan, con lo cual el tiempo de CPU es el costo de la lectura) y en
+ * tiempo real (Como en la Raspberry Pi, pero con los ecos simulados)
+ */
+
+// Tiempo de lectura medido en tiempo virtual
+static const std::chrono::seconds virtualDuration = std::chrono::seconds(20);
+
+// Tiempo de lectura medido en tiempo real
+static const std::chrono::seconds realDuration = std::chrono::seconds(3);
+
+/**
+ * @post Devuelve el recorrido de una mano que va y viene alrededor de
+         la distancia especificada, con la amplitud y el período especificados
+ */
+static Simulation::Trajectory handTrajectory(double distance, double amplitude, double period, std::chrono::steady_clock::duration length) {
+	Simulation::Trajectory trajectory;
+
+	for (std::chrono::milliseconds time(0); time <= length; time += std::chrono::milliseconds(20)) {
+		const double seconds = std::chrono::duration<double>(time).count();
+
+		trajectory = trajectory.withPoint(time, distance + amplitude * std::sin(2 * M_PI * seconds / period));
+	}
+
+	return trajectory;
+}
+
+/**
+ * @post Devuelve el tiempo de CPU del proceso (Usuario y sistema) en segundos
+ */
+static double getCPUTime() {
+	struct rusage usage;
+
+	::getrusage(RUSAGE_SELF, &usage);
+
+	return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+/**
+ * @post Mide la lectura durante el tiempo de lectura especificado,
+         con el modo de tiempo especificado
+ */
+static void measure(GPIO::SimulatedBackend::TimeMode timeMode, std::chrono::steady_clock::duration duration) {
+	GPIO::SimulatedBackend backend(timeMode, 1);
+
+	// Con margen, porque en tiempo virtual la lectura sigue hasta que se la detiene
+	const auto trajectoryLength = duration * 2;
+
+	backend.addSensor(
+		Simulation::UltrasonicSensor()
+		.withTriggerId(Theremin::UserInput::volumeTriggerId)
+		.withEchoId(Theremin::UserInput::volumeEchoId)
+		.withTemperature(20)
+		.withNoise(0.002)
+		.withDropoutProbability(0.02)
+		.withTrajectory(handTrajectory(0.2, 0.1, 3.0, trajectoryLength))
+	);
+
+	backend.addSensor(
+		Simulation::UltrasonicSensor()
+		.withTriggerId(Theremin::UserInput::pitchTriggerId)
+		.withEchoId(Theremin::UserInput::pitchEchoId)
+		.withTemperature(20)
+		.withNoise(0.002)
+		.withDropoutProbability(0.02)
+		.withTrajectory(handTrajectory(0.25, 0.12, 1.3, trajectoryLength))
+	);
+
+	Theremin::UserInput userInput(true, backend);
+
+	// Medir desde que empieza la lectura (Antes el instante del estado es cero)
+	DistanceSensor::Group::Snapshot startSnapshot = userInput.getSensorGroupSnapshot();
+
+	while (startSnapshot.timestamp == std::chrono::steady_clock::time_point()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		startSnapshot = userInput.getSensorGroupSnapshot();
+	}
+
+	const double startCPUTime = getCPUTime();
+	const auto startTime = std::chrono::steady_clock::now();
+
+	DistanceSensor::Group::Snapshot endSnapshot = startSnapshot;
+
+	while (endSnapshot.timestamp - startSnapshot.timestamp < duration) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		endSnapshot = userInput.getSensorGroupSnapshot();
+	}
+
+	const double cpuTime = getCPUTime() - startCPUTime;
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	const double sensorTime = std::chrono::duration<double>(endSnapshot.timestamp - startSnapshot.timestamp).count();
+
+	uint64_t numberOfUpdates = 0;
+
+	for (size_t i = 0; i < endSnapshot.sensorCounts.size(); i++) {
+		numberOfUpdates += endSnapshot.sensorCounts[i].numberOfUpdates - startSnapshot.sensorCounts[i].numberOfUpdates;
+	}
+
+	std::cout << ((timeMode == GPIO::SimulatedBackend::TimeMode::virtualTime) ? "Virtual time" : "Real time") << ", "
+		<< std::fixed << std::setprecision(2) << sensorTime << " s of sensor time in " << wallTime << " s" << std::endl;
+
+	endSnapshot.print(std::cout, startSnapshot);
+
+	for (size_t i = 0; i < endSnapshot.sensorCounts.size(); i++) {
+		const CPSHistogram::Snapshot latency = userInput.getSensorLatencyStatistics(i);
+
+		std::cout << "Sensor " << i << " trigger-to-publish latency: " << std::fixed << std::setprecision(1)
+			<< "p50 " << std::setw(7) << latency.getPercentile(50) / 1e3 << " us"
+			<< "  p99 " << std::setw(7) << latency.getPercentile(99) / 1e3 << " us"
+			<< "  max " << std::setw(7) << latency.getMax() / 1e3 << " us" << std::endl;
+	}
+
+	std::cout << "CPU time: " << std::fixed << std::setprecision(3) << cpuTime << " s"
+		<< std::setprecision(1) << " (" << cpuTime / wallTime * 100 << "% of a core, "
+		<< cpuTime * 1e6 / std::max<uint64_t>(numberOfUpdates, 1) << " us per update)" << std::endl << std::endl;
+}
+
+int Benchmark::pipeline(int, char **) {
+	measure(GPIO::SimulatedBackend::TimeMode::virtualTime, virtualDuration);
+	measure(GPIO::SimulatedBackend::TimeMode::realTime, realDuration);
+
+	return 0;
+}
\ No newline at end of file
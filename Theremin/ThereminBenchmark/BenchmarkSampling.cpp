@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "DistanceSensorReader.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+/*
+ * Lecturas por segundo y respuesta a un salto de la mano, leyendo un
+ * sensor simulado por lotes y con ventana deslizante (Ambos con la
+ * mediana de 10 muestras).
+ * La mano salta de 0.1 m a 0.3 m a los 1.5 s, y el sensor tiene 5% de
+ * ecos perdidos y 5% de interferencia de otro sensor. Se cuentan las
+ * lecturas de los 2 s que siguen a la inicialización del sensor (Que
+ * tarda 0.5 s), el tiempo desde el salto hasta la primer distancia a
+ * menos de 2 cm de la nueva, y las distancias a más de 2 cm de las dos
+ * posiciones de la mano (Errores, no atraso). Corre en tiempo virtual
+ */
+
+// Distancia de la mano antes y después del salto
+static const double startDistance = 0.1;
+static const double endDistance = 0.3;
+
+// Instante del salto
+static const std::chrono::milliseconds stepTime = std::chrono::milliseconds(1500);
+
+// Intervalo en el que se cuentan las lecturas (Después de la inicialización)
+static const std::chrono::milliseconds measurementStartTime = std::chrono::milliseconds(500);
+static const std::chrono::milliseconds measurementEndTime = std::chrono::milliseconds(2500);
+
+// Error a partir del cual una distancia se considera incorrecta
+static const double maxGoodError = 0.02;
+
+struct SamplingTest {
+	DistanceSensor::Reader *reader;
+	std::chrono::steady_clock::time_point startTime;
+
+	uint64_t numberOfUpdates;
+	uint64_t numberOfBadUpdates;
+	boost::optional<std::chrono::steady_clock::duration> stepResponseTime;
+};
+
+static Cont readDistance(SamplingTest *test);
+
+static Cont onDistance(SamplingTest *test, boost::optional<double> distance) {
+	const auto time = CPSSched::now() - test->startTime;
+
+	if ((time >= measurementStartTime) && distance.is_initialized()) {
+		test->numberOfUpdates++;
+
+		if ((std::fabs(*distance - startDistance) > maxGoodError) && (std::fabs(*distance - endDistance) > maxGoodError)) {
+			test->numberOfBadUpdates++;
+		}
+
+		if ((time >= stepTime) && !test->stepResponseTime.is_initialized() && (std::fabs(*distance - endDistance) <= maxGoodError)) {
+			test->stepResponseTime = time - stepTime;
+		}
+	}
+
+	if (time >= measurementEndTime) {
+		return CPS_EXIT;
+	}
+
+	return Cont(readDistance, test);
+}
+
+static Cont readDistance(SamplingTest *test) {
+	return test->reader->read(PCont<boost::optional<double>>(onDistance, test));
+}
+
+int Benchmark::sampling(int, char **) {
+	const Simulation::UltrasonicSensor sensor = Simulation::UltrasonicSensor()
+		.withTriggerId(19)
+		.withEchoId(26)
+		.withTemperature(20)
+		.withDropoutProbability(0.05)
+		.withCrosstalkProbability(0.05)
+		.withTrajectory(
+			Simulation::Trajectory()
+			.withPoint(std::chrono::seconds(0), startDistance)
+			.withPoint(stepTime, startDistance)
+			.withPoint(stepTime + std::chrono::milliseconds(1), endDistance)
+		);
+
+	std::cout << "Hand step " << startDistance << " m -> " << endDistance << " m at " << stepTime.count() << " ms, 10-sample median, 5% dropout and crosstalk" << std::endl;
+
+	for (DistanceSensor::Sampling sampling : { DistanceSensor::Sampling::batch, DistanceSensor::Sampling::sliding }) {
+		GPIO::SimulatedBackend backend(GPIO::SimulatedBackend::TimeMode::virtualTime, 1);
+
+		backend.addSensor(sensor);
+
+		DistanceSensor::Reader reader(
+			DistanceSensor::Configuration()
+			.withEchoId(26)
+			.withTriggerId(19)
+			.withNumberOfSamples(10)
+			.withSampling(sampling)
+			.withEstimation(DistanceSensor::Estimation::median)
+			.withExpectedTemperature(20)
+			.withMaxDistance(0.4)
+			.withGPIOBackend(&backend)
+		);
+
+		SamplingTest test;
+		test.reader = &reader;
+		test.startTime = backend.getClock().now();
+		test.numberOfUpdates = 0;
+		test.numberOfBadUpdates = 0;
+
+		CPSSched::create();
+		CPSSched::setClock(backend.getClock());
+		runCPS(Cont(readDistance, &test));
+		CPSSched::destroy();
+
+		const double measurementTime = std::chrono::duration<double>(measurementEndTime - measurementStartTime).count();
+
+		std::cout << std::left << std::setw(8) << ((sampling == DistanceSensor::Sampling::batch) ? "batch" : "sliding") << std::right
+			<< std::setw(4) << test.numberOfUpdates << " updates in " << measurementTime << " s ("
+			<< std::fixed << std::setprecision(1) << measurementTime * 1000 / std::max<uint64_t>(test.numberOfUpdates, 1) << " ms apart), step seen after ";
+
+		if (test.stepResponseTime.is_initialized()) {
+			std::cout << std::chrono::duration<double, std::milli>(*test.stepResponseTime).count() << " ms";
+		}
+		else {
+			std::cout << "never";
+		}
+
+		std::cout << ", " << test.numberOfBadUpdates << " more than " << maxGoodError * 100 << " cm off" << std::endl;
+
+		std::cout.unsetf(std::ios::floatfield);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "DistanceSensorGroup.h"
+#include "GPIOSimulatedBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <deque>
+#include <vector>
+#include <cmath>
+
+/*
+ * Lecturas por segundo de cada sensor de un grupo de 2, 4 y 8 sensores
+ * simulados que comparten el espacio, leídos por turnos con
+ * DistanceSensor::Group (Con el tiempo de guarda predeterminado y sin
+ * tiempo de guarda), comparadas con leerlos libremente, cada uno en su
+ * hilo de ejecución.
+ * Cada pulso ajeno que llega durante un eco lo corta (Probabilidad de
+ * interferencia 1), así que leyéndolos libremente muchas distancias
+ * son incorrectas. Para medirlo se compara la distancia publicada de
+ * cada sensor con la real cada milisegundo.
+ * Cada lectura es una sola muestra, con la mediana móvil, y la distancia
+ * máxima es 0.4 m. Corre en tiempo virtual, y se mide a partir de que
+ * todos los sensores hicieron su primer lectura (Que inicializa los pines)
+ */
+
+// Tiempo medido
+static const std::chrono::seconds measurementDuration = std::chrono::seconds(16);
+
+// Error a partir del cual una distancia se considera incorrecta
+static const double maxGoodError = 0.02;
+
+struct SensorGroupTest;
+
+// Hilo de ejecución que lee un sensor libremente
+struct SensorStrand {
+	SensorGroupTest *test;
+	size_t sensorIndex;
+};
+
+struct SensorGroupTest {
+	GPIO::SimulatedBackend *backend;
+	std::deque<DistanceSensor::SynchronizedContext> *contexts;
+	DistanceSensor::Group *group; // Nulo si se leen libremente
+
+	std::vector<SensorStrand> strands;
+	std::vector<DistanceSensor::Group::SensorCount> sensorCounts; // Lecturas de cada sensor, si se leen libremente
+	size_t numberOfStrandsToStart;
+
+	std::chrono::steady_clock::time_point endTime;
+	bool isMeasuring;
+
+	DistanceSensor::Group::Snapshot startSnapshot;
+	DistanceSensor::Group::Snapshot endSnapshot;
+
+	uint64_t numberOfChecks;
+	uint64_t numberOfBadChecks;
+	double sumOfSquaredErrors;
+};
+
+/**
+ * @post Devuelve una copia del estado de la lectura
+ */
+static DistanceSensor::Group::Snapshot getSnapshot(SensorGroupTest *test) {
+	if (test->group != nullptr) {
+		return test->group->getSnapshot();
+	}
+
+	DistanceSensor::Group::Snapshot snapshot;
+	snapshot.timestamp = CPSSched::now();
+	snapshot.sensorCounts = test->sensorCounts;
+
+	return snapshot;
+}
+
+static Cont updateSensor(SensorStrand *strand);
+
+static Cont onSensorUpdated(SensorStrand *strand) {
+	SensorGroupTest *test = strand->test;
+	DistanceSensor::Group::SensorCount& sensorCount = test->sensorCounts[strand->sensorIndex];
+
+	sensorCount.numberOfUpdates++;
+
+	if ((*test->contexts)[strand->sensorIndex].getDistance().is_initialized()) {
+		sensorCount.numberOfValidUpdates++;
+	}
+
+	return Cont(updateSensor, strand);
+}
+
+static Cont updateSensor(SensorStrand *strand) {
+	return (*strand->test->contexts)[strand->sensorIndex].update(Cont(onSensorUpdated, strand));
+}
+
+/**
+ * @post Devuelve si todos los sensores hicieron alguna lectura
+ */
+static bool allSensorsUpdated(const DistanceSensor::Group::Snapshot& snapshot) {
+	for (const DistanceSensor::Group::SensorCount& sensorCount : snapshot.sensorCounts) {
+		if (sensorCount.numberOfUpdates == 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @post Compara la distancia publicada de cada sensor con la real,
+         cada milisegundo, hasta el final de la medición
+ */
+static Cont checkDistances(SensorGroupTest *test) {
+	const auto now = CPSSched::now();
+
+	if (!test->isMeasuring) {
+		const DistanceSensor::Group::Snapshot snapshot = getSnapshot(test);
+
+		if (allSensorsUpdated(snapshot)) {
+			test->startSnapshot = snapshot;
+			test->endTime = now + measurementDuration;
+			test->isMeasuring = true;
+		}
+	}
+
+	if (test->isMeasuring) {
+		for (size_t i = 0; i < test->contexts->size(); i++) {
+			const boost::optional<double> distance = (*test->contexts)[i].getDistance();
+
+			if (distance.is_initialized()) {
+				const double error = *distance - test->backend->getTrueDistance(i);
+
+				test->numberOfChecks++;
+				test->sumOfSquaredErrors += error * error;
+
+				if (std::fabs(error) > maxGoodError) {
+					test->numberOfBadChecks++;
+				}
+			}
+		}
+	}
+
+	if (test->isMeasuring && (now >= test->endTime)) {
+		test->endSnapshot = getSnapshot(test);
+
+		return CPS_EXIT;
+	}
+
+	return CPSSched::waitFor(std::chrono::milliseconds(1), Cont(checkDistances, test));
+}
+
+static Cont startStrands(SensorGroupTest *test) {
+	if (test->numberOfStrandsToStart == 0) {
+		return Cont(checkDistances, test);
+	}
+
+	SensorStrand *strand = &test->strands[--test->numberOfStrandsToStart];
+
+	return CPSSched::fork(Cont(updateSensor, strand), Cont(startStrands, test));
+}
+
+static Cont startTest(SensorGroupTest *test) {
+	CPSSched::setClock(test->backend->getClock());
+
+	if (test->group != nullptr) {
+		return CPSSched::fork(test->group->run(), Cont(checkDistances, test));
+	}
+
+	return Cont(startStrands, test);
+}
+
+/**
+ * @post Mide la lectura de la cantidad de sensores especificada, libremente
+         o por turnos con el tiempo de guarda especificado
+ */
+static void measure(size_t numberOfSensors, bool useGroup, std::chrono::steady_clock::duration guardTime) {
+	GPIO::SimulatedBackend backend(GPIO::SimulatedBackend::TimeMode::virtualTime, 1);
+
+	std::deque<DistanceSensor::SynchronizedContext> contexts;
+	DistanceSensor::Group group(guardTime);
+
+	for (size_t i = 0; i < numberOfSensors; i++) {
+		const int triggerId = 100 + 2 * (int) i;
+		const int echoId = triggerId + 1;
+
+		// Las manos quietas, repartidas en el rango
+		const double handDistance = 0.1 + 0.25 * (double) i / (double)(numberOfSensors - 1);
+
+		backend.addSensor(
+			Simulation::UltrasonicSensor()
+			.withTriggerId(triggerId)
+			.withEchoId(echoId)
+			.withTemperature(20)
+			.withNoise(0.002)
+			.withCrosstalkProbability(1)
+			.withTrajectory(Simulation::Trajectory().withPoint(std::chrono::seconds(0), handDistance))
+		);
+
+		contexts.emplace_back(
+			DistanceSensor::Configuration()
+			.withTriggerId(triggerId)
+			.withEchoId(echoId)
+			.withNumberOfSamples(1)
+			.withSampling(DistanceSensor::Sampling::sliding)
+			.withEstimation(DistanceSensor::Estimation::median)
+			.withExpectedTemperature(20)
+			.withMaxDistance(0.4)
+			.withGPIOBackend(&backend)
+		);
+
+		group.add(contexts.back());
+	}
+
+	SensorGroupTest test;
+	test.backend = &backend;
+	test.contexts = &contexts;
+	test.group = useGroup ? &group : nullptr;
+	test.sensorCounts.resize(numberOfSensors, DistanceSensor::Group::SensorCount { 0, 0 });
+	test.numberOfStrandsToStart = numberOfSensors;
+	test.isMeasuring = false;
+	test.numberOfChecks = 0;
+	test.numberOfBadChecks = 0;
+	test.sumOfSquaredErrors = 0;
+
+	for (size_t i = 0; i < numberOfSensors; i++) {
+		test.strands.push_back(SensorStrand { &test, i });
+	}
+
+	CPSSched::create();
+	runCPS(Cont(startTest, &test));
+	CPSSched::destroy();
+
+	if (useGroup) {
+		std::cout << "Group, guard " << std::chrono::duration<double, std::milli>(guardTime).count() << " ms:" << std::endl;
+	}
+	else {
+		std::cout << "Free fork:" << std::endl;
+	}
+
+	test.endSnapshot.print(std::cout, test.startSnapshot);
+
+	const uint64_t numberOfChecks = std::max<uint64_t>(test.numberOfChecks, 1);
+
+	std::cout << "Distance error: rms " << std::fixed << std::setprecision(1) << std::sqrt(test.sumOfSquaredErrors / numberOfChecks) * 1000 << " mm, "
+		<< (double) test.numberOfBadChecks / numberOfChecks * 100 << "% more than " << maxGoodError * 100 << " cm off" << std::endl;
+
+	std::cout.unsetf(std::ios::floatfield);
+}
+
+int Benchmark::sensorGroup(int, char **) {
+	for (size_t numberOfSensors : { 2, 4, 8 }) {
+		std::cout << "=== " << numberOfSensors << " sensors ===" << std::endl;
+
+		measure(numberOfSensors, false, std::chrono::steady_clock::duration::zero());
+		measure(numberOfSensors, true, DistanceSensor::Group::defaultGuardTime);
+		measure(numberOfSensors, true, std::chrono::steady_clock::duration::zero());
+
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "CPSStateMachine.h"
+
+#include <iostream>
+#include <iomanip>
+
+/*
+ * Transiciones por segundo de una máquina de estados de tres estados
+ * que pasan de uno al siguiente en ciclo, con continuaciones devueltas
+ * directamente a runCPS y con CPSStateMachine, directas (go) y pasando
+ * por el scheduler (yield)
+ */
+
+// Cantidad de transiciones directas de cada medición
+static const long numberOfDirectTransitions = 50000000;
+
+// Cantidad de transiciones por el scheduler de cada medición
+static const long numberOfYieldTransitions = 5000000;
+
+/*
+ * Con continuaciones
+ */
+
+struct ContinuationMachine {
+	long remainingTransitions;
+};
+
+static Cont stateB(ContinuationMachine *machine);
+static Cont stateC(ContinuationMachine *machine);
+
+static Cont stateA(ContinuationMachine *machine) {
+	if ((machine->remainingTransitions -= 3) <= 0) {
+		return CPS_EXIT;
+	}
+
+	return Cont(stateB, machine);
+}
+
+static Cont stateB(ContinuationMachine *machine) {
+	return Cont(stateC, machine);
+}
+
+static Cont stateC(ContinuationMachine *machine) {
+	return Cont(stateA, machine);
+}
+
+static Cont yieldingState(ContinuationMachine *machine) {
+	if (--machine->remainingTransitions <= 0) {
+		return CPS_EXIT;
+	}
+
+	return CPSSched::yield(Cont(yieldingState, machine));
+}
+
+/*
+ * Con CPSStateMachine
+ */
+
+class StateMachineBenchmark final
+{
+public:
+	enum class State { a, b, c };
+
+	typedef CPSStateMachine<StateMachineBenchmark, State> StateMachine;
+
+	StateMachineBenchmark(long numberOfTransitions, bool useYield) :
+		stateMachine_m(this),
+		remainingTransitions_m(numberOfTransitions),
+		useYield_m(useYield)
+	{
+
+	}
+
+	Cont start() {
+		return this->stateMachine_m.start(State::a);
+	}
+
+private:
+	friend class CPSStateMachine<StateMachineBenchmark, State>;
+
+	StateMachine::Transition step(State state) {
+		switch (state) {
+		case State::a:
+			if (this->useYield_m) {
+				if (--this->remainingTransitions_m <= 0) {
+					return StateMachine::exit(CPS_EXIT);
+				}
+
+				return StateMachine::yield(State::a);
+			}
+
+			if ((this->remainingTransitions_m -= 3) <= 0) {
+				return StateMachine::exit(CPS_EXIT);
+			}
+
+			return StateMachine::go(State::b);
+
+		case State::b:
+			return StateMachine::go(State::c);
+
+		default:
+			return StateMachine::go(State::a);
+		}
+	}
+
+	StateMachine stateMachine_m;
+
+	long remainingTransitions_m;
+	bool useYield_m;
+};
+
+/**
+ * @post Ejecuta la continuación especificada hasta que termine,
+         e imprime el costo y la cantidad por segundo de las transiciones
+ */
+static void measure(const char *name, long numberOfTransitions, Cont cont) {
+	const auto startTime = std::chrono::steady_clock::now();
+
+	runCPS(cont);
+
+	const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(6) << time * 1e9 / numberOfTransitions << " ns/transition "
+		<< std::setprecision(1) << std::setw(8) << numberOfTransitions / time / 1e6 << " M/s" << std::endl;
+}
+
+int Benchmark::stateMachineTransitions(int, char **) {
+	CPSSched::create();
+
+	ContinuationMachine continuationMachine = { numberOfDirectTransitions };
+	measure("runCPS direct Cont", numberOfDirectTransitions, Cont(stateA, &continuationMachine));
+
+	StateMachineBenchmark directMachine(numberOfDirectTransitions, false);
+	measure("state machine go", numberOfDirectTransitions, directMachine.start());
+
+	continuationMachine.remainingTransitions = numberOfYieldTransitions;
+	measure("runCPS CPSSched::yield", numberOfYieldTransitions, Cont(yieldingState, &continuationMachine));
+
+	StateMachineBenchmark yieldingMachine(numberOfYieldTransitions, true);
+	measure("state machine yield", numberOfYieldTransitions, yieldingMachine.start());
+
+	CPSSched::destroy();
+
+	return 0;
+}
\ No newline at end of file
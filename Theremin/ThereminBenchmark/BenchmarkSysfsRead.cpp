@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "GPIOSysfsBackend.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <chrono>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Costo de leer un pin por sysfs, sobre un árbol falso de sysfs
+ * (Por ejemplo en tmpfs), con el descriptor abierto durante toda
+ * la vida del pin y reabriendo el archivo en cada lectura (Como
+ * se hacía antes)
+ */
+
+// Directorio por defecto del árbol falso
+static const char *defaultSysfsPath = "/dev/shm/theremin-sysfs";
+
+// Id del pin del árbol falso
+static const int gpioId = 5;
+
+// Cantidad de lecturas con el descriptor abierto
+static const long numberOfReads = 1000000;
+
+// Cantidad de lecturas reabriendo el archivo
+static const long numberOfReopeningReads = 100000;
+
+/**
+ * @post Lee el archivo de valor especificado abriéndolo y cerrándolo
+ */
+static bool reopeningRead(const std::string& valueFilename) {
+	std::ifstream getvalGPIO(valueFilename);
+
+	std::string value;
+
+	getvalGPIO >> value;
+
+	return (value != "0");
+}
+
+int Benchmark::sysfsRead(int argc, char **argv) {
+	const std::string sysfsPath = (argc > 0) ? argv[0] : defaultSysfsPath;
+	const std::string gpioPath = sysfsPath + "/gpio" + std::to_string(gpioId);
+
+	const std::string filenames[] = {
+		sysfsPath + "/export",
+		sysfsPath + "/unexport",
+		gpioPath + "/direction",
+		gpioPath + "/edge",
+		gpioPath + "/value"
+	};
+
+	::mkdir(sysfsPath.c_str(), 0755);
+	::mkdir(gpioPath.c_str(), 0755);
+
+	for (const std::string& filename : filenames) {
+		std::ofstream file(filename);
+
+		if (!file.is_open()) {
+			std::cerr << "Cannot create " << filename << std::endl;
+
+			return 1;
+		}
+	}
+
+	{
+		GPIO::SysfsBackend backend(sysfsPath);
+		std::unique_ptr<GPIO::Pin> pin = backend.open(gpioId);
+
+		pin->write(true);
+
+		long numberOfHighReads = 0;
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		for (long i = 0; i < numberOfReads; i++) {
+			numberOfHighReads += pin->read();
+		}
+
+		const double persistentTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+		startTime = std::chrono::steady_clock::now();
+
+		for (long i = 0; i < numberOfReopeningReads; i++) {
+			numberOfHighReads += reopeningRead(gpioPath + "/value");
+		}
+
+		const double reopeningTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << "Fake sysfs tree at " << sysfsPath << " (" << numberOfHighReads << " of " << numberOfReads + numberOfReopeningReads << " reads high)" << std::fixed << std::setprecision(1) << std::endl;
+		std::cout << "persistent descriptor (pread): " << persistentTime / numberOfReads << " ns/read" << std::endl;
+		std::cout << "reopen per read (ifstream):    " << reopeningTime / numberOfReopeningReads << " ns/read" << std::endl;
+	}
+
+	for (const std::string& filename : filenames) {
+		::unlink(filename.c_str());
+	}
+
+	::rmdir(gpioPath.c_str());
+	::rmdir(sysfsPath.c_str());
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "VirtualClock.h"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+/*
+ * Costo de agregar y vencer una espera de tiempo en la rueda de tiempo
+ * del scheduler, con distintas cantidades de esperas pendientes.
+ * Cada hilo de ejecución espera con waitFor y vuelve a esperar, la
+ * cuarta parte de las veces 10 us y las demás hasta 500 ms, con lo
+ * cual la cantidad pendiente se mantiene. Corre con el reloj virtual,
+ * así que el scheduler salta directamente a la próxima espera.
+ * Para comparar, mide también los mismos hilos de ejecución haciendo
+ * yield (El costo de despachar una continuación, sin esperas)
+ */
+
+// Cantidad de esperas vencidas de cada medición
+static const uint64_t numberOfOperations = 3000000;
+
+struct TimingWheelTest {
+	bool useYield;
+	size_t numberOfStrandsToStart;
+	uint64_t numberOfOperations;
+	std::mt19937 random;
+};
+
+static Cont wait(TimingWheelTest *test) {
+	if (++test->numberOfOperations == numberOfOperations) {
+		return CPS_EXIT;
+	}
+
+	if (test->useYield) {
+		return CPSSched::yield(Cont(wait, test));
+	}
+
+	if (test->random() % 4 == 0) {
+		return CPSSched::waitFor(std::chrono::microseconds(10), Cont(wait, test));
+	}
+	else {
+		return CPSSched::waitFor(std::chrono::microseconds(test->random() % 500000), Cont(wait, test));
+	}
+}
+
+static Cont startStrands(TimingWheelTest *test) {
+	if (--test->numberOfStrandsToStart == 0) {
+		return Cont(wait, test);
+	}
+
+	return CPSSched::fork(Cont(wait, test), Cont(startStrands, test));
+}
+
+/**
+ * @post Devuelve los nanosegundos por operación, con la cantidad
+         de hilos de ejecución especificada
+ */
+static double measure(size_t numberOfStrands, bool useYield) {
+	VirtualClock clock;
+
+	TimingWheelTest test;
+	test.useYield = useYield;
+	test.numberOfStrandsToStart = numberOfStrands;
+	test.numberOfOperations = 0;
+	test.random.seed(2);
+
+	/*
+	 * Los que esperan están en la rueda de tiempo, que encola los vencidos de a lo
+	 * sumo una cola llena. Los que hacen yield están todos en la cola a la vez
+	 */
+	if (useYield) {
+		CPSSched::create(numberOfStrands + CPSSched::defaultRunQueueCapacity);
+	}
+	else {
+		CPSSched::create();
+	}
+	CPSSched::setClock(clock);
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	runCPS(Cont(startStrands, &test));
+
+	const double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+	CPSSched::destroy();
+
+	return time / test.numberOfOperations;
+}
+
+int Benchmark::timingWheel(int, char **) {
+	for (size_t numberOfTimers : { 10, 1000, 100000 }) {
+		std::cout << std::setw(6) << numberOfTimers << " pending timers: " << std::fixed << std::setprecision(1)
+			<< "waitFor " << std::setw(6) << measure(numberOfTimers, false) << " ns per insert+expire"
+			<< ", yield " << std::setw(6) << measure(numberOfTimers, true) << " ns per dispatch" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
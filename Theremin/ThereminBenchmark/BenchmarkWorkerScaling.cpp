@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include "CPSSched.h"
+#include "CPSWorkerPool.h"
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+/*
+ * Escalabilidad del conjunto de workers: muchos hilos de ejecución
+ * independientes, cada uno con unos microsegundos de cálculo entre
+ * yields, repartidos por fork entre los workers (Los que no tienen
+ * trabajo lo roban de los demás).
+ * Mide las continuaciones por segundo con 1, 2, 4... workers
+ */
+
+// Cantidad de hilos de ejecución
+static const size_t numberOfStrands = 32;
+
+// Cantidad total de continuaciones de cada medición
+static const uint64_t numberOfContinuations = 200000;
+
+// Cantidad máxima de workers por defecto
+static const size_t defaultMaxNumberOfWorkers = 8;
+
+struct WorkerScalingTest;
+
+struct WorkerScalingStrand {
+	WorkerScalingTest *test;
+	double value;
+};
+
+struct WorkerScalingTest {
+	std::atomic<uint64_t> numberOfContinuations;
+	size_t numberOfStrandsToStart;
+	std::vector<WorkerScalingStrand> strands;
+};
+
+static Cont work(WorkerScalingStrand *strand) {
+	for (int i = 0; i < 2000; i++) {
+		strand->value = strand->value * 1.0000001 + 1;
+	}
+
+	if (++strand->test->numberOfContinuations >= numberOfContinuations) {
+		return CPS_EXIT;
+	}
+
+	return CPSSched::yield(Cont(work, strand));
+}
+
+static Cont startStrands(WorkerScalingTest *test) {
+	WorkerScalingStrand *strand = &test->strands[--test->numberOfStrandsToStart];
+
+	if (test->numberOfStrandsToStart == 0) {
+		return Cont(work, strand);
+	}
+
+	return CPSSched::fork(Cont(startStrands, test), Cont(work, strand));
+}
+
+int Benchmark::workerScaling(int argc, char **argv) {
+	const size_t maxNumberOfWorkers = (argc > 0) ? std::atol(argv[0]) : defaultMaxNumberOfWorkers;
+
+	std::cout << std::thread::hardware_concurrency() << " hardware threads, " << numberOfStrands << " strands" << std::endl;
+
+	for (size_t numberOfWorkers = 1; numberOfWorkers <= maxNumberOfWorkers; numberOfWorkers *= 2) {
+		WorkerScalingTest test;
+		test.numberOfContinuations = 0;
+		test.numberOfStrandsToStart = numberOfStrands;
+		test.strands.assign(numberOfStrands, WorkerScalingStrand{ &test, 0 });
+
+		CPSWorkerPool pool(numberOfWorkers);
+
+		const auto startTime = std::chrono::steady_clock::now();
+
+		pool.run(Cont(startStrands, &test));
+
+		const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::cout << std::setw(2) << numberOfWorkers << " workers: " << std::fixed << std::setprecision(0)
+			<< std::setw(8) << test.numberOfContinuations / time << " continuations/s, "
+			<< pool.getNumberOfSteals() << " steals" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2019 Ariel Favio Carrizo
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the
+ *	 names of its contributors may be used to endorse or promote products
+ *	 derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Benchmark.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+static const Benchmark::Case cases[] = {
+	{ "allocations", "Test: no allocations in yield/fork/waitFor and sensor reads after warm-up", Benchmark::allocations },
+	{ "dispatch", "Timer lateness without and with a deadline, under a flood of low-priority yields", Benchmark::dispatchLatency },
+	{ "sysfs", "ns per GPIO read against a fake sysfs tree, persistent descriptor vs reopening", Benchmark::sysfsRead },
+	{ "echo", "Echo timing error of edge vs polling detection with a simulated sensor", Benchmark::echoTiming },
+	{ "syscalls", "Syscalls per read with io_uring asyncRead vs pread, from several strands", Benchmark::asyncIOSyscalls },
+	{ "timers", "Timing wheel insert+expire cost at 10/1k/100k pending timers", Benchmark::timingWheel },
+	{ "workers", "Worker pool throughput against the number of workers", Benchmark::workerScaling },
+	{ "coroutines", "Coroutine yield and child task cost vs CPS yield, with allocations", Benchmark::coroutineTransitions },
+	{ "transitions", "State machine transitions per second vs plain continuations", Benchmark::stateMachineTransitions },
+	{ "estimators", "Score of each distance estimator on CSV traces (or an example trace)", Benchmark::estimators },
+	{ "pipeline", "Input pipeline update rate, latency and CPU time on simulated sensors", Benchmark::pipeline },
+	{ "sensors", "Per-sensor update rates of 2/4/8-sensor groups vs free forking", Benchmark::sensorGroup },
+	{ "sampling", "Update rate and step response of batch vs sliding sampling", Benchmark::sampling },
+	{ "adaptive", "Update rate, samples per read and error of batch vs adaptive sampling", Benchmark::adaptiveSampling }
+};
+
+static void printUsage(const char *programName) {
+	std::cerr << "Usage: " << programName << " <case> [arguments]" << std::endl;
+
+	for (const Benchmark::Case& benchmarkCase : cases) {
+		std::cerr << "  " << std::left << std::setw(16) << benchmarkCase.name << benchmarkCase.description << std::endl;
+	}
+}
+
+int main(int argc, char **argv) {
+	if (argc >= 2) {
+		for (const Benchmark::Case& benchmarkCase : cases) {
+			if (std::strcmp(argv[1], benchmarkCase.name) == 0) {
+				return benchmarkCase.function(argc - 2, argv + 2);
+			}
+		}
+	}
+
+	printUsage(argv[0]);
+
+	return 2;
+}
\ No newline at end of file